@@ -7,15 +7,30 @@ SUBDIRS = \
 	apps/exercices/exerciceP13 \
 	apps/exercices/exerciceP14 \
 	apps/tests/testAccelerator \
+	apps/tests/testArena \
+	apps/tests/testAsyncObserver \
 	apps/tests/testBeam \
 	apps/tests/testCircular \
 	apps/tests/testConvert \
 	apps/tests/testElement \
+	apps/tests/testElementIndex \
 	apps/tests/testException \
 	apps/tests/testFrodo \
+	apps/tests/testLattice \
+	apps/tests/testLossMap \
 	apps/tests/testParticle \
+	apps/tests/testPhaseSpace \
+	apps/tests/testPhaseSpaceHistogram \
+	apps/tests/testProfiler \
 	apps/tests/testRenderer \
+	apps/tests/testStepScheduler \
+	apps/tests/testSweep \
+	apps/tests/testThreadPool \
+	apps/tests/testShard \
+	apps/tests/testTrailHistory \
 	apps/tests/testVector3D \
+	apps/benchmarks/benchmarkStep \
+	apps/benchmarks/perfRegression \
 	apps/app
 
 test/exercices/exerciceP9.depends = common
@@ -23,13 +38,33 @@ test/exercices/exerciceP10.depends = common
 test/exercices/exerciceP13.depends = common
 test/exercices/exerciceP14.depends = common
 apps/tests/testAccelerator.depends = common
+apps/tests/testArena.depends = common
+apps/tests/testAsyncObserver.depends = common
 apps/tests/testBeam.depends = common
 apps/tests/testCircular.depends = common
 apps/tests/testConvert.depends = common
 apps/tests/testElement.depends = common
+apps/tests/testElementIndex.depends = common
 apps/tests/testException.depends = common
 apps/tests/testFrodo.depends = common
+apps/tests/testLattice.depends = common
+apps/tests/testLossMap.depends = common
 apps/tests/testParticle.depends = common
+apps/tests/testPhaseSpace.depends = common
+apps/tests/testPhaseSpaceHistogram.depends = common
+apps/tests/testProfiler.depends = common
 apps/tests/testRenderer.depends = common
+apps/tests/testStepScheduler.depends = common
+apps/tests/testSweep.depends = common
+apps/tests/testThreadPool.depends = common
+apps/tests/testShard.depends = common
+apps/tests/testTrailHistory.depends = common
 apps/tests/testVector3D.depends = common
+apps/benchmarks/benchmarkStep.depends = common
+apps/benchmarks/perfRegression.depends = common
 apps/app.depends = common
+
+# Performance regression gate (see apps/benchmarks/perfRegression): make perf
+perf.commands = bin/perfRegression.bin apps/benchmarks/perfRegression/baseline.json
+perf.depends = sub-apps-benchmarks-perfRegression
+QMAKE_EXTRA_TARGETS += perf
@@ -18,8 +18,8 @@ int main(int argc, char *argv[]) {
 	format.setVersion(3, 3);
 	format.setSamples(4); // antialising, 4 passes seems nice
 
-	// Set the window up (QWidget)
-	Window window;
+	// Set the window up (QWidget), with the lattice file given as first argument if any
+	Window window(argc > 1 ? argv[1] : "");
 	window.setFormat(format);
 	window.resize(QSize(800, 600));
 	window.show();
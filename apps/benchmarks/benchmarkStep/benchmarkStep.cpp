@@ -0,0 +1,88 @@
+#include "globals.h"
+#include "exceptions.h"
+#include "include/bundle/Vector3D.bundle.h"
+#include "include/bundle/Particle.bundle.h"
+#include "include/bundle/Frodo.bundle.h"
+#include "include/bundle/Dipole.bundle.h"
+#include "include/bundle/Accelerator.bundle.h"
+#include "include/bundle/Benchmark.bundle.h"
+
+#include <iostream>
+
+using namespace std;
+
+/**
+ * Cost of a step of the ring of the application, per particle-step, for beams of increasing sizes
+ *
+ * Build with `qmake CONFIG+=profiling` for the details of each phase of the step.
+ */
+
+// Ring of the application (see Window::Window()) with two counter-rotating beams of `particleCount` Particles,
+// integrated in the sections of the Frodos if `flattened`
+void initAccelerator(Accelerator & acc, size_t particleCount, bool flattened = false) {
+	Vector3D pos_dep(3, 2, 0);
+	Vector3D dir_frodo(0, -1, 0);
+	Vector3D pos_fin;
+	Vector3D dir_dipole(-1, -1, 0);
+
+	for (int i = 0; i < 4; ++i) {
+		pos_fin = pos_dep + 4 * dir_frodo;
+		acc.addElement(Frodo(pos_dep, pos_fin, 0.1, 1.2, 1));
+		pos_dep = pos_fin;
+		pos_fin += dir_dipole;
+		acc.addElement(Dipole(pos_dep, pos_fin, 0.1, 1, 5.89158));
+		pos_dep = pos_fin;
+		dir_frodo ^= Vector3D(0, 0, 1);
+		dir_dipole ^= Vector3D(0, 0, 1);
+	}
+
+	acc.closeElementLoop();
+	if (flattened) { acc.flattenElements(); }
+
+	acc.addBeam(Proton(Vector3D(2.99, 1.1, 0), 2, Vector3D(0, -2.64754e+08, 0)), particleCount, 1);
+	acc.addBeam(AntiProton(Vector3D(2.99, 1.1, 0), 2, Vector3D(0, 2.64754e+08, 0)), particleCount, 1);
+}
+
+int main() {
+	Benchmark::reportHeader(cout);
+
+	for (size_t particleCount : { 50, 500, 2000 }) {
+		Accelerator acc(nullptr, true, false);
+		initAccelerator(acc, particleCount);
+
+		// Fewer steps for the large beams: the interactions are quadratic
+		size_t steps(200000 / particleCount);
+		BenchmarkResult result(Benchmark::run("2 x " + to_string(particleCount) + " particles", acc, steps, steps / 10));
+		Benchmark::report(cout, result);
+	}
+
+	// The same ring with the Particles sorted by position every 100 steps (see Accelerator::reorderParticles())
+	for (size_t particleCount : { 500, 2000 }) {
+		for (size_t reorderInterval : { 0, 100 }) {
+			Accelerator acc(nullptr, true, false);
+			initAccelerator(acc, particleCount);
+			acc.setReorderInterval(reorderInterval);
+
+			// Long enough for the losses to shuffle the Particles
+			size_t steps(400000 / particleCount);
+			string name("2 x " + to_string(particleCount) + " particles, " + (reorderInterval > 0 ? "reordered" : "unordered"));
+			BenchmarkResult result(Benchmark::run(name, acc, steps, steps / 10));
+			Benchmark::report(cout, result);
+		}
+	}
+
+	// The same ring with the Frodos whole or flattened (see Accelerator::flattenElements())
+	for (size_t particleCount : { 50, 500 }) {
+		for (bool flattened : { false, true }) {
+			Accelerator acc(nullptr, true, false);
+			initAccelerator(acc, particleCount, flattened);
+
+			size_t steps(200000 / particleCount);
+			string name("2 x " + to_string(particleCount) + " particles, " + (flattened ? "flattened" : "whole Frodos"));
+			BenchmarkResult result(Benchmark::run(name, acc, steps, steps / 10));
+			Benchmark::report(cout, result);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,200 @@
+#include "globals.h"
+#include "exceptions.h"
+#include "include/bundle/Vector3D.bundle.h"
+#include "include/bundle/Particle.bundle.h"
+#include "include/bundle/Frodo.bundle.h"
+#include "include/bundle/Dipole.bundle.h"
+#include "include/bundle/Accelerator.bundle.h"
+#include "include/bundle/Benchmark.bundle.h"
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+/**
+ * Performance regression gate: runs fixed, deterministic scenarios and compares them with a baseline file
+ *
+ * 	bin/perfRegression.bin [baseline.json] [--update]
+ *
+ * Fails (exit code 1) if the throughput of a scenario (particle-steps per second) is below the baseline by more than
+ * the tolerance of the file, or by more than 3 times the noise measured between the repetitions if it is larger,
+ * or if a scenario allocates more per step than in the baseline (0 means the step path must not allocate),
+ * or if all the Particles of a scenario were lost (the scenario does not measure anything anymore).
+ * `--update` writes the measures as the new baseline instead (on the reference machine).
+ */
+
+/****************************************************************
+ * Allocation counting
+ ****************************************************************/
+
+atomic<size_t> allocations(0);
+
+void * operator new(size_t size) {
+	allocations.fetch_add(1, memory_order_relaxed);
+	void * ptr(malloc(size == 0 ? 1 : size));
+	if (ptr == nullptr) { throw bad_alloc(); }
+	return ptr;
+}
+
+void * operator new[](size_t size) { return operator new(size); }
+
+void operator delete(void * ptr) noexcept { free(ptr); }
+
+void operator delete[](void * ptr) noexcept { free(ptr); }
+
+void operator delete(void * ptr, size_t) noexcept { free(ptr); }
+
+void operator delete[](void * ptr, size_t) noexcept { free(ptr); }
+
+/****************************************************************
+ * Scenarios
+ ****************************************************************/
+
+// Ring of 4 dipoles of radius 1, with the field of the application
+void initDipoleRing(Accelerator & acc) {
+	acc.addElement(Dipole(Vector3D(1, 0, 0), Vector3D(0, -1, 0), 0.1, 1, 5.89158));
+	acc.addElement(Dipole(Vector3D(0, -1, 0), Vector3D(-1, 0, 0), 0.1, 1, 5.89158));
+	acc.addElement(Dipole(Vector3D(-1, 0, 0), Vector3D(0, 1, 0), 0.1, 1, 5.89158));
+	acc.addElement(Dipole(Vector3D(0, 1, 0), Vector3D(1, 0, 0), 0.1, 1, 5.89158));
+	acc.closeElementLoop();
+}
+
+// Ring of the application (see Window::Window())
+void initFodoRing(Accelerator & acc) {
+	Vector3D pos_dep(3, 2, 0);
+	Vector3D dir_frodo(0, -1, 0);
+	Vector3D pos_fin;
+	Vector3D dir_dipole(-1, -1, 0);
+
+	for (int i = 0; i < 4; ++i) {
+		pos_fin = pos_dep + 4 * dir_frodo;
+		acc.addElement(Frodo(pos_dep, pos_fin, 0.1, 1.2, 1));
+		pos_dep = pos_fin;
+		pos_fin += dir_dipole;
+		acc.addElement(Dipole(pos_dep, pos_fin, 0.1, 1, 5.89158));
+		pos_dep = pos_fin;
+		dir_frodo ^= Vector3D(0, 0, 1);
+		dir_dipole ^= Vector3D(0, 0, 1);
+	}
+
+	acc.closeElementLoop();
+}
+
+struct Scenario {
+	string name;
+	void (*init)(Accelerator &);
+	size_t steps;			// Steps of a repetition
+};
+
+void singleProton(Accelerator & acc) {
+	initDipoleRing(acc);
+	acc.addParticle(Proton(Vector3D(1, 0, 0), 2, Vector3D(0, -1, 0)));
+}
+
+void counterRotatingBeams(Accelerator & acc) {
+	initFodoRing(acc);
+	acc.addBeam(Proton(Vector3D(2.99, 1.1, 0), 2, Vector3D(0, -2.64754e+08, 0)), 50, 1);
+	acc.addBeam(AntiProton(Vector3D(2.99, 1.1, 0), 2, Vector3D(0, 2.64754e+08, 0)), 50, 1);
+}
+
+void largeBeam(Accelerator & acc) {
+	initFodoRing(acc);
+	acc.addBeam(Proton(Vector3D(2.99, 1.1, 0), 2, Vector3D(0, -2.64754e+08, 0)), 10000, 1);
+}
+
+/****************************************************************
+ * Gate
+ ****************************************************************/
+
+int main(int argc, char * argv[]) {
+	string path("apps/benchmarks/perfRegression/baseline.json");
+	bool update(false);
+	for (int i(1); i < argc; ++i) {
+		if (string(argv[i]) == "--update") { update = true; }
+		else { path = argv[i]; }
+	}
+
+	size_t const repetitions(5);
+	size_t const allocationSteps(10);
+	vector<Scenario> const scenarios({
+		Scenario({ "single proton, dipole ring", singleProton, 100000 }),
+		Scenario({ "50+50 beams, FODO ring", counterRotatingBeams, 2000 }),
+		Scenario({ "10^4 beam, FODO ring", largeBeam, 2 })
+	});
+
+	double tolerance(0.2);
+	vector<BenchmarkBaseline> baselines;
+	if (not update) {
+		ifstream file(path);
+		if (not file.is_open()) { ERROR(EXCEPTIONS::FILE_EXCEPTION); }
+		baselines = Benchmark::readBaseline(file, tolerance);
+	}
+
+	vector<BenchmarkBaseline> measures;
+	bool failed(false);
+
+	cout << left << setprecision(4);
+	cout << setw(STYLES::PADDING_LG) << "Scenario" << setw(STYLES::PADDING_MD) << "steps/s" << setw(STYLES::PADDING_MD) << "baseline"
+	     << setw(STYLES::PADDING_MD) << "noise" << setw(STYLES::PADDING_MD) << "allocs/step" << "result" << endl;
+
+	for (Scenario const& scenario : scenarios) {
+		Accelerator acc;
+		scenario.init(acc);
+
+		// Throughput of each repetition, the first one also warms up
+		vector<double> throughputs;
+		Benchmark::run(scenario.name, acc, scenario.steps);
+		for (size_t i(0); i < repetitions; ++i) {
+			BenchmarkResult result(Benchmark::run(scenario.name, acc, scenario.steps));
+			throughputs.push_back(result.particleSteps / result.seconds);
+		}
+
+		// Median and relative median absolute deviation
+		sort(throughputs.begin(), throughputs.end());
+		double median(throughputs[repetitions / 2]);
+		vector<double> deviations;
+		for (double throughput : throughputs) { deviations.push_back(abs(throughput - median)); }
+		sort(deviations.begin(), deviations.end());
+		double noise(deviations[repetitions / 2] / median);
+
+		size_t before(allocations.load());
+		for (size_t i(0); i < allocationSteps; ++i) { acc.step(); }
+		double allocationsPerStep(double(allocations.load() - before) / allocationSteps);
+
+		measures.push_back(BenchmarkBaseline({ scenario.name, median, allocationsPerStep }));
+
+		cout << setw(STYLES::PADDING_LG) << scenario.name << setw(STYLES::PADDING_MD) << median;
+
+		auto baseline(find_if(baselines.begin(), baselines.end(), [&](BenchmarkBaseline const& b) { return b.name == scenario.name; }));
+		if (update or baseline == baselines.end()) {
+			cout << setw(STYLES::PADDING_MD) << "-" << setw(STYLES::PADDING_MD) << noise << setw(STYLES::PADDING_MD) << allocationsPerStep
+			     << (update ? "recorded" : "no baseline") << endl;
+			continue;
+		}
+
+		double threshold(max(tolerance, 3 * noise));
+		bool slower(median < baseline->particleStepsPerSecond * (1 - threshold));
+		bool allocates(allocationsPerStep > baseline->allocationsPerStep);
+		bool lost(acc.getParticleCount() == 0);
+		failed = failed or slower or allocates or lost;
+
+		cout << setw(STYLES::PADDING_MD) << baseline->particleStepsPerSecond << setw(STYLES::PADDING_MD) << noise
+		     << setw(STYLES::PADDING_MD) << allocationsPerStep
+		     << (slower ? "SLOWER " : "") << (allocates ? "ALLOCATES " : "") << (lost ? "LOST " : "")
+		     << (slower or allocates or lost ? "" : "ok") << endl;
+	}
+
+	if (update) {
+		ofstream file(path);
+		if (not file.is_open()) { ERROR(EXCEPTIONS::FILE_EXCEPTION); }
+		Benchmark::writeBaseline(file, measures, tolerance);
+		cout << "Baseline written to " << path << endl;
+	}
+
+	return failed ? 1 : 0;
+}
@@ -124,7 +124,136 @@ int main() {
 	acc.step();
 	// cout << acc << endl;	// 3 particles
 
+	/****************************************************************
+	 * Progress along the ideal trajectory
+	 ****************************************************************/
+
+	// Half of the dipole (length pi / 2), then the straight (length 2)
+	Particle middle(Vector3D(sqrt(2) / 2, -sqrt(2) / 2, 0), 2, Vector3D(0, -1, 0), CONSTANTS::M_PROTON);
+	acc.initParticleToClosestElement(middle);
+	assert(Test::eq(acc.getParticleProgress(middle), (M_PI / 4) / (M_PI / 2 + 2)));
+
+	Particle straight(Vector3D(-1, -1, 0), 2, Vector3D(-1, 0, 0), CONSTANTS::M_PROTON);
+	acc.initParticleToClosestElement(straight);
+	assert(Test::eq(straight.getElementProgress(), 0.5));
+	assert(Test::eq(acc.getParticleProgress(straight), (M_PI / 2 + 1) / (M_PI / 2 + 2)));
+
+	/****************************************************************
+	 * Interaction regions
+	 ****************************************************************/
+
+	double length(M_PI / 2 + 2);
+
+	// Without region, the whole ring is one
+	assert(acc.getInteractionRegionCount() == 0);
+	assert(acc.getInteractionRegion(0.3) == 0);
+
+	acc.addInteractionRegion(1);
+	assert(acc.getInteractionRegion(acc.getParticleProgress(straight)) == 0);
+	assert(acc.getInteractionRegion(acc.getParticleProgress(middle)) == Accelerator::NO_INTERACTION_REGION);
+
+	// Across the entrance of the dipole, after the straight in the list
+	acc.addInteractionRegion(length - 0.1, 0.1);
+	assert(acc.getInteractionRegionCount() == 2);
+	assert(acc.getInteractionRegion(0.01) == 1);
+	assert(acc.getInteractionRegion(0.99) == 0);
+
+	ASSERT_EXCEPTION(acc.addInteractionRegion(2), EXCEPTIONS::BAD_INTERACTION_REGION);
+	ASSERT_EXCEPTION(acc.addInteractionRegion(-0.1, 1), EXCEPTIONS::BAD_INTERACTION_REGION);
+	ASSERT_EXCEPTION(acc.addInteractionRegion(1, length + 0.1), EXCEPTIONS::BAD_INTERACTION_REGION);
+
+	// Two Particles of different Beams side by side in the straight, with a huge charge for the force to be visible
+	Particle left(Vector3D(-1, -1, 0), 2, Vector3D(-1, 0, 0), CONSTANTS::M_PROTON, 100000);
+	Particle right(Vector3D(-1, -1.001, 0), 2, Vector3D(-1, 0, 0), CONSTANTS::M_PROTON, 100000);
+
+	auto momentumAfterStep = [&acc, &left, &right]() {
+		acc.clearBeams();
+		acc.addParticle(left);
+		acc.addParticle(right);
+		acc.step();
+		return acc.getBeam(0).getRecord(0).momentum[1];
+	};
+
+	// Inside the region of the straight, they push each other
+	double free(left.getSpeed().getY() * left.getMass());
+	assert(momentumAfterStep() != free);
+
+	// Out of the regions, they ignore each other
+	acc.clearInteractionRegions();
+	acc.addInteractionRegion(0);
+	assert(momentumAfterStep() == free);
+
+	// Without space charge, different Beams still interact
+	acc.setSpaceCharge(false);
+	assert(not acc.getSpaceCharge());
+	acc.clearInteractionRegions();
+	assert(momentumAfterStep() != free);
+	acc.setSpaceCharge(true);
+
 	acc.clear();
+	assert(acc.getInteractionRegionCount() == 0);
+
+	/****************************************************************
+	 * Adaptive timestep
+	 ****************************************************************/
+
+	Accelerator fixed(nullptr, false);
+	Accelerator adaptive(nullptr, false);
+	Test::makeRing(fixed);
+	Test::makeRing(adaptive);
+
+	ASSERT_EXCEPTION(adaptive.setTolerance(-1), EXCEPTIONS::BAD_TOLERANCE);
+	ASSERT_EXCEPTION(adaptive.getTimeStep(8), EXCEPTIONS::NO_ELEMENT);
+	assert(adaptive.getTolerance() == 0);
+	assert(adaptive.getTimeStep(1) == GLOBALS::DT);
+
+	// Either adaptive or bucketed
+	adaptive.setBucketed(true);
+	ASSERT_EXCEPTION(adaptive.setTolerance(1e-7), EXCEPTIONS::ADAPTIVE_BUCKETED);
+	assert(adaptive.getTolerance() == 0);
+	adaptive.setBucketed(false);
+
+	adaptive.setTolerance(1e-7);
+	assert(adaptive.getTolerance() == 1e-7);
+	ASSERT_EXCEPTION(adaptive.setBucketed(true), EXCEPTIONS::ADAPTIVE_BUCKETED);
+	assert(not adaptive.getBucketed());
+	adaptive.setBucketed(false);
+
+	Particle proton(Vector3D(2.99, 1.1, 0), 2, Vector3D(0, -2.64754e+08, 0), CONSTANTS::M_PROTON);
+	fixed.addParticle(proton);
+	adaptive.addParticle(proton);
+
+	// The loop is closed through the indices of the Elements
+	assert(adaptive.getBeam(0).getElementPtr(0)->getIndex() == 0);
+	assert(adaptive.getBeam(0).getElementPtr(0)->getPrev() == 7);
+	assert(adaptive.getBeam(0).getElementPtr(0)->getNext() == 1);
+
+	// In the straight, the Particle ends exactly at the end of the observation interval
+	adaptive.step(1e-10);
+	assert(adaptive.getBeam(0).getPos(0) == proton.getPos() + 1e-10 * proton.getSpeed());
+
+	// Through the dipole, as with a small fixed timestep
+	for (size_t i(0); i < 20000; ++i) { fixed.step(1e-12); }
+	for (size_t i(1); i < 200; ++i) { adaptive.step(1e-10); }
+	assert(adaptive.getBeam(0).getElementPtr(0)->getIndex() == 2);
+	assert(fixed.getBeam(0).getElementPtr(0)->getIndex() == 2);
+	assert((adaptive.getBeam(0).getPos(0) - fixed.getBeam(0).getPos(0)).norm() < 1e-3);
+
+	// Larger timesteps where there is no field
+	assert(adaptive.getTimeStep(0) > adaptive.getTimeStep(1));
+
+	// A Particle hitting the wall of the first straight in the middle of a long interval is lost there, and not further
+	adaptive.clearBeams();
+	adaptive.clearLosses();
+	adaptive.addParticle(Proton(Vector3D(3, 1.1, 0), 2, Vector3D(2e7, -2.64e+08, 5e6)));
+	adaptive.step(2e-8);
+	assert(adaptive.getBeamCount() == 0);
+	assert(adaptive.getLossMap().getTotalLosses() == 1);
+	assert(adaptive.getLossMap().getLosses(0) == 1);
+
+	adaptive.setTolerance(0);
+	adaptive.clear();
+	ASSERT_EXCEPTION(adaptive.getTimeStep(0), EXCEPTIONS::NO_ELEMENT);
 
 	return 0;
 }
@@ -0,0 +1,132 @@
+#include "globals.h"
+#include "exceptions.h"
+#include "include/bundle/Vector3D.bundle.h"
+#include "include/bundle/Particle.bundle.h"
+#include "include/bundle/Straight.bundle.h"
+#include "include/bundle/Dipole.bundle.h"
+#include "include/bundle/Accelerator.bundle.h"
+#include "include/bundle/Arena.bundle.h"
+#include "include/bundle/ThreadPool.bundle.h"
+#include "include/bundle/Test.bundle.h"
+
+using namespace std;
+
+int main() {
+	/****************************************************************
+	 * Bump allocation
+	 ****************************************************************/
+
+	Arena arena(1024);
+	assert(arena.getBlockCount() == 0);
+
+	void * first(arena.allocate(24));
+	void * second(arena.allocate(24));
+	assert(arena.getBlockCount() == 1);
+	assert(arena.getAllocationCount() == 2);
+	assert(static_cast<char *>(second) >= static_cast<char *>(first) + 24);
+	assert(reinterpret_cast<uintptr_t>(second) % alignof(max_align_t) == 0);
+
+	// A new block when the current one is full, and a block of its own for a large object
+	for (size_t i(0); i < 64; ++i) { arena.allocate(24); }
+	assert(arena.getBlockCount() > 1);
+	size_t blocks(arena.getBlockCount());
+	arena.allocate(4096);
+	assert(arena.getBlockCount() == blocks + 1);
+	assert(arena.getCapacity() >= 4096 + blocks * 1024);
+
+	// The memory of a destroyed object goes to the next object of the same size
+	Proton proton(Vector3D(2.99, 1.1, 0), 2, Vector3D(0, -2.64754e+08, 0));
+	Particle * copy(proton.copy(arena));
+	assert(copy->getKind() == ParticleKind::PROTON);
+	assert(copy->getPos() == proton.getPos());
+	assert(copy->getSize() == sizeof(Proton));
+	blocks = arena.getBlockCount();
+	arena.destroy(copy, copy->getSize());
+	assert(proton.copy(arena) == copy);
+	assert(arena.getBlockCount() == blocks);
+
+	arena.release();
+	assert(arena.getBlockCount() == 0);
+	assert(arena.getCapacity() == 0);
+	assert(arena.getAllocationCount() == 0);
+
+	// Swapped Arenas exchange their blocks, the objects staying where they are
+	Arena other(1024);
+	Particle * moved(proton.copy(other));
+	arena.swap(other);
+	assert(arena.getBlockCount() == 1);
+	assert(arena.getAllocationCount() == 1);
+	assert(other.getBlockCount() == 0);
+	assert(moved->getPos() == proton.getPos());
+	arena.destroy(moved, moved->getSize());
+	arena.release();
+
+	// A merged Arena gives its blocks and its free lists, the objects staying where they are
+	Arena chunk(2 * sizeof(Proton));
+	Particle * merged(proton.copy(chunk));
+	void * recycled(chunk.allocate(24));
+	chunk.recycle(recycled, 24);
+	arena.allocate(24);
+	arena.merge(chunk);
+	assert(chunk.getBlockCount() == 0);
+	assert(chunk.getCapacity() == 0);
+	assert(arena.getBlockCount() == 2);
+	assert(arena.getAllocationCount() == 3);
+	assert(merged->getPos() == proton.getPos());
+	assert(arena.allocate(24) == recycled);
+	arena.destroy(merged, merged->getSize());
+	arena.release();
+
+	ASSERT_EXCEPTION(Arena(0), EXCEPTIONS::BAD_ARENA);
+	ASSERT_EXCEPTION(arena.allocate(8, 2 * alignof(max_align_t)), EXCEPTIONS::BAD_ARENA);
+
+	/****************************************************************
+	 * Particles of a Beam and Elements of an Accelerator
+	 ****************************************************************/
+
+	Accelerator acc;
+	Test::makeRing(acc);
+
+	acc.addParticle(proton);
+	acc.addBeam(proton, 1000, 1);
+	assert(acc.getBeamCount() == 2);
+	assert(acc.getParticleCount() == 1001);
+	assert(acc.getBeam(0).getPos(0) == proton.getPos());
+	assert(acc.getBeam(0).getElementPtr(0) != nullptr);
+
+	// The Particles of a Beam built on a ThreadPool are constructed in an Arena per chunk, then taken over by the Beam
+	ThreadPool pool(2);
+	Accelerator parallel;
+	parallel.setThreadPool(&pool);
+	parallel.addElement(Straight(Vector3D(3, 2, 0), Vector3D(3, -2, 0), 0.1));
+	parallel.addBeam(proton, 1000, 1);
+	assert(parallel.getParticleCount() == 1000);
+	assert(parallel.getBeam(0).getElementPtr(999) != nullptr);
+
+	for (size_t i(0); i < 100; ++i) { acc.step(); }
+	assert(acc.getParticleCount() > 0);
+
+	// The Particles which leave and come back are rebuilt in the memory of the ones which left
+	Profiler::local().reset();
+	vector<ParticleRecord> records;
+	acc.extractParticles(records, [](ParticleRecord const& r) { return r.beam == 1 and r.progress < 0.5; });
+	size_t count(acc.getParticleCount() + records.size());
+	acc.insertParticles(records);
+	assert(acc.getParticleCount() == count);
+	if (Profiler::ENABLED) {
+		assert(Profiler::local().getCount(ProfilerCounter::ARENA_ALLOCATIONS) == records.size());
+		assert(Profiler::local().getCount(ProfilerCounter::ARENA_BLOCKS) == 0);
+	}
+
+	// Sorted, the Particles are copied in a new Arena in their new order
+	Profiler::local().reset();
+	acc.reorderParticles();
+	assert(acc.getParticleCount() == count);
+	if (Profiler::ENABLED) { assert(Profiler::local().getCount(ProfilerCounter::ARENA_ALLOCATIONS) == count); }
+
+	acc.clear();
+	assert(acc.getParticleCount() == 0);
+	assert(acc.getBeamCount() == 0);
+
+	return 0;
+}
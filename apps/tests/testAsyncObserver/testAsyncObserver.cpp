@@ -0,0 +1,130 @@
+#include "globals.h"
+#include "exceptions.h"
+#include "include/bundle/Vector3D.bundle.h"
+#include "include/bundle/Particle.bundle.h"
+#include "include/bundle/Dipole.bundle.h"
+#include "include/bundle/Accelerator.bundle.h"
+#include "include/bundle/AsyncObserver.bundle.h"
+#include "include/bundle/Test.bundle.h"
+
+#include <sstream>
+#include <thread>
+
+using namespace std;
+
+// Number of lines of `text` starting with `prefix`
+size_t lines(string const& text, string const& prefix) {
+	size_t count(0);
+	stringstream stream(text);
+	for (string line; getline(stream, line);) {
+		if (line.compare(0, prefix.size(), prefix) == 0) { ++count; }
+	}
+	return count;
+}
+
+int main() {
+	/****************************************************************
+	 * Ring buffer
+	 ****************************************************************/
+
+	RingBuffer<int> small(5);
+	assert(small.getCapacity() == 8);
+	assert(small.getSize() == 0);
+
+	int value(0);
+	assert(not small.tryPop(value));
+	for (int i(0); i < 8; ++i) { assert(small.tryPush(i)); }
+	assert(not small.tryPush(8));
+	assert(small.getSize() == 8);
+
+	// First in, first out, also once the positions wrap
+	for (int i(0); i < 20; ++i) {
+		assert(small.tryPop(value) and value == i);
+		assert(small.tryPush(i + 8));
+	}
+
+	// One producer and one consumer thread
+	RingBuffer<size_t> shared(64);
+	size_t const count(1000000);
+	thread consumer([&shared, count]() {
+		size_t expected(0), popped(0);
+		while (expected < count) {
+			if (shared.tryPop(popped)) {
+				assert(popped == expected);
+				++expected;
+			}
+		}
+	});
+	for (size_t i(0); i < count;) {
+		if (shared.tryPush(i)) { ++i; }
+	}
+	consumer.join();
+	assert(shared.getSize() == 0);
+
+	/****************************************************************
+	 * Observer
+	 ****************************************************************/
+
+	Accelerator acc;
+	acc.addElement(Dipole(Vector3D(1, 0, 0), Vector3D(0, -1, 0), 0.1, 1, 7));
+	acc.addElement(Dipole(Vector3D(0, -1, 0), Vector3D(-1, 0, 0), 0.1, 1, 7));
+	acc.addElement(Dipole(Vector3D(-1, 0, 0), Vector3D(0, 1, 0), 0.1, 1, 7));
+	acc.addElement(Dipole(Vector3D(0, 1, 0), Vector3D(1, 0, 0), 0.1, 1, 7));
+	acc.closeElementLoop();
+	acc.addBeam(Proton(Vector3D(1, 0, 0), 2, Vector3D(0, -1, 0)), 100, 1);
+	acc.addBeam(AntiProton(Vector3D(1, 0, 0), 2, Vector3D(0, -1, 0)), 50, 1);
+
+	assert(acc.getBeamCount() == 2);
+	assert(acc.getBeam(1).getParticleCount() == 50);
+	assert(acc.getBeamId(0) != acc.getBeamId(1));
+	ASSERT_EXCEPTION(acc.getBeam(2), EXCEPTIONS::NO_BEAM);
+	ASSERT_EXCEPTION(acc.getBeamId(2), EXCEPTIONS::NO_BEAM);
+	ASSERT_EXCEPTION(AsyncObserver(cout, BackpressurePolicy::BLOCK, 0), EXCEPTIONS::BAD_CAPACITY);
+
+	// Blocking: every sample is written, even with a buffer much smaller than a single observation
+	stringstream output;
+	size_t positions(0), statistics(0), initialCount(acc.getParticleCount());
+	{
+		AsyncObserver observer(output, BackpressurePolicy::BLOCK, 16);
+		observer.observeLosses(acc, 0, 0);
+
+		for (size_t step(1); step <= 20; ++step) {
+			acc.step();
+			positions += acc.getParticleCount();
+			statistics += acc.getBeamCount();
+			observer.observePositions(acc, step, step * GLOBALS::DT);
+			observer.observeStatistics(acc, step, step * GLOBALS::DT);
+			observer.observeLosses(acc, step, step * GLOBALS::DT);
+		}
+
+		observer.flush();
+		assert(observer.getDroppedSamples() == 0);
+		assert(observer.getWrittenSamples() == positions + statistics + lines(output.str(), "loss,"));
+	}
+
+	assert(lines(output.str(), "position,") == positions);
+	assert(lines(output.str(), "statistics,") == statistics);
+	assert(lines(output.str(), "position,1,") == 150);
+	assert(lines(output.str(), "statistics,1,1e-11,") == 2);
+
+	// Every lost macroparticle is reported once
+	size_t lost(0);
+	stringstream stream(output.str());
+	for (string line; getline(stream, line);) {
+		if (line.compare(0, 5, "loss,") == 0) { lost += stoul(line.substr(line.find_last_of(',') + 1)); }
+	}
+	assert(lost == initialCount - acc.getParticleCount());
+
+	// Dropping: the simulation never waits, and the samples are either written or counted as dropped
+	stringstream dropped;
+	{
+		AsyncObserver observer(dropped, BackpressurePolicy::DROP, 2);
+		for (size_t step(0); step < 100; ++step) { observer.observePositions(acc, step, 0); }
+		observer.flush();
+		assert(observer.getPolicy() == BackpressurePolicy::DROP);
+		assert(observer.getWrittenSamples() + observer.getDroppedSamples() == 100 * acc.getParticleCount());
+		assert(lines(dropped.str(), "position,") == observer.getWrittenSamples());
+	}
+
+	return 0;
+}
@@ -6,6 +6,7 @@
 #include "include/bundle/Dipole.bundle.h"
 #include "include/bundle/Beam.bundle.h"
 #include "include/bundle/TextRenderer.bundle.h"
+#include "include/bundle/ThreadPool.bundle.h"
 #include "include/bundle/Test.bundle.h"
 
 using namespace std;
@@ -46,5 +47,128 @@ int main() {
 
 	// cout << beam_2;
 
+	/****************************************************************
+	 * Construction on a ThreadPool
+	 ****************************************************************/
+
+	// More Particles than GLOBALS::PARALLEL_GRAIN, so the construction is split
+	size_t const count(3 * GLOBALS::PARALLEL_GRAIN + 1);
+	ThreadPool pool(4);
+
+	for (bool beamFromParticle : { false, true }) {
+		Accelerator serial(&engine, true, beamFromParticle);
+		Accelerator parallel(&engine, true, beamFromParticle);
+		parallel.setThreadPool(&pool);
+
+		for (Accelerator * acc_ptr : { &serial, &parallel }) {
+			acc_ptr->addElement(dipole_1);
+			acc_ptr->addElement(Dipole(Vector3D(0, -1, 0), Vector3D(-1, 0, 0), 0.1, 1, 7));
+			acc_ptr->addElement(Dipole(Vector3D(-1, 0, 0), Vector3D(0, 1, 0), 0.1, 1, 7));
+			acc_ptr->addElement(Dipole(Vector3D(0, 1, 0), Vector3D(1, 0, 0), 0.1, 1, 7));
+			acc_ptr->closeElementLoop();
+		}
+
+		Beam beam_serial(part_1, count, 1, serial);
+		Beam beam_parallel(part_1, count, 1, parallel);
+
+		assert(beam_serial.getParticleCount() == count);
+		assert(beam_parallel.getParticleCount() == count);
+		for (size_t i(0); i < count; ++i) {
+			assert(beam_serial.getPos(i) == beam_parallel.getPos(i));
+			assert(beam_parallel.getElementPtr(i) != nullptr);
+		}
+	}
+
+	/****************************************************************
+	 * Integration Element by Element
+	 ****************************************************************/
+
+	Accelerator ring(nullptr, true, false);
+	ring.addElement(dipole_1);
+	ring.addElement(Dipole(Vector3D(0, -1, 0), Vector3D(-1, 0, 0), 0.1, 1, 7));
+	ring.addElement(Dipole(Vector3D(-1, 0, 0), Vector3D(0, 1, 0), 0.1, 1, 7));
+	ring.addElement(Dipole(Vector3D(0, 1, 0), Vector3D(1, 0, 0), 0.1, 1, 7));
+	ring.closeElementLoop();
+
+	Beam ordered(part_1, 1000, 1, ring);
+	Beam bucketed(part_1, 1000, 1, ring);
+
+	for (size_t i(0); i < 50; ++i) {
+		ordered.step(GLOBALS::DT, true);
+		ordered.updatePointedElement(true);
+		bucketed.stepByElement(GLOBALS::DT, true);
+		bucketed.updatePointedElement(true);
+	}
+
+	// The same trajectories
+	assert(bucketed.getParticleCount() == ordered.getParticleCount());
+	for (size_t i(0); i < bucketed.getParticleCount(); ++i) {
+		assert(bucketed.getPos(i) == ordered.getPos(i));
+	}
+
+	// The lists of Particles followed the changes of Element
+	size_t listed(0);
+	for (size_t element(0); element < 4; ++element) {
+		for (size_t part : bucketed.getElementParticles(element)) {
+			assert(bucketed.getElementPtr(part)->getIndex() == element);
+		}
+		listed += bucketed.getElementParticles(element).size();
+	}
+	assert(listed == bucketed.getParticleCount());
+
+	assert(not ring.getBucketed());
+	ring.setBucketed(true);
+	assert(ring.getBucketed());
+
+	/****************************************************************
+	 * Reordering
+	 ****************************************************************/
+
+	// Same shuffled Beams, sorted with and without the ThreadPool
+	Accelerator unsorted(nullptr, true, false);
+	Accelerator sorted(nullptr, true, false);
+	sorted.setThreadPool(&pool);
+
+	for (Accelerator * acc_ptr : { &unsorted, &sorted }) {
+		acc_ptr->addElement(dipole_1);
+		acc_ptr->addElement(Dipole(Vector3D(0, -1, 0), Vector3D(-1, 0, 0), 0.1, 1, 7));
+		acc_ptr->addElement(Dipole(Vector3D(-1, 0, 0), Vector3D(0, 1, 0), 0.1, 1, 7));
+		acc_ptr->addElement(Dipole(Vector3D(0, 1, 0), Vector3D(1, 0, 0), 0.1, 1, 7));
+		acc_ptr->closeElementLoop();
+		acc_ptr->addBeam(part_1, count, 1);
+
+		// The Particles which leave and come back are appended in no particular order
+		vector<ParticleRecord> records;
+		acc_ptr->extractParticles(records, [](ParticleRecord const& r) { return r.progress < 0.6; });
+		acc_ptr->insertParticles(records);
+	}
+
+	Beam const& shuffled(unsorted.getBeam(0));
+	vector<Vector3D> positions(count);
+	for (size_t i(0); i < count; ++i) { positions[shuffled.getParticleId(i)] = shuffled.getPos(i); }
+	vector<ParticleRecord> records;
+	unsorted.exportParticles(records);
+	assert(records.front().progress > records.back().progress);
+
+	unsorted.reorderParticles();
+	sorted.reorderParticles();
+
+	// Sorted by progress, the ids following the Particles
+	records.clear();
+	unsorted.exportParticles(records);
+	for (size_t i(0); i < count; ++i) {
+		if (i > 0) { assert(records[i - 1].progress <= records[i].progress); }
+		assert(records[i].id == shuffled.getParticleId(i));
+		assert(shuffled.getPos(i) == positions[shuffled.getParticleId(i)]);
+		assert(sorted.getBeam(0).getParticleId(i) == shuffled.getParticleId(i));
+	}
+
+	// Every K steps
+	assert(unsorted.getReorderInterval() == 0);
+	unsorted.setReorderInterval(10);
+	assert(unsorted.getReorderInterval() == 10);
+	for (size_t i(0); i < 20; ++i) { unsorted.step(); }
+	assert(unsorted.getParticleCount() > 0);
+
 	return 0;
 }
@@ -65,6 +65,15 @@ int main() {
 	assert(Test::eq(quadru.getRadius(), 0.1));
 	assert(quadru.getField(Vector3D(3.01, 0, 0)) == Vector3D(0, 0, -0.012));
 
+	// The same fields in batch
+	vector<Vector3D> positions({ Vector3D(3.01, 0, 0), Vector3D(2.95, -0.5, 0.02), Vector3D(3, -0.9, -0.01) });
+	vector<Vector3D> fields;
+	quadru.getFields(positions, fields);
+	assert(fields.size() == positions.size());
+	for (size_t i(0); i < positions.size(); ++i) { assert(fields[i] == quadru.getField(positions[i])); }
+	dipole.getFields(positions, fields);
+	assert(fields[2] == Vector3D(0, 0, 7));
+
 	Particle p3(Vector3D(3.01, 0, 0), 1.9999868, Vector3D(0, -2.64754e8, 0), 0.938272);
 
 	Particle p4(Vector3D(3.01, -0.00264754, 0), 1.9999868, Vector3D(1427.7, -2.64754e+08, 0), 0.938272);
@@ -127,20 +136,45 @@ int main() {
 	assert(Test::eq(p5.getChargeNumber(), p6.getChargeNumber()));
 
 	/****************************************************************
-	 * linkNext + updatePointedElement
+	 * linkAccelerator + linkNext + updatePointedElement
 	 ****************************************************************/
 	Straight straight2(Vector3D(3, 0, 0), Vector3D(3.01, -1, 0), 0.1);
 	Straight straight3(Vector3D(3.01, -1, 0), Vector3D(3.02, -2, 0), 0.1);
 
 	Particle p7(Vector3D(3.015, -1.2, 0), 1, Vector3D(-210200, -2.64754e8, 0), 0.938272);
+
+	// The links are indices in a table of Elements
+	ASSERT_EXCEPTION(straight2.linkNext(straight3), EXCEPTIONS::NOT_SAME_LATTICE);
+	vector<Element *> lattice({ &straight2, &straight3 });
+	straight2.linkAccelerator(0, 0);
+	straight3.linkAccelerator(1, straight2.getLength());
+	ASSERT_EXCEPTION(straight2.linkNext(straight1), EXCEPTIONS::NOT_SAME_LATTICE);
 	straight2.linkNext(straight3);
+	assert(straight2.getNext() == 1 and straight2.getPrev() == Element::NO_LINK);
+	assert(straight3.getPrev() == 0 and straight3.getNext() == Element::NO_LINK);
 
 	dist = straight2.getParticleProgress(p7.getPos());
 	assert(not (dist <=1 and dist >= 0));
-	straight2.updatePointedElement(p7);
+	straight2.updatePointedElement(p7, lattice);
+	assert(p7.getElementIndex() == 1 and &p7.getElement(lattice) == &straight3);
+	ASSERT_EXCEPTION(p7.getElementPtr(), EXCEPTIONS::NULLPTR);
 	dist = straight3.getParticleProgress(p7.getPos());
 	assert(dist <=1 and dist >= 0);
 
+	// Copies of the Elements keep their links, resolved in the table of the copies
+	Straight straight4(straight2), straight5(straight3);
+	vector<Element *> moved({ &straight4, &straight5 });
+	assert(straight4.isLinked() and straight4.getNext() == 1);
+	Particle p8(Vector3D(3.015, -1.2, 0), 1, Vector3D(-210200, -2.64754e8, 0), 0.938272);
+	straight4.updatePointedElement(p8, moved);
+	assert(&p8.getElement(moved) == &straight5);
+	// The index of the Particle is resolved in the table given
+	assert(&p8.getElement(lattice) == &straight3);
+
+	// There is no Element after the last one of an open table
+	Particle p9(Vector3D(3.02, -2.2, 0), 1, Vector3D(-210200, -2.64754e8, 0), 0.938272);
+	ASSERT_EXCEPTION(straight5.updatePointedElement(p9, moved), EXCEPTIONS::OUTSIDE_ACCELERATOR);
+
 	/**
 	 * For manual comparaison
 	 */
@@ -0,0 +1,96 @@
+#include "globals.h"
+#include "exceptions.h"
+#include "include/bundle/Straight.bundle.h"
+#include "include/bundle/Dipole.bundle.h"
+#include "include/bundle/ElementIndex.bundle.h"
+#include "include/bundle/Accelerator.bundle.h"
+#include "include/bundle/Test.bundle.h"
+
+#include <random>
+
+using namespace std;
+
+// Search without the index, as Accelerator::initParticleToClosestElement() used to do
+size_t linearFind(vector<shared_ptr<Element>> const& elements, Vector3D const& pos, bool methodChapi) {
+	for (size_t i(0); i < elements.size(); ++i) {
+		double progress(elements[i]->getParticleProgress(pos, methodChapi));
+		if (progress >= 0 and progress <= 1 and not elements[i]->isInWall(pos)) { return i; }
+	}
+	return ElementIndex::NOT_FOUND;
+}
+
+int main() {
+	ElementIndex index;
+	assert(index.find(Vector3D(1, 0, 0)) == ElementIndex::NOT_FOUND);
+
+	// Ring of the application: Straight sections and Dipoles
+	vector<shared_ptr<Element>> elements;
+	Vector3D pos_dep(3, 2, 0);
+	Vector3D dir_straight(0, -1, 0);
+	Vector3D pos_fin;
+	Vector3D dir_dipole(-1, -1, 0);
+
+	for (int i = 0; i < 4; ++i) {
+		pos_fin = pos_dep + 4 * dir_straight;
+		elements.push_back(shared_ptr<Element>(new Straight(pos_dep, pos_fin, 0.1)));
+		pos_dep = pos_fin;
+		pos_fin += dir_dipole;
+		elements.push_back(shared_ptr<Element>(new Dipole(pos_dep, pos_fin, 0.1, 1, 5.89158)));
+		pos_dep = pos_fin;
+		dir_straight ^= Vector3D(0, 0, 1);
+		dir_dipole ^= Vector3D(0, 0, 1);
+	}
+
+	for (bool methodChapi : { true, false }) {
+		index.build(elements, methodChapi);
+		assert(index.getBinCount() == 4 * elements.size());
+
+		// Points inside the beam pipe, in its wall and far away
+		mt19937 generator(1);
+		uniform_real_distribution<double> progress(0, 1);
+		uniform_real_distribution<double> offset(-0.15, 0.15);
+
+		vector<Vector3D> points;
+		for (size_t i(0); i < 2000; ++i) {
+			Element const& element(*elements[i % elements.size()]);
+			points.push_back(element.getPosAtProgress(progress(generator)) + Vector3D(offset(generator), offset(generator), offset(generator) / 3));
+		}
+		points.push_back(Vector3D(0, 0, 0));
+		points.push_back(Vector3D(10, 10, 0));
+
+		for (Vector3D const& point : points) {
+			assert(index.find(point) == linearFind(elements, point, methodChapi));
+		}
+
+		// Batch query, on a ThreadPool or not
+		ThreadPool pool(2);
+		vector<size_t> serial;
+		vector<size_t> parallel;
+		index.find(points, serial);
+		index.find(points, parallel, &pool);
+		assert(serial.size() == points.size());
+		assert(serial == parallel);
+		assert(serial.back() == ElementIndex::NOT_FOUND);
+	}
+
+	index.clear();
+	assert(index.getBinCount() == 0);
+
+	/****************************************************************
+	 * Index of an Accelerator
+	 ****************************************************************/
+
+	// Built at the first search after Elements were added, then again after the next ones
+	Accelerator acc;
+	for (size_t i(0); i < elements.size() / 2; ++i) { acc.addElement(*elements[i]); }
+	assert(acc.getElementIndex().getBinCount() == 2 * elements.size());
+	for (size_t i(elements.size() / 2); i < elements.size(); ++i) { acc.addElement(*elements[i]); }
+	acc.closeElementLoop();
+	assert(acc.getElementIndex().getBinCount() == 4 * elements.size());
+	assert(acc.getElementIndex().find(elements[5]->getPosAtProgress(0.5)) == 5);
+
+	acc.clear();
+	assert(acc.getElementIndex().getBinCount() == 0);
+
+	return 0;
+}
@@ -67,4 +67,75 @@ int main() {
 	acc.clear();
 	accbis.clear();
 	acctri.clear();
+
+	/****************************************************************
+	 * Flattening
+	 ****************************************************************/
+
+	// The Elements added after the pass are expanded too, and the Frodos are kept for the display
+	Accelerator later(&engine, false);
+	later.flattenElements();
+	later.addElement(FRODO);
+	later.addElement(SAM);
+	assert(later.getFlattened());
+	assert(later.getLossMap().getElementCount() == 8);
+	assert(later.to_string().find("Accelerator contains 2 element(s)") != string::npos);
+	later.addParticle(p1);
+	assert(later.getBeam(0).getElementPtr(0)->getIndex() == 0);
+	// As when the Frodos are added before the pass (see below)
+	assert(later.getAddedElements()[1]->getIndex() == 4);
+	assert(later.getAddedElements()[1]->getNext() == Element::NO_LINK);
+	// A second pass changes nothing
+	later.flattenElements();
+	assert(later.getLossMap().getElementCount() == 8);
+	assert(later.getBeam(0).getElementPtr(0)->getIndex() == 0);
+
+	// Same trajectories through the sections as through the whole Frodos
+	for (bool methodChapi : { false, true }) {
+		Accelerator whole(nullptr, methodChapi);
+		Accelerator flat(nullptr, methodChapi);
+		// Flattened while its Particle goes around
+		Accelerator late(nullptr, methodChapi);
+		Test::makeRing(whole, true);
+		Test::makeRing(flat, true);
+		Test::makeRing(late, true);
+
+		// The loop stays closed
+		flat.flattenElements();
+		assert(flat.getLossMap().getElementCount() == 20);
+
+		// The Frodos kept for the display take the index of their first section, without neighbours
+		for (size_t j(0); j < 4; ++j) {
+			Element const& frodo(*flat.getAddedElements()[2 * j]);
+			Element const& dipole(*flat.getAddedElements()[2 * j + 1]);
+			assert(frodo.getIndex() == 5 * j);
+			assert(frodo.getNext() == Element::NO_LINK and frodo.getPrev() == Element::NO_LINK);
+			assert(dipole.getIndex() == 5 * j + 4);
+			assert(dipole.getNext() == (5 * j + 5) % 20);
+		}
+
+		Proton proton(Vector3D(2.99, 1.1, 0), 2, Vector3D(0, -2.64754e+08, 0));
+		whole.addParticle(proton);
+		flat.addParticle(proton);
+		late.addParticle(proton);
+		assert(flat.getBeam(0).getElementPtr(0)->getIndex() == 0);
+
+		for (size_t i(0); i < 9000 and whole.getBeamCount() == 1; ++i) {
+			if (i == 3000) {
+				late.flattenElements();
+				assert(late.getBeam(0).getElementIndex(0) == flat.getBeam(0).getElementIndex(0));
+			}
+			whole.step();
+			flat.step();
+			late.step();
+			assert(flat.getBeamCount() == whole.getBeamCount());
+			assert(late.getBeamCount() == whole.getBeamCount());
+			if (whole.getBeamCount() == 1) {
+				assert((whole.getBeam(0).getPos(0) - flat.getBeam(0).getPos(0)).norm() < 1e-9);
+				assert((whole.getBeam(0).getPos(0) - late.getBeam(0).getPos(0)).norm() < 1e-9);
+				// The Frodo 2j is made of the sections 5j to 5j+3, and the Dipole 2j+1 is the section 5j+4
+				assert(flat.getBeam(0).getElementPtr(0)->getIndex() / 5 == whole.getBeam(0).getElementPtr(0)->getIndex() / 2);
+			}
+		}
+	}
 }
@@ -0,0 +1,139 @@
+#include "globals.h"
+#include "exceptions.h"
+#include "include/bundle/Vector3D.bundle.h"
+#include "include/bundle/Particle.bundle.h"
+#include "include/bundle/Frodo.bundle.h"
+#include "include/bundle/Dipole.bundle.h"
+#include "include/bundle/Accelerator.bundle.h"
+#include "include/bundle/Lattice.bundle.h"
+#include "include/bundle/Test.bundle.h"
+
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+
+using namespace std;
+
+// Ring of the application (see assets/lattices/fodo.lattice)
+string const FODO(
+	"# FODO ring\n"
+	"frodo    3  2 0    3 -2 0   0.1  1.2  1\n"
+	"dipole   3 -2 0    2 -3 0   0.1  1    5.89158   # first dipole\n"
+	"frodo    2 -3 0   -2 -3 0   0.1  1.2  1\n"
+	"dipole  -2 -3 0   -3 -2 0   0.1  1    5.89158\n"
+	"\n"
+	"frodo   -3 -2 0   -3  2 0   0.1  1.2  1\n"
+	"dipole  -3  2 0   -2  3 0   0.1  1    5.89158\n"
+	"frodo   -2  3 0    2  3 0   0.1  1.2  1\n"
+	"dipole   2  3 0    3  2 0   0.1  1    5.89158\n"
+	"close\n"
+	"beam proton      2.99 1.1 0   2   0 -2.64754e+08 0   50 1\n"
+	"beam antiproton  2.99 1.1 0   2   0  2.64754e+08 0   50 1\n"
+);
+
+// Parses `text`
+Lattice parse(string const& text) {
+	stringstream stream(text);
+	return Lattice::parse(stream);
+}
+
+int main() {
+	/****************************************************************
+	 * Text format
+	 ****************************************************************/
+
+	Lattice lattice(parse(FODO));
+	assert(lattice.getElementCount() == 8);
+	assert(lattice.getBeamCount() == 2);
+	assert(lattice.isClosed());
+	assert(not lattice.isFromCache());
+
+	// Same Accelerator as the one built by hand
+	Accelerator acc;
+	lattice.build(acc);
+	assert(acc.getBeamCount() == 2);
+	assert(acc.getParticleCount() == 100);
+	assert(acc.getBeam(0).getRecord(0).kind == ParticleKind::PROTON);
+	assert(acc.getBeam(1).getRecord(0).kind == ParticleKind::ANTIPROTON);
+
+	Accelerator reference;
+	reference.addElement(Frodo(Vector3D(3, 2, 0), Vector3D(3, -2, 0), 0.1, 1.2, 1));
+	reference.addElement(Dipole(Vector3D(3, -2, 0), Vector3D(2, -3, 0), 0.1, 1, 5.89158));
+	reference.addElement(Frodo(Vector3D(2, -3, 0), Vector3D(-2, -3, 0), 0.1, 1.2, 1));
+	reference.addElement(Dipole(Vector3D(-2, -3, 0), Vector3D(-3, -2, 0), 0.1, 1, 5.89158));
+	reference.addElement(Frodo(Vector3D(-3, -2, 0), Vector3D(-3, 2, 0), 0.1, 1.2, 1));
+	reference.addElement(Dipole(Vector3D(-3, 2, 0), Vector3D(-2, 3, 0), 0.1, 1, 5.89158));
+	reference.addElement(Frodo(Vector3D(-2, 3, 0), Vector3D(2, 3, 0), 0.1, 1.2, 1));
+	reference.addElement(Dipole(Vector3D(2, 3, 0), Vector3D(3, 2, 0), 0.1, 1, 5.89158));
+	reference.closeElementLoop();
+	reference.addBeam(Proton(Vector3D(2.99, 1.1, 0), 2, Vector3D(0, -2.64754e+08, 0)), 50, 1);
+	reference.addBeam(AntiProton(Vector3D(2.99, 1.1, 0), 2, Vector3D(0, 2.64754e+08, 0)), 50, 1);
+
+	for (size_t i(0); i < 100; ++i) {
+		acc.step();
+		reference.step();
+	}
+	assert(acc.getParticleCount() == reference.getParticleCount());
+	assert(Test::eq(acc.getMeanEmittanceR(), reference.getMeanEmittanceR()));
+
+	// Malformed entries
+	ASSERT_EXCEPTION(parse("dipole 3 -2 0 2 -3 0 0.1 1\n"), EXCEPTIONS::BAD_LATTICE);
+	ASSERT_EXCEPTION(parse("dipole 3 -2 0 2 -3 0 0.1 1 5 6\n"), EXCEPTIONS::BAD_LATTICE);
+	ASSERT_EXCEPTION(parse("sextupole 3 -2 0 2 -3 0 0.1\n"), EXCEPTIONS::BAD_LATTICE);
+	ASSERT_EXCEPTION(parse("straight 1 1 0 1 -1 0 0.1\nbeam muon 0.5 0 0 2 1 0 0 10 1\n"), EXCEPTIONS::BAD_LATTICE);
+	ASSERT_EXCEPTION(parse(FODO + "straight 3 2 0 4 2 0 0.1\n"), EXCEPTIONS::BAD_LATTICE);
+
+	// Invalid geometry
+	ASSERT_EXCEPTION(parse("straight 1 1 0 1 -1 0 0.1\nstraight 1 -2 0 -1 -2 0 0.1\n"), EXCEPTIONS::ELEMENTS_NOT_TOUCHING);
+	ASSERT_EXCEPTION(parse("straight 1 1 0 1 -1 0 0.1\nstraight 1 -1 0 -1 -1 0 0.1\nclose\n"), EXCEPTIONS::ELEMENT_LOOP_INCOMPLETE);
+
+	/****************************************************************
+	 * Binary cache
+	 ****************************************************************/
+
+	assert(Lattice::hash("") == 14695981039346656037ULL);
+	assert(Lattice::hash("a") == 0xaf63dc4c8601ec8cULL);
+	assert(Lattice::hash(FODO) != Lattice::hash(FODO + " "));
+
+	stringstream cache;
+	lattice.writeCache(cache, Lattice::hash(FODO));
+
+	Lattice cached;
+	assert(Lattice::readCache(cache, Lattice::hash(FODO), cached));
+	assert(cached.getElementCount() == 8 and cached.getBeamCount() == 2 and cached.isClosed());
+
+	Accelerator fromCache;
+	cached.build(fromCache);
+	assert(fromCache.getParticleCount() == 100);
+
+	// Another text, or a truncated cache
+	Lattice untouched;
+	cache.clear();
+	cache.seekg(0);
+	assert(not Lattice::readCache(cache, Lattice::hash(FODO + " "), untouched));
+	stringstream truncated(cache.str().substr(0, cache.str().size() - 8));
+	assert(not Lattice::readCache(truncated, Lattice::hash(FODO), untouched));
+	assert(untouched.getElementCount() == 0);
+
+	// The file is parsed once, then read from its cache until it changes
+	string const fileName("testLattice.lattice");
+	remove(Lattice::getCacheName(fileName).c_str());
+	ofstream(fileName) << FODO;
+
+	assert(not Lattice::load(fileName).isFromCache());
+	Lattice loaded(Lattice::load(fileName));
+	assert(loaded.isFromCache());
+	assert(loaded.getElementCount() == 8 and loaded.getBeamCount() == 2);
+
+	ofstream(fileName) << FODO << "beam electron 2.99 1.1 0 2 0 -2.99e+08 0 10 1\n";
+	Lattice changed(Lattice::load(fileName));
+	assert(not changed.isFromCache());
+	assert(changed.getBeamCount() == 3);
+	assert(Lattice::load(fileName).isFromCache());
+
+	remove(fileName.c_str());
+	remove(Lattice::getCacheName(fileName).c_str());
+	ASSERT_EXCEPTION(Lattice::load(fileName), EXCEPTIONS::FILE_EXCEPTION);
+
+	return 0;
+}
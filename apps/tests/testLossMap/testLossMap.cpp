@@ -0,0 +1,73 @@
+#include "globals.h"
+#include "exceptions.h"
+#include "include/bundle/Vector3D.bundle.h"
+#include "include/bundle/Particle.bundle.h"
+#include "include/bundle/Straight.bundle.h"
+#include "include/bundle/Dipole.bundle.h"
+#include "include/bundle/Accelerator.bundle.h"
+#include "include/bundle/LossMap.bundle.h"
+#include "include/bundle/Test.bundle.h"
+
+#include <sstream>
+
+using namespace std;
+
+int main() {
+	ASSERT_EXCEPTION(LossMap(0, 4), EXCEPTIONS::BAD_LOSS_MAP);
+	ASSERT_EXCEPTION(LossMap(4, 0), EXCEPTIONS::BAD_LOSS_MAP);
+
+	Accelerator acc;
+	Test::makeRing(acc);
+
+	LossMap const& losses(acc.getLossMap());
+	assert(losses.getElementCount() == 8);
+	assert(losses.getTotalLosses() == 0);
+	assert(losses.getLossRate(0) == 0);
+	ASSERT_EXCEPTION(losses.getLosses(8), EXCEPTIONS::NO_ELEMENT);
+	ASSERT_EXCEPTION(losses.getRadialHistogram(8), EXCEPTIONS::NO_ELEMENT);
+
+	/****************************************************************
+	 * Losses in the first straight
+	 ****************************************************************/
+
+	// The normal direction of the first straight is +x: one Particle drifts outwards (slightly upwards), the other one upwards
+	acc.addParticle(Proton(Vector3D(3, 1.1, 0), 2, Vector3D(2e7, -2.64e+08, 5e6)));
+	acc.addParticle(Proton(Vector3D(3, 1.1, 0), 2, Vector3D(0, -2.64e+08, 2e7)));
+
+	for (size_t i(0); i < 600; ++i) { acc.step(); }
+	assert(acc.getParticleCount() == 0);
+
+	assert(losses.getLosses(0) == 2);
+	assert(losses.getTotalLosses() == 2);
+	assert(losses.getMaxLosses() == 2);
+	for (size_t element(1); element < 8; ++element) { assert(losses.getLosses(element) == 0); }
+	assert(Test::eq(losses.getTime(), 600 * GLOBALS::DT));
+	assert(Test::eq(losses.getLossRate(0), 2 / losses.getTime()));
+
+	// Outwards: outermost radial bin, angle a bit above 0. Upwards: central radial bin, angle pi/2
+	vector<uint64_t> radial(losses.getRadialHistogram(0));
+	vector<uint64_t> azimuthal(losses.getAzimuthalHistogram(0));
+	assert(radial.size() == GLOBALS::LOSS_BINS);
+	assert(radial[GLOBALS::LOSS_BINS - 1] == 1);
+	assert(radial[GLOBALS::LOSS_BINS / 2] == 1);
+	assert(azimuthal[GLOBALS::LOSS_BINS / 2] == 1);
+	assert(azimuthal[3 * GLOBALS::LOSS_BINS / 4] == 1);
+
+	// One line per Element with losses
+	stringstream dump;
+	losses.write(dump, 600);
+	string line;
+	getline(dump, line);
+	assert(line.rfind("losses,600,", 0) == 0);
+	assert(not getline(dump, line));
+
+	acc.clearLosses();
+	assert(losses.getTotalLosses() == 0);
+	assert(losses.getTime() == 0);
+	assert(losses.getElementCount() == 8);
+
+	acc.clear();
+	assert(losses.getElementCount() == 0);
+
+	return 0;
+}
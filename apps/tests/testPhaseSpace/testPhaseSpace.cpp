@@ -0,0 +1,117 @@
+#include "globals.h"
+#include "exceptions.h"
+#include "include/bundle/Vector3D.bundle.h"
+#include "include/bundle/Particle.bundle.h"
+#include "include/bundle/Dipole.bundle.h"
+#include "include/bundle/Beam.bundle.h"
+#include "include/bundle/PhaseSpaceDistribution.bundle.h"
+#include "include/bundle/Test.bundle.h"
+
+using namespace std;
+
+// Relative difference below `tolerance`
+bool similar(double a, double b, double tolerance) {
+	return abs(a - b) <= tolerance * max(abs(a), abs(b));
+}
+
+int main() {
+	/****************************************************************
+	 * Philox (known answers of the reference implementation)
+	 ****************************************************************/
+
+	Philox zero(0);
+	assert((zero(Philox::Block({ 0, 0, 0, 0 })) == Philox::Block({ 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 })));
+
+	Philox pi(0x299f31d0a4093822);
+	assert((pi(Philox::Block({ 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 })) == Philox::Block({ 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 })));
+
+	for (uint64_t i(0); i < 1000; ++i) {
+		for (double u : Philox::uniforms(zero(i, 0))) { assert(u > 0 and u < 1); }
+	}
+
+	/****************************************************************
+	 * Distribution
+	 ****************************************************************/
+
+	PhaseSpaceDistribution distribution(DistributionShape::GAUSSIAN, 42);
+	ASSERT_EXCEPTION(distribution.setR(-1, Vector3D(1, 1, 0)), EXCEPTIONS::BAD_EMITTANCE);
+	ASSERT_EXCEPTION(distribution.setR(1, Vector3D(1, 1, 2)), EXCEPTIONS::BAD_ELLIPSE);
+	ASSERT_EXCEPTION(distribution.setTruncation(0.5), EXCEPTIONS::BAD_TRUNCATION);
+
+	// Coefficients as returned by Beam::getEllipsePhaseCoefR(): A11, A22, A12 with A11 * A22 - A12² = 1
+	double const emittanceR(50);
+	Vector3D const coefR(1e8, 2e-8, 1);
+	double const emittanceZ(100);
+	Vector3D const coefZ(2e8, 1e-8, 1);
+
+	distribution.setR(emittanceR, coefR);
+	distribution.setZ(emittanceZ, coefZ);
+	distribution.setEnergySpread(1e-3);
+
+	// Reproducible, in any order
+	PhaseSpaceSample first(distribution.sample(12345));
+	distribution.sample(0);
+	assert(distribution.sample(12345).vz == first.vz);
+
+	for (DistributionShape shape : { DistributionShape::GAUSSIAN, DistributionShape::WATERBAG }) {
+		PhaseSpaceDistribution matched(shape, 7);
+		matched.setR(emittanceR, coefR);
+		matched.setZ(emittanceZ, coefZ);
+		matched.setEnergySpread(1e-3);
+
+		size_t const count(100000);
+		double r2(0), vr2(0), rvr(0), energy2(0);
+		for (size_t i(0); i < count; ++i) {
+			PhaseSpaceSample sample(matched.sample(i));
+			r2 += sample.r * sample.r;
+			vr2 += sample.vr * sample.vr;
+			rvr += sample.r * sample.vr;
+			energy2 += (sample.energyFactor - 1) * (sample.energyFactor - 1);
+		}
+		r2 /= count;
+		vr2 /= count;
+		rvr /= count;
+		energy2 /= count;
+
+		// Second moments of the ellipse, within the statistical error
+		assert(similar(r2, coefR.getY() * emittanceR, 0.02));
+		assert(similar(vr2, coefR.getX() * emittanceR, 0.02));
+		assert(similar(rvr, - coefR.getZ() * emittanceR, 0.03));
+		assert(similar(sqrt(r2 * vr2 - rvr * rvr), emittanceR, 0.02));
+		assert(similar(sqrt(energy2), 1e-3, 0.02));
+	}
+
+	/****************************************************************
+	 * Beam
+	 ****************************************************************/
+
+	Accelerator acc;
+	Dipole dipole_1(Vector3D(1, 0, 0), Vector3D(0, -1, 0), 0.1, 1, 7);
+	acc.addElement(dipole_1);
+	acc.addElement(Dipole(Vector3D(0, -1, 0), Vector3D(-1, 0, 0), 0.1, 1, 7));
+	acc.addElement(Dipole(Vector3D(-1, 0, 0), Vector3D(0, 1, 0), 0.1, 1, 7));
+	acc.addElement(Dipole(Vector3D(0, 1, 0), Vector3D(1, 0, 0), 0.1, 1, 7));
+	acc.closeElementLoop();
+
+	Proton proton(Vector3D(1, 0, 0), 2, Vector3D(0, -1, 0));
+	size_t const count(2 * GLOBALS::PARALLEL_GRAIN + 1);
+
+	Beam serial(proton, count, 1, distribution, acc);
+
+	ThreadPool pool(3);
+	acc.setThreadPool(&pool);
+	Beam parallel(proton, count, 1, distribution, acc);
+
+	// Same Beam whatever the number of threads
+	for (size_t i(0); i < count; ++i) { assert(serial.getPos(i) == parallel.getPos(i)); }
+
+	// The vertical plane is measured around the ideal trajectory (z = 0)
+	assert(similar(parallel.getEmittanceZ(), emittanceZ, 0.05));
+	Vector3D coef(parallel.getEllipsePhaseCoefZ());
+	assert(similar(coef.getX(), coefZ.getX(), 0.05));
+	assert(similar(coef.getY(), coefZ.getY(), 0.05));
+
+	acc.addBeam(proton, count, 1, distribution);
+
+	return 0;
+}
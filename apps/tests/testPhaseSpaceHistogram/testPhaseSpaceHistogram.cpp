@@ -0,0 +1,121 @@
+#include "globals.h"
+#include "exceptions.h"
+#include "include/bundle/Vector3D.bundle.h"
+#include "include/bundle/Particle.bundle.h"
+#include "include/bundle/Dipole.bundle.h"
+#include "include/bundle/Accelerator.bundle.h"
+#include "include/bundle/PhaseSpaceDistribution.bundle.h"
+#include "include/bundle/PhaseSpaceHistogram.bundle.h"
+#include "include/bundle/Test.bundle.h"
+
+#include <numeric>
+
+using namespace std;
+
+// Relative difference below `tolerance`
+bool similar(double a, double b, double tolerance) {
+	return abs(a - b) <= tolerance * max(abs(a), abs(b));
+}
+
+int main() {
+	Accelerator acc;
+	acc.addElement(Dipole(Vector3D(1, 0, 0), Vector3D(0, -1, 0), 0.1, 1, 7));
+	acc.addElement(Dipole(Vector3D(0, -1, 0), Vector3D(-1, 0, 0), 0.1, 1, 7));
+	acc.addElement(Dipole(Vector3D(-1, 0, 0), Vector3D(0, 1, 0), 0.1, 1, 7));
+	acc.addElement(Dipole(Vector3D(0, 1, 0), Vector3D(1, 0, 0), 0.1, 1, 7));
+	acc.closeElementLoop();
+
+	PhaseSpaceDistribution distribution(DistributionShape::GAUSSIAN, 42);
+	distribution.setR(50, Vector3D(1e8, 2e-8, 1));
+	distribution.setZ(100, Vector3D(2e8, 1e-8, 1));
+	size_t const count(10000);
+	acc.addBeam(Proton(Vector3D(1, 0, 0), 2, Vector3D(0, -1, 0)), count, 1, distribution);
+	Beam const& beam(acc.getBeam(0));
+
+	/****************************************************************
+	 * Phase space coordinates
+	 ****************************************************************/
+
+	// Same projection as the emittances
+	double r2(0), vr2(0), rvr(0), z2(0), vz2(0), zvz(0);
+	for (size_t i(0); i < count; ++i) {
+		Vector3D phaseR(beam.getPhaseR(i)), phaseZ(beam.getPhaseZ(i));
+		r2 += phaseR.getX() * phaseR.getX();
+		vr2 += phaseR.getY() * phaseR.getY();
+		rvr += phaseR.getX() * phaseR.getY();
+		z2 += phaseZ.getX() * phaseZ.getX();
+		vz2 += phaseZ.getY() * phaseZ.getY();
+		zvz += phaseZ.getX() * phaseZ.getY();
+	}
+	assert(similar(sqrt(r2 * vr2 - rvr * rvr) / count, beam.getEmittanceR(), 1e-9));
+	assert(similar(sqrt(z2 * vz2 - zvz * zvz) / count, beam.getEmittanceZ(), 1e-9));
+	ASSERT_EXCEPTION(beam.getPhaseR(count), EXCEPTIONS::NO_PARTICLES);
+
+	/****************************************************************
+	 * Histogram
+	 ****************************************************************/
+
+	ASSERT_EXCEPTION(PhaseSpaceHistogram(0), EXCEPTIONS::BAD_HISTOGRAM);
+	ASSERT_EXCEPTION(PhaseSpaceHistogram(16, 0), EXCEPTIONS::BAD_HISTOGRAM);
+
+	// 4 updates per pass, the first pass only measuring the bounds
+	PhaseSpaceHistogram histogram(32, 2500);
+	for (size_t i(0); i < 4; ++i) { assert(not histogram.update(beam)); }
+	assert(histogram.getPassCount() == 0);
+	for (size_t i(0); i < 3; ++i) { assert(not histogram.update(beam)); }
+	assert(histogram.update(beam));
+	assert(histogram.getPassCount() == 1);
+
+	for (PhasePlane plane : { PhasePlane::R, PhasePlane::Z }) {
+		vector<uint32_t> const& counts(histogram.getCounts(plane));
+		assert(counts.size() == 32 * 32);
+		// Every Particle once
+		assert(accumulate(counts.begin(), counts.end(), size_t(0)) == count);
+		// Gaussian: fuller in the middle than on the edges
+		assert(counts[16 * 32 + 16] > counts[0] and counts[16 * 32 + 16] > counts[32 * 32 - 1]);
+
+		vector<uint8_t> const& image(histogram.getImage(plane));
+		assert(*max_element(image.begin(), image.end()) == 255);
+		assert(image[0] == 0 or counts[0] > 0);
+
+		PhaseRange const& range(histogram.getRange(plane));
+		assert(range.min < range.max and range.speedMin < range.speedMax);
+	}
+
+	// Bounds of the measured Particles
+	PhaseRange const& rangeR(histogram.getRange(PhasePlane::R));
+	for (size_t i(0); i < count; ++i) {
+		Vector3D phaseR(beam.getPhaseR(i));
+		assert(phaseR.getX() > rangeR.min and phaseR.getX() < rangeR.max);
+		assert(phaseR.getY() > rangeR.speedMin and phaseR.getY() < rangeR.speedMax);
+	}
+
+	// The Particles moved by the Beam between two updates are binned once all the same
+	PhaseSpaceHistogram still(32, 2500), moved(32, 2500);
+	for (size_t i(0); i < 8; ++i) { still.update(beam); }
+	vector<ParticleRecord> records;
+	for (size_t i(0); i < 8; ++i) {
+		moved.update(beam);
+		if (i % 2 == 0) {
+			// Swapped with the last ones on removal, then appended
+			records.clear();
+			acc.extractParticles(records, [](ParticleRecord const& record) { return record.id % 3 == 0; });
+			acc.insertParticles(records);
+			assert(beam.getParticleCount() == count and beam.getParticleId(0) != 0);
+		} else {
+			acc.reorderParticles();
+			assert(beam.getParticleId(0) == 0);
+		}
+	}
+	assert(moved.getPassCount() == 1);
+	for (PhasePlane plane : { PhasePlane::R, PhasePlane::Z }) {
+		assert(moved.getCounts(plane) == still.getCounts(plane));
+	}
+
+	// New Beam
+	histogram.reset();
+	assert(histogram.getCounts(PhasePlane::Z)[16 * 32 + 16] == 0);
+	for (size_t i(0); i < 4; ++i) { assert(not histogram.update(beam)); }
+
+	return 0;
+}
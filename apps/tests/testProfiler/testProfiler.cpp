@@ -0,0 +1,147 @@
+#include "globals.h"
+#include "exceptions.h"
+#include "include/bundle/Vector3D.bundle.h"
+#include "include/bundle/Particle.bundle.h"
+#include "include/bundle/Dipole.bundle.h"
+#include "include/bundle/Accelerator.bundle.h"
+#include "include/bundle/Profiler.bundle.h"
+#include "include/bundle/Benchmark.bundle.h"
+#include "include/bundle/Test.bundle.h"
+
+#include <sstream>
+#include <thread>
+
+using namespace std;
+
+// Number of occurences of `pattern` in `text`
+size_t occurences(string const& text, string const& pattern) {
+	size_t count(0);
+	for (size_t pos(text.find(pattern)); pos != string::npos; pos = text.find(pattern, pos + 1)) { ++count; }
+	return count;
+}
+
+int main() {
+	/****************************************************************
+	 * Profiler
+	 ****************************************************************/
+
+	Profiler profiler;
+
+	int64_t start(Profiler::now());
+	profiler.record(ProfilerPhase::PARTICLE_STEP, start, start + 1500);
+	profiler.record(ProfilerPhase::PARTICLE_STEP, start + 2000, start + 2500);
+	profiler.count(ProfilerCounter::PARTICLES_LOST, 3);
+	profiler.count(ProfilerCounter::PARTICLES_LOST);
+	profiler.sample();
+
+	assert(Test::eq(profiler.getTotalTime(ProfilerPhase::PARTICLE_STEP), 2e-6));
+	assert(profiler.getCallCount(ProfilerPhase::PARTICLE_STEP) == 2);
+	assert(profiler.getCallCount(ProfilerPhase::BEAM_STEP) == 0);
+	assert(profiler.getCount(ProfilerCounter::PARTICLES_LOST) == 4);
+	assert(Profiler::now() >= start);
+
+	// 2 complete events and 1 counter event per counter
+	stringstream trace;
+	profiler.writeTrace(trace);
+	assert(trace.str().find("{\"traceEvents\":[") == 0);
+	assert(occurences(trace.str(), "\"ph\":\"X\"") == 2);
+	assert(occurences(trace.str(), "\"ph\":\"C\"") == size_t(ProfilerCounter::COUNT));
+	assert(occurences(trace.str(), "\"dur\":1.500") == 1);
+	assert(occurences(trace.str(), "\"name\":\"particles lost\",\"ph\":\"C\"") == 1);
+	assert(occurences(trace.str(), "\"value\":4}") == 1);
+
+	// Only the last events are kept in the trace
+	for (size_t i(0); i < GLOBALS::PROFILER_EVENTS; ++i) { profiler.record(ProfilerPhase::BEAM_STEP, start, start); }
+	assert(profiler.getDroppedEvents() == 3);
+	trace.str("");
+	profiler.writeTrace(trace);
+	assert(occurences(trace.str(), "\"ph\":\"X\"") == GLOBALS::PROFILER_EVENTS);
+	assert(occurences(trace.str(), "\"dur\":1.500") == 0);
+
+	profiler.reset();
+	assert(profiler.getCallCount(ProfilerPhase::BEAM_STEP) == 0);
+	assert(profiler.getCount(ProfilerCounter::PARTICLES_LOST) == 0);
+
+	{
+		ProfilerScope scope(ProfilerPhase::CLEAR_DEAD_BEAMS);
+	}
+	assert(Profiler::local().getCallCount(ProfilerPhase::CLEAR_DEAD_BEAMS) == 1);
+
+	// One profiler per thread
+	thread([]() { assert(Profiler::local().getCallCount(ProfilerPhase::CLEAR_DEAD_BEAMS) == 0); }).join();
+
+	/****************************************************************
+	 * Hardware counters (not available everywhere, e.g. in containers)
+	 ****************************************************************/
+
+	PerfCounters counters;
+	PerfSample before(counters.read());
+	PerfSample after(counters.read());
+	for (size_t event(0); event < size_t(PerfEvent::COUNT); ++event) {
+		if (not counters.isAvailable(PerfEvent(event))) { assert(after[event] == 0); }
+		assert(PerfCounters::difference(before, after)[event] == (after[event] > before[event] ? after[event] - before[event] : 0));
+	}
+	assert(counters.isAvailable() == Profiler::local().enableHardwareCounters());
+	Profiler::local().disableHardwareCounters();
+	assert(not Profiler::local().hasHardwareCounters());
+
+	/****************************************************************
+	 * Instrumented simulation
+	 ****************************************************************/
+
+	Accelerator acc;
+	acc.addElement(Dipole(Vector3D(1, 0, 0), Vector3D(0, -1, 0), 0.1, 1, 7));
+	acc.addElement(Dipole(Vector3D(0, -1, 0), Vector3D(-1, 0, 0), 0.1, 1, 7));
+	acc.addElement(Dipole(Vector3D(-1, 0, 0), Vector3D(0, 1, 0), 0.1, 1, 7));
+	acc.addElement(Dipole(Vector3D(0, 1, 0), Vector3D(1, 0, 0), 0.1, 1, 7));
+	acc.closeElementLoop();
+	acc.addBeam(Proton(Vector3D(1, 0, 0), 2, Vector3D(0, -1, 0)), 2000, 1);
+
+	Profiler::local().reset();
+	size_t const steps(10);
+	for (size_t i(0); i < steps; ++i) { acc.step(); }
+
+	if (Profiler::ENABLED) {
+		Profiler const& local(Profiler::local());
+		assert(local.getCallCount(ProfilerPhase::ACCELERATOR_STEP) == steps);
+		assert(local.getCallCount(ProfilerPhase::INTERACTIONS) == steps);
+		assert(local.getCallCount(ProfilerPhase::BEAM_STEP) == steps);
+		assert(local.getCallCount(ProfilerPhase::CLEAR_DEAD_BEAMS) == steps);
+		assert(local.getCount(ProfilerCounter::INTERACTION_PAIRS) > 0);
+		// The phases are nested in the step
+		assert(local.getTotalTime(ProfilerPhase::BEAM_STEP) <= local.getTotalTime(ProfilerPhase::ACCELERATOR_STEP));
+	} else {
+		// Compiled out
+		assert(Profiler::local().getCallCount(ProfilerPhase::ACCELERATOR_STEP) == 0);
+	}
+
+	/****************************************************************
+	 * Benchmark
+	 ****************************************************************/
+
+	size_t particleCount(acc.getParticleCount());
+	BenchmarkResult result(Benchmark::run("ring", acc, 3, 1));
+	assert(result.particleSteps <= 3 * particleCount and result.particleSteps > 0);
+	assert(result.seconds > 0);
+
+	stringstream report;
+	Benchmark::reportHeader(report);
+	Benchmark::report(report, result);
+	assert(occurences(report.str(), "ring") == 1);
+	if (not counters.isAvailable()) { assert(occurences(report.str(), "n/a") > 0); }
+
+	// Baseline files
+	stringstream file;
+	Benchmark::writeBaseline(file, { BenchmarkBaseline({ "ring", 1.5e6, 0 }), BenchmarkBaseline({ "beams", 2e5, 0.5 }) }, 0.25);
+	double tolerance(0);
+	vector<BenchmarkBaseline> baselines(Benchmark::readBaseline(file, tolerance));
+	assert(tolerance == 0.25);
+	assert(baselines.size() == 2);
+	assert(baselines[0].name == "ring" and baselines[0].particleStepsPerSecond == 1.5e6);
+	assert(baselines[1].name == "beams" and baselines[1].allocationsPerStep == 0.5);
+
+	stringstream broken("{ \"tolerance\": 0.2, \"scenarios\": [ { \"name\": \"ring\", \"particleStepsPerSecond\": fast } ] }");
+	ASSERT_EXCEPTION(Benchmark::readBaseline(broken, tolerance), EXCEPTIONS::BAD_BASELINE);
+
+	return 0;
+}
@@ -10,9 +10,20 @@
 #include "include/bundle/Test.bundle.h"
 
 #include <iostream>
+#include <sstream>
 
 using namespace std;
 
+// Number of lines of `text` starting with `prefix`
+size_t lines(string const& text, string const& prefix) {
+	size_t count(0);
+	stringstream stream(text);
+	for (string line; getline(stream, line);) {
+		if (line.compare(0, prefix.size(), prefix) == 0) { ++count; }
+	}
+	return count;
+}
+
 int main() {
 	// Default engine
 	// TextRenderer engine;
@@ -48,5 +59,108 @@ int main() {
 	// Log to terminal
 	// acc.draw(&engine);
 
+	/****************************************************************
+	 * Machine-oriented formats
+	 ****************************************************************/
+
+	Proton proton(Vector3D(1.00984, -0.191837, 0), 2, Vector3D(-210200, -2.64754e+08, 0));
+
+	// Nothing reaches the stream before a flush
+	stringstream csv;
+	{
+		TextRenderer engineCSV(&csv, TextFormat::CSV);
+		assert(engineCSV.getFormat() == TextFormat::CSV);
+		Accelerator accCSV(&engineCSV);
+		accCSV.addElement(D1);
+		accCSV.addElement(S1);
+		accCSV.addElement(Q1);
+		accCSV.addParticle(P1);
+		accCSV.addParticle(proton);
+		accCSV.draw();
+		engineCSV.draw(proton);
+		engineCSV.draw(Vector3D(1, 2.5, -3));
+		assert(csv.str().empty());
+		engineCSV.flush();
+	}
+
+	string text(csv.str());
+	assert(text.find('\033') == string::npos);
+	assert(lines(text, "accelerator,2,2") == 1);
+	assert(lines(text, "dipole,0,1,0,0,0,-1,0,0.1,1,7") == 1);
+	assert(lines(text, "straight,1,") == 1);
+	assert(lines(text, "quadrupole,2,") == 1);
+	assert(lines(text, "beam,1,") == 2);
+	assert(lines(text, "particle,particle,") == 1);
+	assert(lines(text, "particle,proton,1.00984,-0.191837,0,") == 2);
+	assert(lines(text, "vector,1,2.5,-3") == 1);
+
+	// An Accelerator without renderer, and one with another renderer, are drawn through the TextRenderer
+	stringstream bare, other;
+	{
+		TextRenderer engineBare(&bare, TextFormat::CSV);
+		TextRenderer engineOther(&other, TextFormat::CSV);
+		Accelerator accBare;
+		accBare.addElement(D1);
+		accBare.addElement(S1);
+		accBare.addElement(Q1);
+		accBare.addParticle(proton);
+		Accelerator accOther(&engineOther);
+		accOther.addElement(D1);
+		accOther.addElement(S1);
+		accOther.addElement(Q1);
+		accOther.addParticle(proton);
+		engineBare.draw(accBare);
+		engineBare.draw(accOther);
+		ASSERT_EXCEPTION(accBare.drawElements(), EXCEPTIONS::NULLPTR);
+		ASSERT_EXCEPTION(accBare.drawBeams(), EXCEPTIONS::NULLPTR);
+	}
+	assert(lines(bare.str(), "accelerator,1,1") == 2);
+	assert(lines(bare.str(), "dipole,0,") == 2);
+	assert(lines(bare.str(), "quadrupole,2,") == 2);
+	assert(lines(bare.str(), "beam,1,") == 2);
+	assert(lines(bare.str(), "particle,proton,1.00984,-0.191837,0,") == 2);
+	assert(other.str().empty());
+
+	// JSON lines, written on destruction
+	stringstream jsonl;
+	{
+		TextRenderer engineJSON(&jsonl, TextFormat::JSONL);
+		engineJSON.draw(Q1);
+		engineJSON.draw(proton);
+	}
+	assert(lines(jsonl.str(), "{\"type\":\"quadrupole\",\"index\":") == 1);
+	assert(jsonl.str().find("\"b\":1.2}") != string::npos);
+	assert(lines(jsonl.str(), "{\"type\":\"particle\",\"kind\":\"proton\",\"x\":1.00984,") == 1);
+	assert(jsonl.str().find("\"charge\":1}") != string::npos);
+
+	// The Elements out of any Accelerator have no index
+	stringstream unlinked;
+	{
+		TextRenderer engineCSV(&unlinked, TextFormat::CSV);
+		TextRenderer engineJSON(&unlinked, TextFormat::JSONL);
+		Straight S2(Vector3D(0, -1, 0), Vector3D(-1, -1, 0), 0.1);
+		engineCSV.draw(S2);
+		engineCSV.flush();
+		engineJSON.draw(S2);
+	}
+	assert(lines(unlinked.str(), "straight,,0,-1,0,-1,-1,0,0.1") == 1);
+	assert(lines(unlinked.str(), "{\"type\":\"straight\",\"index\":null,\"xIn\":0,") == 1);
+
+	// More records than the buffer holds
+	stringstream large;
+	{
+		TextRenderer engineLarge(&large, TextFormat::CSV);
+		for (size_t i(0); i < GLOBALS::TEXT_BUFFER / 16; ++i) { engineLarge.draw(Vector3D(i, 0, 0)); }
+		assert(not large.str().empty());
+	}
+	assert(lines(large.str(), "vector,") == GLOBALS::TEXT_BUFFER / 16);
+	assert(lines(large.str(), "vector,4242,0,0") == 1);
+
+	// The Particle subclasses are drawn as Particles
+	stringstream human;
+	TextRenderer engineHuman(&human);
+	engineHuman.draw(proton);
+	assert(not human.str().empty());
+
 	return 0;
 }
@@ -0,0 +1,157 @@
+#include "globals.h"
+#include "exceptions.h"
+#include "include/bundle/Vector3D.bundle.h"
+#include "include/bundle/Particle.bundle.h"
+#include "include/bundle/Accelerator.bundle.h"
+#include "include/bundle/Sweep.bundle.h"
+#include "include/bundle/LatticeTemplate.bundle.h"
+#include "include/bundle/Shard.bundle.h"
+#include "include/bundle/SharedMemoryCommunicator.bundle.h"
+#include "include/bundle/Test.bundle.h"
+
+using namespace std;
+
+int main() {
+	/****************************************************************
+	 * Records
+	 ****************************************************************/
+
+	AntiProton proton(Vector3D(2.99, 1.1, 0), 2, Vector3D(0, -2.64754e+08, 0));
+	ParticleRecord record(proton.toRecord());
+	assert(record.kind == ParticleKind::ANTIPROTON);
+
+	unique_ptr<Particle> copy(Particle::fromRecord(record));
+	assert(copy->getKind() == ParticleKind::ANTIPROTON);
+	assert(copy->getPos() == proton.getPos());
+	assert(copy->getSpeed() == proton.getSpeed());
+	assert(Test::eq(copy->getMass(), proton.getMass()));
+	assert(copy->getChargeNumber() == proton.getChargeNumber());
+
+	record.kind = ParticleKind::ELECTRON;
+	assert(Particle::fromRecord(record)->getKind() == ParticleKind::ELECTRON);
+
+	/****************************************************************
+	 * Export and import
+	 ****************************************************************/
+
+	LatticeTemplate lattice;
+
+	Vector3D pos_dep(3, 2, 0);
+	Vector3D dir_frodo(0, -1, 0);
+	Vector3D pos_fin;
+	Vector3D dir_dipole(-1, -1, 0);
+
+	for (int i = 0; i < 4; ++i) {
+		pos_fin = pos_dep + 4 * dir_frodo;
+		lattice.addFrodo(pos_dep, pos_fin, 0.1);
+		pos_dep = pos_fin;
+		pos_fin += dir_dipole;
+		lattice.addDipole(pos_dep, pos_fin, 0.1, 1);
+		pos_dep = pos_fin;
+		dir_frodo ^= Vector3D(0, 0, 1);
+		dir_dipole ^= Vector3D(0, 0, 1);
+	}
+
+	// Dense enough for the neighbours to interact
+	lattice.addBeam(Proton(Vector3D(2.99, 1.1, 0), 2, Vector3D(0, -2.64754e+08, 0)), 1500, 1);
+	lattice.compile();
+
+	SweepPoint nominal{ 1.2, 1, 5.89158, 2 };
+	unique_ptr<Accelerator> acc(lattice.instantiate(nominal));
+	acc->updateProgresses();
+
+	vector<ParticleRecord> records;
+	acc->extractParticles(records, [](ParticleRecord const& r) { return r.progress < 0.5; });
+	assert(not records.empty());
+	assert(records.size() + acc->getParticleCount() == 1500);
+	for (ParticleRecord const& r : records) { assert(r.beam == 0 and r.progress < 0.5); }
+
+	acc->insertParticles(records);
+	assert(acc->getParticleCount() == 1500);
+	assert(acc->getBeamCount() == 1);
+
+	// Every Particle leaves: the Beam dies, then comes back with its id
+	records.clear();
+	acc->extractParticles(records, nullptr);
+	assert(acc->getBeamCount() == 0);
+	acc->insertParticles(records);
+	assert(acc->getBeamCount() == 1);
+	records.clear();
+	acc->exportParticles(records);
+	for (ParticleRecord const& r : records) { assert(r.beam == 0); }
+
+	/****************************************************************
+	 * Communicator
+	 ****************************************************************/
+
+	SharedMemoryCommunicator single(1, 4);
+	assert(single.getSize() == 1 and single.getRank() == 0);
+	vector<vector<ParticleRecord>> outgoing(1, vector<ParticleRecord>(5, record));
+	vector<ParticleRecord> incoming;
+	ASSERT_EXCEPTION(single.exchange(outgoing, incoming), EXCEPTIONS::MAILBOX_OVERFLOW);
+	outgoing.push_back({});
+	ASSERT_EXCEPTION(single.exchange(outgoing, incoming), EXCEPTIONS::BAD_EXCHANGE);
+
+	/****************************************************************
+	 * Sharded run against a serial run
+	 ****************************************************************/
+
+	size_t const steps(100);
+
+	unique_ptr<Accelerator> serial(lattice.instantiate(nominal));
+	for (size_t i(0); i < steps; ++i) { serial->step(); }
+	serial->updateProgresses();
+	vector<ParticleRecord> expected;
+	serial->exportParticles(expected);
+
+	for (size_t workers : { 1, 2, 3 }) {
+		unique_ptr<Accelerator> sharded(lattice.instantiate(nominal));
+		SharedMemoryCommunicator comm(workers);
+		vector<ParticleRecord> result;
+		size_t count(0);
+
+		bool success(comm.run([&](Communicator & worker) {
+			Shard shard(*sharded, worker);
+			shard.partition();
+
+			for (size_t i(0); i < steps; ++i) { shard.step(); }
+
+			count = shard.getGlobalParticleCount();
+			result = shard.gather();
+
+			// Only the Particles of the slice are left
+			sharded->updateProgresses();
+			vector<ParticleRecord> local;
+			sharded->exportParticles(local);
+			for (ParticleRecord const& r : local) { assert(shard.getOwner(r.progress) == worker.getRank()); }
+		}));
+
+		assert(success);
+		assert(count == expected.size());
+		assert(result.size() == expected.size());
+
+		// Same Particles, up to the order of the sums of the forces
+		auto closer([](ParticleRecord const& a, ParticleRecord const& b) { return a.progress < b.progress; });
+		sort(result.begin(), result.end(), closer);
+		sort(expected.begin(), expected.end(), closer);
+		for (size_t i(0); i < result.size(); ++i) {
+			for (size_t j(0); j < 3; ++j) {
+				assert(abs(result[i].pos[j] - expected[i].pos[j]) < 1e-9);
+			}
+		}
+	}
+
+	/****************************************************************
+	 * Failing worker
+	 ****************************************************************/
+
+	SharedMemoryCommunicator comm(2);
+	bool success(comm.run([](Communicator & worker) {
+		if (worker.getRank() == 1) { ERROR(EXCEPTIONS::BAD_RANGE); }
+		// Does not wait forever for the worker 1
+		ASSERT_EXCEPTION(worker.barrier(), EXCEPTIONS::WORKER_FAILED);
+	}));
+	assert(not success);
+
+	return 0;
+}
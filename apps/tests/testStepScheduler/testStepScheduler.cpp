@@ -0,0 +1,112 @@
+#include "globals.h"
+#include "exceptions.h"
+#include "include/bundle/Vector3D.bundle.h"
+#include "include/bundle/Particle.bundle.h"
+#include "include/bundle/Dipole.bundle.h"
+#include "include/bundle/Accelerator.bundle.h"
+#include "include/bundle/StepScheduler.bundle.h"
+#include "include/bundle/Test.bundle.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace std;
+
+// Wall time (s) taken by `function`
+template <typename F>
+double measure(F function) {
+	chrono::steady_clock::time_point start(chrono::steady_clock::now());
+	function();
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+	Accelerator acc;
+	acc.addElement(Dipole(Vector3D(1, 0, 0), Vector3D(0, -1, 0), 0.1, 1, 7));
+	acc.addElement(Dipole(Vector3D(0, -1, 0), Vector3D(-1, 0, 0), 0.1, 1, 7));
+	acc.addElement(Dipole(Vector3D(-1, 0, 0), Vector3D(0, 1, 0), 0.1, 1, 7));
+	acc.addElement(Dipole(Vector3D(0, 1, 0), Vector3D(1, 0, 0), 0.1, 1, 7));
+	acc.closeElementLoop();
+	acc.addBeam(Proton(Vector3D(1, 0, 0), 2, Vector3D(0, -1, 0)), 10, 1);
+
+	ASSERT_EXCEPTION(StepScheduler(SteppingMode::FIXED, -1), EXCEPTIONS::BAD_SCHEDULE);
+	ASSERT_EXCEPTION(StepScheduler(SteppingMode::FIXED, 1, -1), EXCEPTIONS::BAD_SCHEDULE);
+	ASSERT_EXCEPTION(StepScheduler(SteppingMode::FIXED, 1, 1, -1), EXCEPTIONS::BAD_SCHEDULE);
+
+	/****************************************************************
+	 * Fixed
+	 ****************************************************************/
+
+	// The fractional steps are carried to the next frames
+	StepScheduler fixed(SteppingMode::FIXED, 1.5);
+	assert(fixed.advance(acc) == 1);
+	assert(fixed.advance(acc) == 2);
+	for (size_t i(0); i < 8; ++i) { fixed.advance(acc); }
+	assert(fixed.getStepCount() == 15);
+	assert(Test::eq(fixed.getSimulatedTime(), 15 * GLOBALS::DT));
+
+	fixed.setStepsPerFrame(0);
+	assert(fixed.advance(acc) == 0);
+
+	/****************************************************************
+	 * Budget
+	 ****************************************************************/
+
+	// The steps of a frame stop once the budget is spent
+	StepScheduler budget(SteppingMode::BUDGET, 1, 0.005);
+	size_t steps(0);
+	double elapsed(measure([&]() { steps = budget.advance(acc, 1e-12); }));
+	assert(steps > 0);
+	assert(elapsed >= 0.005);
+	assert(Test::eq(budget.getSimulatedTime(), steps * 1e-12));
+
+	budget.setBudget(0);
+	assert(budget.advance(acc) == 0);
+
+	/****************************************************************
+	 * Rate
+	 ****************************************************************/
+
+	// The steps follow the wall time elapsed between the frames
+	StepScheduler rate(SteppingMode::RATE, 1, 1, 1000);
+	assert(rate.advance(acc, GLOBALS::DT, 0.01) == 10);
+	assert(rate.advance(acc, GLOBALS::DT, 0.0025) == 2);
+	assert(rate.advance(acc, GLOBALS::DT, 0.0025) == 3);
+
+	// The steps which do not fit in the budget are dropped
+	rate.setBudget(0);
+	assert(rate.advance(acc, GLOBALS::DT, 1) == 0);
+	rate.setBudget(1);
+	assert(rate.advance(acc, GLOBALS::DT, 0.001) == 1);
+
+	// Real frames of 2 ms for 0.1 s give about 100 steps
+	rate.setMode(SteppingMode::RATE);
+	uint64_t before(rate.getStepCount());
+	elapsed = measure([&]() {
+		for (size_t i(0); i < 50; ++i) {
+			rate.advance(acc);
+			this_thread::sleep_for(chrono::milliseconds(2));
+		}
+	});
+	uint64_t done(rate.getStepCount() - before);
+	assert(done <= 1000 * elapsed + 1);
+	assert(done >= 50);
+
+	/****************************************************************
+	 * Modes
+	 ****************************************************************/
+
+	StepScheduler modes;
+	assert(modes.getMode() == SteppingMode::FIXED);
+	modes.nextMode();
+	assert(modes.getMode() == SteppingMode::BUDGET);
+	modes.nextMode();
+	assert(modes.getMode() == SteppingMode::RATE);
+	modes.nextMode();
+	assert(modes.getMode() == SteppingMode::FIXED);
+	assert(string(StepScheduler::getName(SteppingMode::BUDGET)) == "budget");
+	assert(Test::eq(modes.getBudget(), APP::FRAME_BUDGET));
+	assert(Test::eq(modes.getTargetRate(), APP::TARGET_RATE));
+
+	return 0;
+}
@@ -0,0 +1,127 @@
+#include "globals.h"
+#include "exceptions.h"
+#include "include/bundle/Vector3D.bundle.h"
+#include "include/bundle/Particle.bundle.h"
+#include "include/bundle/Accelerator.bundle.h"
+#include "include/bundle/Sweep.bundle.h"
+#include "include/bundle/LatticeTemplate.bundle.h"
+#include "include/bundle/Test.bundle.h"
+
+#include <sstream>
+
+using namespace std;
+
+int main() {
+	/****************************************************************
+	 * Lattice template: the FODO ring of the application
+	 ****************************************************************/
+
+	LatticeTemplate lattice;
+
+	ASSERT_EXCEPTION(lattice.compile(), EXCEPTIONS::EMPTY_TEMPLATE);
+
+	Vector3D pos_dep(3, 2, 0);
+	Vector3D dir_frodo(0, -1, 0);
+	Vector3D pos_fin;
+	Vector3D dir_dipole(-1, -1, 0);
+
+	for (int i = 0; i < 4; ++i) {
+		pos_fin = pos_dep + 4 * dir_frodo;
+		lattice.addFrodo(pos_dep, pos_fin, 0.1);
+		pos_dep = pos_fin;
+		pos_fin += dir_dipole;
+		lattice.addDipole(pos_dep, pos_fin, 0.1, 1);
+		pos_dep = pos_fin;
+		dir_frodo ^= Vector3D(0, 0, 1);
+		dir_dipole ^= Vector3D(0, 0, 1);
+	}
+
+	lattice.addBeam(Proton(Vector3D(2.99, 1.1, 0), 2, Vector3D(0, -2.64754e+08, 0)), 10, 1);
+
+	SweepPoint nominal{ 1.2, 1, 5.89158, 2 };
+	ASSERT_EXCEPTION(lattice.instantiate(nominal), EXCEPTIONS::TEMPLATE_NOT_COMPILED);
+
+	lattice.compile();
+	assert(lattice.isCompiled());
+
+	unique_ptr<Accelerator> acc(lattice.instantiate(nominal));
+	assert(acc->getBeamCount() == 1);
+	assert(acc->getParticleCount() == 10);
+
+	/****************************************************************
+	 * Sampling
+	 ****************************************************************/
+
+	vector<SweepPoint> grid(Sweep::grid({ 1, 1.2, 2 }, { 1, 1, 1 }, { 5, 6, 3 }, { 2, 2, 1 }));
+	assert(grid.size() == 6);
+	assert(Test::eq(grid[0].b, 1) and Test::eq(grid[0].B, 5));
+	assert(Test::eq(grid[5].b, 1.2) and Test::eq(grid[5].B, 6));
+	ASSERT_EXCEPTION(Sweep::grid({ 1, 0, 2 }, { 1, 1, 1 }, { 5, 6, 3 }, { 2, 2, 1 }), EXCEPTIONS::BAD_RANGE);
+
+	SweepPoint min{ 1, 0.5, 5, 1 };
+	SweepPoint max{ 2, 1.5, 7, 3 };
+
+	// Reproducible
+	vector<SweepPoint> random1(Sweep::random(min, max, 20, 42));
+	vector<SweepPoint> random2(Sweep::random(min, max, 20, 42));
+	for (size_t i(0); i < random1.size(); ++i) {
+		assert(random1[i].B == random2[i].B);
+		assert(random1[i].B >= min.B and random1[i].B <= max.B);
+	}
+
+	// One sample per stratum
+	size_t const count(10);
+	vector<SweepPoint> hypercube(Sweep::latinHypercube(min, max, count, 7));
+	vector<bool> visited(count, false);
+	for (SweepPoint const& point : hypercube) {
+		size_t stratum((point.energy - min.energy) / (max.energy - min.energy) * count);
+		assert(not visited[stratum]);
+		visited[stratum] = true;
+	}
+
+	/****************************************************************
+	 * Runs
+	 ****************************************************************/
+
+	ThreadPool pool(4);
+	Sweep sweep(lattice, 3000, pool);
+
+	vector<SweepPoint> points;
+	points.push_back(nominal);
+	// No field in the dipoles: every particle hits the wall
+	points.push_back(SweepPoint{ 1.2, 1, 0, 2 });
+	// Straight sections longer than the Frodo: invalid
+	points.push_back(SweepPoint{ 1.2, 3, 5.89158, 2 });
+
+	stringstream summary;
+	vector<SweepResult> results(sweep.run(points, &summary));
+	assert(results.size() == 3);
+
+	assert(results[0].index == 0);
+	assert(results[0].error.empty());
+	assert(results[0].initialParticles == 10);
+	assert(results[0].steps == 3000);
+	assert(not results[0].terminatedEarly);
+	assert(results[0].survival > 0 and results[0].survival <= 1);
+
+	assert(results[1].error.empty());
+	assert(results[1].terminatedEarly);
+	assert(results[1].steps < 3000);
+	assert(results[1].finalParticles == 0);
+	assert(Test::eq(results[1].survival, 0));
+
+	assert(not results[2].error.empty());
+
+	// Same result as a run on the calling thread
+	SweepResult single(sweep.runPoint(nominal));
+	assert(single.finalParticles == results[0].finalParticles);
+	assert(Test::eq(single.emittanceGrowthR, results[0].emittanceGrowthR));
+
+	// Header + one record per run
+	size_t lines(0);
+	string line;
+	while (getline(summary, line)) { ++lines; }
+	assert(lines == 4);
+
+	return 0;
+}
@@ -0,0 +1,79 @@
+#include "globals.h"
+#include "exceptions.h"
+#include "include/bundle/ThreadPool.bundle.h"
+#include "include/bundle/Test.bundle.h"
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace std;
+
+int main() {
+	ThreadPool pool(2);
+	assert(pool.getThreadCount() == 2);
+
+	/****************************************************************
+	 * Parallel loop
+	 ****************************************************************/
+
+	size_t const count(5 * GLOBALS::PARALLEL_GRAIN + 3);
+	vector<size_t> values(count, 0);
+	pool.parallelFor(0, count, [&values](size_t begin, size_t end) {
+		for (size_t i(begin); i < end; ++i) { values[i] = i; }
+	});
+	for (size_t i(0); i < count; ++i) { assert(values[i] == i); }
+
+	/****************************************************************
+	 * Nested use: parallel loops inside the tasks of the pool
+	 ****************************************************************/
+
+	// More tasks than workers, each waiting for its own parallel loop: the workers are all busy waiting
+	size_t const taskCount(4);
+	vector<vector<size_t>> nested(taskCount, vector<size_t>(count, 0));
+	ThreadPool::Batch outer;
+	for (size_t task(0); task < taskCount; ++task) {
+		pool.submit(outer, [&pool, &nested, task, count] {
+			pool.parallelFor(0, count, [&nested, task](size_t begin, size_t end) {
+				for (size_t i(begin); i < end; ++i) { nested[task][i] = task + i; }
+			});
+		});
+	}
+	pool.wait(outer);
+	for (size_t task(0); task < taskCount; ++task) {
+		for (size_t i(0); i < count; ++i) { assert(nested[task][i] == task + i); }
+	}
+
+	/****************************************************************
+	 * Independent Batches
+	 ****************************************************************/
+
+	// A parallel loop does not wait for a running task of another Batch, which waits for the loop to be done
+	atomic<bool> loopDone(false);
+	ThreadPool::Batch background;
+	pool.submit(background, [&loopDone] {
+		while (not loopDone) { this_thread::yield(); }
+	});
+	pool.parallelFor(0, count, [&values](size_t begin, size_t end) {
+		for (size_t i(begin); i < end; ++i) { values[i] = 2 * i; }
+	});
+	loopDone = true;
+	pool.wait(background);
+	for (size_t i(0); i < count; ++i) { assert(values[i] == 2 * i); }
+
+	// The exceptions go to the Batch of the task which threw them
+	ThreadPool::Batch failing, passing;
+	pool.submit(failing, [] { throw runtime_error("task"); });
+	pool.submit(passing, [] {});
+	pool.wait(passing);
+	bool thrown(false);
+	try {
+		pool.wait(failing);
+	} catch (runtime_error const&) {
+		thrown = true;
+	}
+	assert(thrown);
+	// The error is only rethrown once
+	pool.wait(failing);
+
+	return 0;
+}
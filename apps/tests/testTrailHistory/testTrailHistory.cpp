@@ -0,0 +1,104 @@
+#include "globals.h"
+#include "exceptions.h"
+#include "include/bundle/Vector3D.bundle.h"
+#include "include/bundle/Particle.bundle.h"
+#include "include/bundle/Dipole.bundle.h"
+#include "include/bundle/Accelerator.bundle.h"
+#include "include/bundle/TrailHistory.bundle.h"
+#include "include/bundle/Test.bundle.h"
+
+using namespace std;
+
+int main() {
+	Accelerator acc;
+	acc.addElement(Dipole(Vector3D(1, 0, 0), Vector3D(0, -1, 0), 0.1, 1, 7));
+	acc.addElement(Dipole(Vector3D(0, -1, 0), Vector3D(-1, 0, 0), 0.1, 1, 7));
+	acc.addElement(Dipole(Vector3D(-1, 0, 0), Vector3D(0, 1, 0), 0.1, 1, 7));
+	acc.addElement(Dipole(Vector3D(0, 1, 0), Vector3D(1, 0, 0), 0.1, 1, 7));
+	acc.closeElementLoop();
+	acc.addBeam(Proton(Vector3D(1, 0, 0), 2, Vector3D(0, -1, 0)), 3, 1);
+	acc.addBeam(AntiProton(Vector3D(1, 0, 0), 2, Vector3D(0, -1, 0)), 2, 1);
+
+	ASSERT_EXCEPTION(TrailHistory(GRAPHICS::TRAIL_MAX_LENGTH + 1), EXCEPTIONS::BAD_TRAIL_LENGTH);
+
+	// Disabled
+	TrailHistory disabled;
+	assert(not disabled.record(acc));
+	assert(disabled.getIndexCount() == 0);
+
+	/****************************************************************
+	 * Ring
+	 ****************************************************************/
+
+	TrailHistory trail(4);
+
+	// The first frame fills the history
+	assert(trail.record(acc));
+	assert(trail.getParticleCount() == 5);
+	assert(trail.getHead() == 0);
+	assert(trail.getPositions().size() == 15);
+	assert(Test::eq(trail.getPositions()[0], acc.getBeam(0).getPos(0).getX()));
+	assert(trail.getIndices().size() == 2 * 4 * 2 * 5);
+	assert(trail.getIndexCount() == 3 * 2 * 5);
+
+	// Nothing moved, nothing recorded
+	assert(not trail.record(acc));
+	assert(trail.getHead() == 0);
+
+	// Every frame advances the head by one slot, the drawn segments never join the newest slot to the oldest one
+	for (size_t frame(1); frame <= 10; ++frame) {
+		acc.step();
+		assert(not trail.record(acc));
+		assert(trail.getHead() == frame % 4);
+
+		size_t first(trail.getFirstIndex());
+		assert(first + trail.getIndexCount() <= trail.getIndices().size());
+		uint32_t newest(uint32_t(trail.getHead() * 5)), oldest(uint32_t(((trail.getHead() + 1) % 4) * 5));
+		for (size_t i(first); i < first + trail.getIndexCount(); i += 2) {
+			assert(not (trail.getIndices()[i] == newest and trail.getIndices()[i + 1] == oldest));
+			assert(trail.getIndices()[i] % 5 == trail.getIndices()[i + 1] % 5);
+		}
+		// The last segment ends in the newest slot
+		assert(trail.getIndices()[first + trail.getIndexCount() - 1] / 5 == trail.getHead());
+	}
+
+	// New length
+	trail.setLength(8);
+	assert(trail.record(acc));
+	assert(trail.getHead() == 0);
+	assert(trail.getIndexCount() == 7 * 2 * 5);
+	trail.setLength(1);
+	assert(trail.record(acc));
+	assert(trail.getIndexCount() == 0);
+
+	/****************************************************************
+	 * Reordered particles
+	 ****************************************************************/
+
+	// The first Particle of the first Beam leaves and comes back at the end: the history is reset
+	vector<ParticleRecord> records;
+	acc.extractParticles(records, [](ParticleRecord const& r) { return r.beam == 0 and r.id == 0; });
+	acc.insertParticles(records);
+	trail.setLength(4);
+	assert(trail.record(acc));
+	assert(acc.getBeam(0).getParticleId(0) != 0);
+
+	// Sorted back in place, the particles keep their slots
+	acc.reorderParticles();
+	assert(acc.getBeam(0).getParticleId(0) == 0);
+	assert(not trail.record(acc));
+	acc.step();
+	assert(not trail.record(acc));
+	assert(trail.getHead() == 1);
+
+	Beam const& beam(acc.getBeam(0));
+	size_t moved(0);
+	while (beam.getParticleId(moved) != records[0].id) { ++moved; }
+	assert(Test::eq(trail.getPositions()[3 * (beam.getParticleCount() - 1)], beam.getPos(moved).getX()));
+
+	// A lost Particle resets the history
+	acc.extractParticles(records, [](ParticleRecord const& r) { return r.beam == 1; });
+	assert(trail.record(acc));
+
+	return 0;
+}
@@ -8,6 +8,11 @@ OBJECTS_DIR += ../build
 MOC_DIR += ../moc
 VPATH += include include/bundle lib shaders
 
+# Instrumentation of the simulation (see Profiler.h): qmake CONFIG+=profiling
+profiling {
+	DEFINES += PROFILING
+}
+
 SOURCES += \
 	# Physics simulation
 	Vector3D.cpp \
@@ -18,11 +23,22 @@ SOURCES += \
 	Frodo.cpp \
 	Dipole.cpp \
 	Accelerator.cpp \
+	ElementIndex.cpp \
 	Beam.cpp \
+	PhaseSpaceDistribution.cpp \
+	PhaseSpaceHistogram.cpp \
+	LossMap.cpp \
+	LatticeTemplate.cpp \
+	Lattice.cpp \
+	Sweep.cpp \
+	Shard.cpp \
 	# Graphics
 	Drawable.cpp \
 	Renderer.cpp \
 	TextRenderer.cpp \
+	Geometry.cpp \
+	Frustum.cpp \
+	TrailHistory.cpp \
 	Camera3D.cpp \
 	Transform3D.cpp \
 	Input.cpp \
@@ -30,7 +46,16 @@ SOURCES += \
 	Window.cpp \
 	# Utility
 	Convert.cpp \
-	Test.cpp
+	Test.cpp \
+	ThreadPool.cpp \
+	Philox.cpp \
+	SharedMemoryCommunicator.cpp \
+	Profiler.cpp \
+	PerfCounters.cpp \
+	Benchmark.cpp \
+	AsyncObserver.cpp \
+	StepScheduler.cpp \
+	Arena.cpp
 
 HEADERS += \
 	# Physics simulation
@@ -42,13 +67,24 @@ HEADERS += \
 	Frodo.h \
 	Dipole.h \
 	Accelerator.h \
+	ElementIndex.h \
 	Beam.h \
+	PhaseSpaceDistribution.h \
+	PhaseSpaceHistogram.h \
+	LossMap.h \
+	LatticeTemplate.h \
+	Lattice.h \
+	Sweep.h \
+	ParticleRecord.h \
+	Shard.h \
 	# Graphics
 	Drawable.h \
 	Renderer.h \
 	TextRenderer.h \
 	Vertex.h \
 	Geometry.h \
+	Frustum.h \
+	TrailHistory.h \
 	Camera3D.h \
 	Transform3D.h \
 	Input.h \
@@ -57,6 +93,17 @@ HEADERS += \
 	# Utility
 	Convert.h \
 	Test.h \
+	ThreadPool.h \
+	Philox.h \
+	Communicator.h \
+	SharedMemoryCommunicator.h \
+	Profiler.h \
+	PerfCounters.h \
+	Benchmark.h \
+	RingBuffer.h \
+	AsyncObserver.h \
+	StepScheduler.h \
+	Arena.h \
 	globals.h \
 	exceptions.h \
 	# Bundles
@@ -69,11 +116,22 @@ HEADERS += \
 	Frodo.bundle.h \
 	Dipole.bundle.h \
 	Accelerator.bundle.h \
+	ElementIndex.bundle.h \
 	Beam.bundle.h \
+	PhaseSpaceDistribution.bundle.h \
+	PhaseSpaceHistogram.bundle.h \
+	LossMap.bundle.h \
+	LatticeTemplate.bundle.h \
+	Lattice.bundle.h \
+	Sweep.bundle.h \
+	Shard.bundle.h \
 	# Graphics
 	Drawable.bundle.h \
 	Renderer.bundle.h \
 	TextRenderer.bundle.h \
+	Geometry.bundle.h \
+	Frustum.bundle.h \
+	TrailHistory.bundle.h \
 	Camera3D.bundle.h \
 	Transform3D.bundle.h \
 	Input.bundle.h \
@@ -81,4 +139,13 @@ HEADERS += \
 	Window.bundle.h \
 	# Utility
 	Convert.bundle.h \
-	Test.bundle.h
+	Test.bundle.h \
+	ThreadPool.bundle.h \
+	Philox.bundle.h \
+	SharedMemoryCommunicator.bundle.h \
+	Profiler.bundle.h \
+	PerfCounters.bundle.h \
+	Benchmark.bundle.h \
+	AsyncObserver.bundle.h \
+	StepScheduler.bundle.h \
+	Arena.bundle.h
@@ -72,6 +72,12 @@ namespace EXCEPTIONS {
 
 	inline constexpr char OUTSIDE_ACCELERATOR[]("The Particle is now outside the accelerator (out of the first / last element)");
 
+	/**
+	 * Class Element : The Elements to link must be in a table of Elements (see Element::linkAccelerator())
+	 */
+
+	inline constexpr char NOT_SAME_LATTICE[]("Only the Elements of a lattice (table of Elements of an Accelerator) can be linked");
+
 	/**
 	 * Class Element : The progress given is not between 0 and 1
 	 */
@@ -119,6 +125,150 @@ namespace EXCEPTIONS {
 	 */
 
 	inline constexpr char FILE_EXCEPTION[]("Something went wrong while opening the file");
+
+	/**
+	 * Class LatticeTemplate : The template does not describe any element or any beam
+	 */
+
+	inline constexpr char EMPTY_TEMPLATE[]("The lattice template needs at least one element and one beam");
+
+	/**
+	 * Class LatticeTemplate : The template is instantiated before being compiled
+	 */
+
+	inline constexpr char TEMPLATE_NOT_COMPILED[]("The lattice template needs to be compiled before being instantiated");
+
+	/**
+	 * Class Sweep : A sampling range is empty or reversed
+	 */
+
+	inline constexpr char BAD_RANGE[]("The sampling range must contain at least one value and its minimum must not exceed its maximum");
+
+	/**
+	 * Class SharedMemoryCommunicator : The shared memory region could not be mapped
+	 */
+
+	inline constexpr char SHARED_MEMORY_FAILED[]("Could not map the shared memory used by the workers");
+
+	/**
+	 * Class SharedMemoryCommunicator : A worker process could not be created
+	 */
+
+	inline constexpr char FORK_FAILED[]("Could not start a worker process");
+
+	/**
+	 * Class SharedMemoryCommunicator : Another worker failed, the collective operation cannot complete
+	 */
+
+	inline constexpr char WORKER_FAILED[]("A worker process failed");
+
+	/**
+	 * Class SharedMemoryCommunicator : More records are sent to a worker than its mailbox can hold
+	 */
+
+	inline constexpr char MAILBOX_OVERFLOW[]("Too many particles sent to a worker in one exchange, increase the mailbox capacity");
+
+	/**
+	 * Class Communicator : The exchange does not provide one list of records per worker
+	 */
+
+	inline constexpr char BAD_EXCHANGE[]("An exchange needs one list of records per worker");
+
+	/**
+	 * Class PhaseSpaceDistribution : Negative emittance or energy spread
+	 */
+
+	inline constexpr char BAD_EMITTANCE[]("The emittance and the energy spread cannot be negative");
+
+	/**
+	 * Class PhaseSpaceDistribution : The coefficients A11, A22, A12 do not describe an ellipse
+	 */
+
+	inline constexpr char BAD_ELLIPSE[]("The ellipse coefficients must satisfy A22 > 0 and A11 * A22 - A12^2 > 0");
+
+	/**
+	 * Class PhaseSpaceDistribution : The gaussian is cut too close to its center
+	 */
+
+	inline constexpr char BAD_TRUNCATION[]("The truncation of the distribution must be at least 1 sigma");
+
+	/**
+	 * Class Benchmark : The baseline file is not in the format written by Benchmark::writeBaseline()
+	 */
+
+	inline constexpr char BAD_BASELINE[]("The benchmark baseline is malformed");
+
+	/**
+	 * Class Accelerator : There is no Beam at the index given
+	 */
+
+	inline constexpr char NO_BEAM[]("There is no Beam at this index in the Accelerator");
+
+	/**
+	 * Class AsyncObserver : The ring buffer needs room for at least one sample
+	 */
+
+	inline constexpr char BAD_CAPACITY[]("The capacity of the observer buffer must be at least 1");
+
+	/**
+	 * Class Lattice : A line of the lattice file is not one of the entries described in Lattice.h
+	 */
+
+	inline constexpr char BAD_LATTICE[]("The lattice file is malformed");
+
+	/**
+	 * Class StepScheduler : Steps per frame, budget and rate cannot be negative
+	 */
+
+	inline constexpr char BAD_SCHEDULE[]("The steps per frame, budget and rate of the scheduler must be positive");
+
+	/**
+	 * Class TrailHistory : The history of the trails is kept in a buffer of bounded size
+	 */
+
+	inline constexpr char BAD_TRAIL_LENGTH[]("The length of the trails must be at most GRAPHICS::TRAIL_MAX_LENGTH");
+
+	/**
+	 * Class PhaseSpaceHistogram : A histogram needs at least one bin, and an update at least one Particle
+	 */
+
+	inline constexpr char BAD_HISTOGRAM[]("The number of bins and the chunk of the phase space histogram must be at least 1");
+
+	/**
+	 * Class Arena : The blocks cannot be empty, and are only aligned for the fundamental types
+	 */
+
+	inline constexpr char BAD_ARENA[]("The blocks of the arena must hold at least 1 byte, with at most the alignment of std::max_align_t");
+
+	/**
+	 * Class Accelerator : An interaction region is a range of arc lengths of the Accelerator
+	 */
+
+	inline constexpr char BAD_INTERACTION_REGION[]("The interaction region must be within the Accelerator");
+
+	/**
+	 * Class Accelerator : The tolerance of the adaptive integration is a distance
+	 */
+
+	inline constexpr char BAD_TOLERANCE[]("The tolerance cannot be negative");
+
+	/**
+	 * Class Accelerator : The adaptive integration steps each Particle on its own, there are no buckets to integrate
+	 */
+
+	inline constexpr char ADAPTIVE_BUCKETED[]("The adaptive integration cannot be bucketed");
+
+	/**
+	 * Class Accelerator : Index of an Element out of bounds
+	 */
+
+	inline constexpr char NO_ELEMENT[]("There is no Element at this index in the Accelerator");
+
+	/**
+	 * Class LossMap : The loss histograms need at least one bin
+	 */
+
+	inline constexpr char BAD_LOSS_MAP[]("The radial and azimuthal loss histograms must have at least 1 bin");
 }
 
 /**
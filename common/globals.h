@@ -35,7 +35,20 @@ namespace GLOBALS {
 	inline constexpr double EPSILON(1e-10); // For double comparaison
 	inline constexpr double DELTA_DIV0(1e-30); // For division by 0 tests
 	inline constexpr double DT(1e-11); // Timestep
+	inline constexpr double DT_MIN(1e-16); // Smallest timestep of the adaptive integration, accepted whatever its error
+	inline constexpr double ADAPTIVE_SAFETY(0.9); // Fraction of the timestep predicted by the error estimate which is used
+	inline constexpr double ADAPTIVE_MAX_GROWTH(4); // Largest factor between two timesteps of the adaptive integration
+	inline constexpr double ADAPTIVE_MIN_SHRINK(0.2); // Smallest factor between two timesteps of the adaptive integration
 	inline constexpr double DELTA_INTERACTION(1e-3); // Difference of progress in which two particles may interact (size of a "case")
+	inline constexpr unsigned int PARALLEL_GRAIN(4096); // Number of items handled by a task in ThreadPool::parallelFor
+	inline constexpr unsigned int MAILBOX_CAPACITY(65536); // Number of ParticleRecords a worker can receive from another one in one exchange
+	inline constexpr unsigned int PROFILER_EVENTS(65536); // Number of timed phases kept by a Profiler for the trace
+	inline constexpr unsigned int CACHE_LINE(64); // Size of a cache line in bytes, to keep the data of different threads apart
+	inline constexpr unsigned int OBSERVER_CAPACITY(65536); // Number of samples an AsyncObserver can hold before its writer thread catches up
+	inline constexpr unsigned int PHASE_SPACE_CHUNK(65536); // Number of Particles binned per frame by a PhaseSpaceHistogram
+	inline constexpr unsigned int TEXT_BUFFER(1 << 20); // Size in bytes of the buffer of the records of a TextRenderer (CSV, JSON lines)
+	inline constexpr unsigned int ARENA_BLOCK(1 << 16); // Size in bytes of the blocks of the Arenas of the Particles and the Elements
+	inline constexpr unsigned int LOSS_BINS(16); // Number of bins of the radial and of the azimuthal loss histograms of each Element
 }
 
 /****************************************************************
@@ -74,6 +87,13 @@ namespace GRAPHICS {
 	inline constexpr double CLOSE_PLANE(0.001);
 	inline constexpr double FAR_PLANE(1000);
 	inline constexpr unsigned int PRECISION(256); // n steps per circle
+	inline constexpr unsigned int LOD_COUNT(3); // Number of levels of detail of the meshes
+	inline constexpr unsigned int LOD_PRECISION[LOD_COUNT] = { PRECISION, PRECISION / 4, PRECISION / 16 }; // n steps per circle of each level of detail
+	inline constexpr double LOD_SIZE[LOD_COUNT - 1] = { 0.2, 0.04 }; // Projected size (fraction of the half height of the view) from which a level of detail is used
+	inline constexpr unsigned int TRAIL_LENGTH(64); // n frames of history behind each particle when the trails are shown
+	inline constexpr unsigned int TRAIL_MAX_LENGTH(1024);
+	inline constexpr unsigned int PHASE_SPACE_BINS(64); // n x n bins of the phase space histograms
+	inline constexpr double PHASE_SPACE_SIZE(0.3); // Side of a phase space histogram, as a fraction of the height of the view
 	inline constexpr unsigned int FRAMEDELTA_UPDATE(1000); // update framerate every n ms
 	inline constexpr double FRAMEDELTA_TARGET(1000/60.0);
 }
@@ -95,6 +115,9 @@ namespace CONTROLS {
 namespace APP {
 	inline constexpr char NAME[]("Particle Accelerator");
 	inline constexpr double KEY_SPEED(0.05);
+	inline constexpr double FRAME_BUDGET(0.008); // s of a frame given to the physics engine in the budgeted modes
+	inline constexpr double TARGET_RATE(1000); // steps per second of the physics engine in the rate mode
+	inline constexpr double TOLERANCE(1e-7); // m, tolerance of the adaptive integration when it is enabled
 }
 
 #endif
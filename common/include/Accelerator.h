@@ -9,6 +9,9 @@
 #include <string>
 #include <sstream>
 #include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <limits>
 
 // Forward declaration
 class Vector3D;
@@ -17,9 +20,15 @@ class Element;
 class Beam;
 class Drawable;
 class Renderer;
+class ThreadPool;
+class PhaseSpaceDistribution;
 
 #include "globals.h"
 #include "exceptions.h"
+#include "include/ParticleRecord.h"
+#include "include/ElementIndex.h"
+#include "include/Arena.h"
+#include "include/LossMap.h"
 
 /**
  * Accelerator
@@ -28,6 +37,16 @@ class Renderer;
 class Accelerator : public Drawable {
 public:
 
+	/****************************************************************
+	 * Constants
+	 ****************************************************************/
+
+	/**
+	 * Returned by Accelerator::getInteractionRegion() outside of the interaction regions
+	 */
+
+	static constexpr size_t NO_INTERACTION_REGION = std::numeric_limits<size_t>::max();
+
 	/****************************************************************
 	 * Constructor
 	 ****************************************************************/
@@ -90,6 +109,180 @@ public:
 
 	bool getBeamFromParticle() const;
 
+	/**
+	 * Returns the ThreadPool used to build the Beams (nullptr if they are built on the calling thread)
+	 */
+
+	ThreadPool * getThreadPool() const;
+
+	/**
+	 * Returns the index answering which Element contains a point
+	 *
+	 * The index is rebuilt here, at the first call after Elements were added, so that adding E Elements one by one only builds it once
+	 */
+
+	ElementIndex const& getElementIndex() const;
+
+	/**
+	 * Returns the table of the tracked Elements, in which the indices of the Elements are resolved (see Element::updatePointedElement())
+	 */
+
+	std::vector<Element *> const& getElements() const;
+
+	/**
+	 * Returns the Elements as added, which are the ones of Accelerator::getElements() unless they were flattened (see Accelerator::flattenElements())
+	 */
+
+	std::vector<Element *> const& getAddedElements() const;
+
+	/**
+	 * Returns where the Particles were lost, since the construction or the last Accelerator::clearLosses()
+	 */
+
+	LossMap const& getLossMap() const;
+
+	/**
+	 * Returns the number of Beams still in the Accelerator
+	 */
+
+	size_t getBeamCount() const;
+
+	/**
+	 * Returns the Beam at index beam (see Accelerator::getBeamCount())
+	 *
+	 * Throws `EXCEPTIONS::NO_BEAM` if there is no such Beam
+	 */
+
+	Beam const& getBeam(size_t beam) const;
+
+	/**
+	 * Returns the id of the Beam at index beam, as in ParticleRecord::beam
+	 *
+	 * Throws `EXCEPTIONS::NO_BEAM` if there is no such Beam
+	 */
+
+	std::uint32_t getBeamId(size_t beam) const;
+
+	/**
+	 * Returns the number of macroparticles still in the Accelerator (all Beams together)
+	 */
+
+	size_t getParticleCount() const;
+
+	/**
+	 * Returns the mean of Beam::getEmittanceR() over the Beams, weighted by their number of macroparticles
+	 *
+	 * Returns 0 if there is no Beam left
+	 */
+
+	double getMeanEmittanceR() const;
+
+	/**
+	 * Returns the mean of Beam::getEmittanceZ() over the Beams, weighted by their number of macroparticles
+	 *
+	 * Returns 0 if there is no Beam left
+	 */
+
+	double getMeanEmittanceZ() const;
+
+	/**
+	 * Returns true if the Particles of a same Beam interact (space charge)
+	 */
+
+	bool getSpaceCharge() const;
+
+	/**
+	 * Returns the number of interaction regions declared (see Accelerator::addInteractionRegion())
+	 */
+
+	size_t getInteractionRegionCount() const;
+
+	/**
+	 * Returns the index of the interaction region containing the progress `progress`, or Accelerator::NO_INTERACTION_REGION
+	 *
+	 * Without any interaction region, the whole ring is the region 0
+	 */
+
+	size_t getInteractionRegion(double progress) const;
+
+	/**
+	 * Returns the tolerance of the adaptive integration (see Accelerator::setTolerance()), 0 with the fixed timestep
+	 */
+
+	double getTolerance() const;
+
+	/**
+	 * Returns true if the Beams integrate their Particles Element by Element (see Accelerator::setBucketed())
+	 */
+
+	bool getBucketed() const;
+
+	/**
+	 * Returns true if the composite Elements are expanded into their sections (see Accelerator::flattenElements())
+	 */
+
+	bool getFlattened() const;
+
+	/**
+	 * Returns the number of steps between two Accelerator::reorderParticles() in Accelerator::step(), 0 if they are never reordered
+	 */
+
+	size_t getReorderInterval() const;
+
+	/**
+	 * Returns the timestep the adaptive integration currently uses in the Element at index `element`
+	 *
+	 * Throws `EXCEPTIONS::NO_ELEMENT` if there is no such Element
+	 */
+
+	double getTimeStep(size_t element) const;
+
+	/****************************************************************
+	 * Setters
+	 ****************************************************************/
+
+	/**
+	 * Enables or disables the interactions between the Particles of a same Beam (enabled by default)
+	 *
+	 * The interactions between different Beams only depend on the interaction regions
+	 */
+
+	void setSpaceCharge(bool spaceCharge);
+
+	/**
+	 * Integrates the movement of the Particles with an adaptive timestep, the error on their position over a timestep
+	 * being kept under `tolerance` (m), or with the fixed timestep of Accelerator::step() if `tolerance` is 0 (the default)
+	 *
+	 * Throws `EXCEPTIONS::BAD_TOLERANCE` if `tolerance` is negative,
+	 * and `EXCEPTIONS::ADAPTIVE_BUCKETED` if `tolerance` is positive while the Accelerator is bucketed (see Accelerator::setBucketed())
+	 */
+
+	void setTolerance(double tolerance);
+
+	/**
+	 * Integrates the Particles Element by Element (see Beam::stepByElement()) instead of in storage order (disabled by default),
+	 * which gives the same trajectories
+	 *
+	 * Only used with the fixed timestep: throws `EXCEPTIONS::ADAPTIVE_BUCKETED` if `bucketed` is true with a tolerance (see Accelerator::setTolerance())
+	 */
+
+	void setBucketed(bool bucketed);
+
+	/**
+	 * Reorders the Particles (see Accelerator::reorderParticles()) at the start of one Accelerator::step() out of `steps`,
+	 * never if `steps` is 0 (the default)
+	 */
+
+	void setReorderInterval(size_t steps);
+
+	/**
+	 * Uses a ThreadPool to build the next Beams (see Beam::Beam())
+	 *
+	 * The pool must outlive the Accelerator, and the Beams must not be added from one of its tasks
+	 */
+
+	void setThreadPool(ThreadPool * threadPool_ptr);
+
 	/****************************************************************
 	 * Methods
 	 ****************************************************************/
@@ -102,6 +295,14 @@ public:
 
 	void addElement(Element const& element);
 
+	/**
+	 * Same as Accelerator::addElement() for each Element of `elements`, in order
+	 *
+	 * As with Accelerator::addElement(), the ElementIndex is only rebuilt by the next search (see Accelerator::getElementIndex())
+	 */
+
+	void addElements(std::vector<std::unique_ptr<Element>> const& elements);
+
 	/**
 	 * Adds a copy of a new Beam created at the moment to the Accelerator
 	 *
@@ -112,6 +313,12 @@ public:
 
 	void addBeam(Particle const& defaultParticle, size_t const& particleCount, double lambda);
 
+	/**
+	 * Same as Accelerator::addBeam(), with the Particles spread around the ideal trajectory following a PhaseSpaceDistribution
+	 */
+
+	void addBeam(Particle const& defaultParticle, size_t const& particleCount, double lambda, PhaseSpaceDistribution const& distribution);
+
 	/**
 	 * Adds a Particle to the Accelerator, transform it into a Beam before storing it
 	 */
@@ -121,11 +328,22 @@ public:
 	/**
 	 * Initialization of a particle by searching which element is the closest
 	 *
+	 * The search uses the ElementIndex of the Accelerator (see Accelerator::getElementIndex())
+	 *
 	 * This method is used in Accelerator::addParticle() and Beam::Beam()
 	 */
 
 	void initParticleToClosestElement(Particle & particle) const;
 
+	/**
+	 * Initialization of a particle placed at a given progress along the ideal trajectory (e.g. by Accelerator::getPosAtProgress()),
+	 * using the arc length table instead of searching through all the Elements
+	 *
+	 * This method is used in Beam::Beam()
+	 */
+
+	void initParticleAtProgress(Particle & particle, double progress) const;
+
 	/**
 	 * Complete the accelerator by linking the first element and the last one
 	 *
@@ -134,6 +352,51 @@ public:
 
 	void closeElementLoop();
 
+	/**
+	 * Flattening pass: replaces the composite Elements (Frodo) of the tracking lattice by their sections (Quadrupole and Straight),
+	 * so that the field on a Particle is a single evaluation in a primitive Element. The Elements added afterwards are expanded too.
+	 *
+	 * The Elements as added stay in the Accelerator for the display (Accelerator::drawElements()) and the string representation.
+	 * The indices of the Elements (Element::getIndex(), Accelerator::addInteractionRegion(size_t), LossMap, ...) become those of the sections,
+	 * while the arc lengths along the ideal trajectory do not change. A composite Element as added takes the index of its first section,
+	 * without next nor previous Element (Element::NO_LINK), whether it was added before or after the pass.
+	 * The Particles already in the Accelerator are moved to the section they are in.
+	 */
+
+	void flattenElements();
+
+	/**
+	 * Declares the arc lengths between `begin` and `end` (m, from the entrance of the first Element) as an interaction region:
+	 * once a region is declared, the Particles of different Beams only interact if both are in the same region
+	 *
+	 * The region goes across the entrance of the first Element if `begin` is greater than `end`.
+	 * The regions should not overlap, a Particle being in the first region containing it.
+	 *
+	 * Throws `EXCEPTIONS::BAD_INTERACTION_REGION` if `begin` or `end` is not in the Accelerator
+	 */
+
+	void addInteractionRegion(double begin, double end);
+
+	/**
+	 * Declares the Element at index `element` as an interaction region
+	 *
+	 * Throws `EXCEPTIONS::BAD_INTERACTION_REGION` if there is no such Element
+	 */
+
+	void addInteractionRegion(size_t element);
+
+	/**
+	 * Forgets the interaction regions: the Particles of different Beams interact everywhere again
+	 */
+
+	void clearInteractionRegions();
+
+	/**
+	 * Forgets the losses counted in the LossMap (see Accelerator::getLossMap())
+	 */
+
+	void clearLosses();
+
 	/**
 	 * Removes all Elements and Beams from the accelerator and DELETE THEM
 	 */
@@ -158,6 +421,12 @@ public:
 
 	Vector3D getVelAtProgress(double progress, bool clockwise) const;
 
+	/**
+	 * Returns a Vector3D containing the horizontal normal direction (see Element::getNormalDirection()) at a certain pourcentage of the Accelerator (between 0 and 1)
+	 */
+
+	Vector3D getNormalAtProgress(double progress) const;
+
 	/**
 	 * Returns the progress of the Particle at position pos w.r.t. the size of a "case", which is GLOBALS::DELTA_INTERACTION.
 	 *
@@ -166,16 +435,81 @@ public:
 
 	double getParticleProgress(Vector3D const& pos) const;
 
+	/**
+	 * Returns the progress of the Particle along the ideal trajectory (between 0 and 1), used for the interactions
+	 *
+	 * Derived from the Element of the Particle and its progress in it (see Particle::getElementProgress()),
+	 * so this does not compute any angle.
+	 */
+
+	double getParticleProgress(Particle const& particle) const;
+
+	/**
+	 * Sorts the Particles of each Beam by position in the ring (see Beam::reorder()), on the ThreadPool of the Accelerator if any
+	 *
+	 * After many steps, the losses (swap + pop_back) and the changes of Element leave the Particles in no particular order,
+	 * and the Particles close in the ring (which interact, and use the same Element) are far apart in memory.
+	 * The ids of the Particles do not change (see Beam::getParticleId()).
+	 */
+
+	void reorderParticles();
+
 	/**
 	 * Simulate the particle accelerator over a timestep `dt`
 	 *
 	 * Make a Particle point to the next Element if it has moved past its current Element
 	 *
+	 * With a tolerance (see Accelerator::setTolerance()), `dt` is the observation interval instead: each Particle
+	 * is integrated with its own timesteps (see Beam::step()), so that all the Beams have advanced by `dt` at the end.
+	 * The interactions are only computed once per interval.
+	 *
 	 * If `dt` is null (aka inferior to GLOBALS::DELTA_DIV0), then this doesn't do anything
 	 */
 
 	void step(double dt = GLOBALS::DT);
 
+	/**
+	 * Makes every Particle point to the Element it is in and recomputes the progresses used for the interactions
+	 *
+	 * Accelerator::step() starts with the same update, which it skips if nothing moved since this call
+	 */
+
+	void updateProgresses();
+
+	/****************************************************************
+	 * Particle exchange (see Shard)
+	 ****************************************************************/
+
+	/**
+	 * Appends to `records` a ParticleRecord of every Particle for which `selected` returns true (every Particle if `selected` is empty)
+	 *
+	 * The progresses are those of the last Accelerator::updateProgresses()
+	 */
+
+	void exportParticles(std::vector<ParticleRecord> & records, std::function<bool(ParticleRecord const&)> const& selected = nullptr) const;
+
+	/**
+	 * Same as Accelerator::exportParticles(), but the selected Particles are removed from the Accelerator
+	 */
+
+	void extractParticles(std::vector<ParticleRecord> & records, std::function<bool(ParticleRecord const&)> const& selected);
+
+	/**
+	 * Adds the Particles described by `records` to the Beams with the same id
+	 *
+	 * A Beam which does not exist anymore in this Accelerator is recreated with a single macroparticle
+	 */
+
+	void insertParticles(std::vector<ParticleRecord> const& records);
+
+	/**
+	 * Exerts on the Particles of the Accelerator the interactions with `ghosts`, copies of Particles simulated elsewhere
+	 *
+	 * Only the Particles of the Accelerator feel the force: the owner of each ghost computes the reaction itself
+	 */
+
+	void exertInteractions(std::vector<ParticleRecord> const& ghosts);
+
 	/**
 	 * Generates a string representation of the accelerator
 	 */
@@ -197,16 +531,16 @@ public:
 	virtual void draw(Renderer * engine_ptr = nullptr) const override;
 
 	/**
-	 * Draw particles only
+	 * Draw particles only, with the renderer in argument if given, else with the renderer of the Accelerator (see Accelerator::draw())
 	 */
 
-	void drawBeams() const;
+	void drawBeams(Renderer * engine_ptr = nullptr) const;
 
 	/**
-	 * Draw elements only
+	 * Draw elements only, with the renderer in argument if given, else with the renderer of the Accelerator (see Accelerator::draw())
 	 */
 
-	void drawElements() const;
+	void drawElements(Renderer * engine_ptr = nullptr) const;
 
 private:
 
@@ -222,6 +556,25 @@ private:
 
 	void clearElements();
 
+	/**
+	 * Appends a copy of an Element (its sections once flattened) and links it to the previous one
+	 */
+
+	void appendElement(Element const& element);
+
+	/**
+	 * Appends an Element of the arena to the tracking lattice and links it to the previous one
+	 */
+
+	void linkElement(Element * element_ptr);
+
+	/**
+	 * Links the sections of an Element of the arena (see Element::appendPrimitives()) to the tracking lattice,
+	 * the Element itself taking the index of its first section
+	 */
+
+	void expandElement(Element * element_ptr);
+
 	/**
 	 * Removes all dead Beams (i.e. containing 0 macroparticles) from the accelerator and DELETE THEM
 	 */
@@ -236,12 +589,37 @@ private:
 
 	double getTotalLength() const;
 
+	/**
+	 * Returns the index of the Element at a certain pourcentage of the Accelerator (between 0 and 1) with a binary search in the arc length table,
+	 * and sets `elementProgress` to the progress inside this Element
+	 */
+
+	size_t getElementIndexAtProgress(double progress, double & elementProgress) const;
+
 	/**
 	 * Exerts the interaction between the first Particle in beam1, part1 and the second Particle in beam2, part2
 	 */
 
 	void exertInteraction(size_t beam1, size_t part1, size_t beam2, size_t part2);
 
+	/**
+	 * Exerts the interactions between the close Particles of each Beam (space charge)
+	 */
+
+	void exertSpaceCharge();
+
+	/**
+	 * Exerts the interactions between the close Particles of different Beams, in the same interaction region
+	 */
+
+	void exertBeamBeam();
+
+	/**
+	 * Returns the record of the Particle part of the Beam beam, with its Beam id, Element index and progress
+	 */
+
+	ParticleRecord getRecord(size_t beam, size_t part) const;
+
 	/****************************************************************
 	 * Attributes
 	 ****************************************************************/
@@ -261,12 +639,69 @@ private:
 	std::vector<std::vector<double>> associatedProgresses;
 
 	/**
-	 * Heterogeneous collection of shared_ptr on Element
+	 * For each Beam, an id which does not change when other Beams die (see ParticleRecord::beam)
+	 */
+
+	std::vector<std::uint32_t> beamIds;
+
+	/**
+	 * Id of the next Beam added to the Accelerator
+	 */
+
+	std::uint32_t nextBeamId;
+
+	/**
+	 * True if no Particle moved since the last Accelerator::updateProgresses()
+	 */
+
+	bool progressesUpToDate;
+
+	/**
+	 * Memory of the Elements: they are bump allocated, and released all at once by Accelerator::clearElements()
+	 */
+
+	Arena elementArena;
+
+	/**
+	 * Heterogeneous collection of pointers on the Elements as added, owned by the Accelerator and constructed in elementArena
 	 *
-	 * We chose std::shared_ptr because the Accelerator will NOT be the only object to point on elements (elements are pointing to each other) so we cannot use std::unique_ptr here, and the intelligent pointers are recommended for this because of dynamical allocation (more convenient than C-pointers)
+	 * The Elements are all destroyed together, so they do not need an intelligent pointer each
+	 */
+
+	std::vector<Element *> addedElements_ptr;
+
+	/**
+	 * Tracking lattice, in which the Particles are integrated: the Elements as added, or their sections once flattened
+	 * (see Accelerator::flattenElements()). The Elements are linked by their indices in it (see Element::linkAccelerator())
+	 */
+
+	std::vector<Element *> elements_ptr;
+
+	/**
+	 * Arc length table: length of the Accelerator before each Element, followed by the total length
 	 */
 
-	std::vector<std::shared_ptr<Element>> elements_ptr;
+	std::vector<double> arcLengths;
+
+	/**
+	 * Angular index over elements_ptr, for Accelerator::initParticleToClosestElement(),
+	 * and false if Elements were added since it was built (see Accelerator::getElementIndex())
+	 */
+
+	mutable ElementIndex elementIndex;
+	mutable bool elementIndexUpToDate;
+
+	/**
+	 * Losses of the Particles of all the Beams, by Element
+	 */
+
+	LossMap lossMap;
+
+	/**
+	 * Pool building the Beams (not owned)
+	 */
+
+	ThreadPool * threadPool_ptr;
 
 	/**
 	 * Use approximate method for collision detection
@@ -282,6 +717,62 @@ private:
 	 */
 
 	bool const beamFromParticle;
+
+	/**
+	 * Interactions between the Particles of a same Beam
+	 */
+
+	bool spaceCharge;
+
+	/**
+	 * Interaction region, between two arc lengths (m)
+	 */
+
+	struct InteractionRegion {
+		double begin;
+		double end;
+	};
+
+	std::vector<InteractionRegion> interactionRegions;
+
+	/**
+	 * Indexes of the Particles of each Beam in each interaction region (index region * number of Beams + beam),
+	 * kept between the steps to avoid the allocations
+	 */
+
+	std::vector<std::vector<size_t>> regionParticles;
+
+	/**
+	 * Tolerance of the adaptive integration (m), 0 for the fixed timestep
+	 */
+
+	double tolerance;
+
+	/**
+	 * Integration of the Particles Element by Element
+	 */
+
+	bool bucketed;
+
+	/**
+	 * Expansion of the composite Elements in the tracking lattice
+	 */
+
+	bool flattened;
+
+	/**
+	 * Steps between two reorders of the Particles (0 for never), and steps done since the construction
+	 */
+
+	size_t reorderInterval;
+	size_t stepCount;
+
+	/**
+	 * Timestep of the adaptive integration in each Element, starting at GLOBALS::DT
+	 * and adjusted by each step taken in the Element
+	 */
+
+	std::vector<double> timeSteps;
 };
 
 /**
@@ -0,0 +1,188 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <utility>
+#include <cstddef>
+#include <unordered_map>
+
+#include "globals.h"
+#include "exceptions.h"
+
+/**
+ * Arena allocator of the Particles of a Beam and of the Elements of an Accelerator
+ *
+ * The objects are constructed one after the other in blocks of `GLOBALS::ARENA_BLOCK` bytes (a bump allocation),
+ * and the blocks are only given back to the system all at once, by Arena::release() or by the destructor.
+ * The memory of a destroyed object is kept on a free list and reused by the next object of the same size
+ * (see Arena::destroy()), so that a Beam which loses and receives Particles does not grow.
+ *
+ * The Arena does not know the objects it holds: their owner destroys them before the release.
+ * An Arena is bumped by one thread at a time: the threads which construct the Particles of a Beam each fill an Arena of their own,
+ * whose blocks the Beam then takes over with Arena::merge() (see Beam::fillParticles()). Only the free lists are locked.
+ *
+ * The objects allocated (ProfilerCounter::ARENA_ALLOCATIONS) and the blocks asked to the system (ProfilerCounter::ARENA_BLOCKS)
+ * are counted by the Profiler.
+ */
+
+class Arena {
+public:
+
+	/****************************************************************
+	 * Constructors and destructors
+	 ****************************************************************/
+
+	/**
+	 * Constructor of an empty Arena, allocating blocks of `blockSize` bytes when needed
+	 *
+	 * Throws `EXCEPTIONS::BAD_ARENA` if `blockSize` is 0
+	 *
+	 * The constructor is explicit to prevent accidental type casting.
+	 */
+
+	explicit Arena(size_t blockSize = GLOBALS::ARENA_BLOCK);
+
+	/**
+	 * Destructor releasing the blocks
+	 */
+
+	~Arena();
+
+	/**
+	 * We don't want to copy the memory of the objects
+	 */
+
+	Arena(Arena const&) = delete;
+
+	Arena& operator = (Arena const&) = delete;
+
+	/****************************************************************
+	 * Getters
+	 ****************************************************************/
+
+	/**
+	 * Returns the number of allocations since the last release, the reused memory included
+	 */
+
+	size_t getAllocationCount() const;
+
+	/**
+	 * Returns the number of blocks held
+	 */
+
+	size_t getBlockCount() const;
+
+	/**
+	 * Returns the number of bytes held in the blocks
+	 */
+
+	size_t getCapacity() const;
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Returns `size` bytes aligned on `alignment`, from the free list of this size or at the end of the current block
+	 *
+	 * The free lists are only searched (under the lock) when some memory was recycled
+	 *
+	 * Throws `EXCEPTIONS::BAD_ARENA` if `alignment` is more than the alignment of the blocks (`alignof(std::max_align_t)`)
+	 */
+
+	void * allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+	/**
+	 * Constructs a `T` in the Arena
+	 */
+
+	template<class T, class... Args>
+	T * create(Args&&... args) { return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...); }
+
+	/**
+	 * Destroys an object of `size` bytes (its dynamic size for a polymorphic object) and keeps its memory for the next one
+	 */
+
+	template<class T>
+	void destroy(T * object, size_t size) {
+		object->~T();
+		recycle(object, size);
+	}
+
+	/**
+	 * Puts the `size` bytes at `memory` on the free list
+	 */
+
+	void recycle(void * memory, size_t size);
+
+	/**
+	 * Gives all the blocks back to the system at once
+	 *
+	 * The objects must have been destroyed before, as their destructors are not called
+	 */
+
+	void release();
+
+	/**
+	 * Exchanges the blocks and the free lists of the two Arenas, the objects staying where they are
+	 *
+	 * The objects constructed in one Arena are then released with the other one (see Beam::reorder())
+	 */
+
+	void swap(Arena & other);
+
+	/**
+	 * Takes over the blocks and the free lists of `other`, which is left empty
+	 *
+	 * The objects constructed in `other` are then released with this Arena (see Beam::fillParticles())
+	 */
+
+	void merge(Arena & other);
+
+private:
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	size_t blockSize;
+
+	/**
+	 * Blocks, the objects being bumped at the end of the last one
+	 */
+
+	std::vector<std::unique_ptr<std::max_align_t[]>> blocks;
+
+	/**
+	 * Bytes used and bytes available in the last block
+	 */
+
+	size_t used;
+	size_t available;
+
+	size_t capacity;
+
+	size_t allocationCount;
+
+	/**
+	 * Memory of the destroyed objects, by size
+	 */
+
+	std::unordered_map<size_t, std::vector<void *>> freeLists;
+
+	/**
+	 * Number of memories on the free lists, read without the lock
+	 */
+
+	std::atomic<size_t> freeCount;
+
+	std::mutex mutex;
+};
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef ASYNCOBSERVER_H
+#define ASYNCOBSERVER_H
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <ostream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <utility>
+#include <cstdint>
+
+// Forward declaration
+class Accelerator;
+
+#include "globals.h"
+#include "exceptions.h"
+#include "include/ParticleRecord.h"
+#include "include/RingBuffer.h"
+
+/**
+ * What AsyncObserver::observe...() does when the writer thread is behind and the buffer is full
+ *
+ * - BLOCK : the stepping thread waits until there is room for the sample (nothing is lost, the simulation slows down)
+ * - DROP  : the sample is dropped and counted (see AsyncObserver::getDroppedSamples()), the simulation goes on
+ */
+
+enum class BackpressurePolicy { BLOCK, DROP };
+
+/**
+ * Observable carried by an ObserverSample
+ */
+
+enum class ObservableKind : std::uint8_t { POSITION, STATISTICS, LOSS };
+
+/**
+ * Fixed size sample copied by the stepping thread in the buffer of an AsyncObserver
+ */
+
+struct ObserverSample {
+	ObservableKind kind;
+	std::uint64_t step;			// Step of the simulation at which the sample was taken
+	double time;				// Simulated time (s)
+	std::uint32_t beam;			// Id of the Beam (see Accelerator::getBeamId())
+	std::uint64_t count;		// STATISTICS: number of macroparticles, LOSS: number of macroparticles lost since the previous observation
+	double energy;				// STATISTICS: mean energy of the Beam (GeV)
+	double emittanceR;			// STATISTICS: radial emittance of the Beam
+	double emittanceZ;			// STATISTICS: vertical emittance of the Beam
+	ParticleRecord record;		// POSITION: the observed Particle
+};
+
+/**
+ * Observer of a running simulation: the stepping thread only copies the observables into a preallocated
+ * single-producer/single-consumer RingBuffer, and a background thread formats them and writes them to the stream
+ *
+ * The output is one CSV line per sample, its first column being the kind of the sample:
+ *
+ * - position,step,time,beam,element,progress,x,y,z,px,py,pz
+ * - statistics,step,time,beam,count,energy,emittanceR,emittanceZ
+ * - loss,step,time,beam,count
+ *
+ * The observe...() methods must always be called from the same thread, and the stream must not be used by anyone else
+ * until the AsyncObserver is destroyed. The destructor writes all the samples left in the buffer.
+ */
+
+class AsyncObserver {
+public:
+
+	/****************************************************************
+	 * Constructors and destructor
+	 ****************************************************************/
+
+	/**
+	 * Constructor writing to `stream`, with a buffer of at least `capacity` samples
+	 *
+	 * Throws `EXCEPTIONS::BAD_CAPACITY` if `capacity` is 0
+	 *
+	 * The constructor is explicit to prevent accidental type casting.
+	 */
+
+	explicit AsyncObserver(std::ostream & stream, BackpressurePolicy policy = BackpressurePolicy::BLOCK, size_t capacity = GLOBALS::OBSERVER_CAPACITY);
+
+	/**
+	 * Constructor writing to the file `fileName`
+	 *
+	 * Throws `EXCEPTIONS::FILE_EXCEPTION` if the file cannot be opened
+	 */
+
+	explicit AsyncObserver(std::string const& fileName, BackpressurePolicy policy = BackpressurePolicy::BLOCK, size_t capacity = GLOBALS::OBSERVER_CAPACITY);
+
+	/**
+	 * Writes the samples left in the buffer and stops the writer thread
+	 */
+
+	~AsyncObserver();
+
+	/**
+	 * The writer thread works on the attributes: an observer cannot be copied
+	 */
+
+	AsyncObserver(AsyncObserver const&) = delete;
+
+	AsyncObserver& operator = (AsyncObserver const&) = delete;
+
+	/****************************************************************
+	 * Getters
+	 ****************************************************************/
+
+	BackpressurePolicy getPolicy() const;
+
+	/**
+	 * Returns the number of samples dropped because the buffer was full (always 0 with BackpressurePolicy::BLOCK)
+	 */
+
+	std::uint64_t getDroppedSamples() const;
+
+	/**
+	 * Returns the number of samples written to the stream so far
+	 */
+
+	std::uint64_t getWrittenSamples() const;
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Samples the position, momentum and progress of each Particle of `acc`
+	 */
+
+	void observePositions(Accelerator const& acc, std::uint64_t step, double time);
+
+	/**
+	 * Samples the number of macroparticles, the mean energy and the emittances of each Beam of `acc`
+	 */
+
+	void observeStatistics(Accelerator const& acc, std::uint64_t step, double time);
+
+	/**
+	 * Samples the number of macroparticles each Beam of `acc` lost since the previous call
+	 * (a Beam which disappeared lost all the macroparticles it had)
+	 *
+	 * The first call only records the number of macroparticles of each Beam
+	 */
+
+	void observeLosses(Accelerator const& acc, std::uint64_t step, double time);
+
+	/**
+	 * Waits until the writer thread has written all the samples, then flushes the stream
+	 */
+
+	void flush();
+
+private:
+
+	/****************************************************************
+	 * Private methods
+	 ****************************************************************/
+
+	/**
+	 * Copies `sample` in the buffer, following the BackpressurePolicy if it is full
+	 */
+
+	void push(ObserverSample const& sample);
+
+	/**
+	 * Body of the writer thread: pops and writes the samples until the observer is destroyed and the buffer is empty
+	 */
+
+	void write();
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	std::ofstream fileStream;
+
+	std::ostream & stream;
+
+	BackpressurePolicy policy;
+
+	RingBuffer<ObserverSample> buffer;
+
+	/**
+	 * Only used by the stepping thread
+	 */
+
+	std::uint64_t pushedSamples;
+	std::uint64_t droppedSamples;
+
+	/**
+	 * Reused by AsyncObserver::observePositions() so that the stepping thread does not allocate at each observation
+	 */
+
+	std::vector<ParticleRecord> records;
+
+	/**
+	 * (Beam id, number of macroparticles) at the previous and at the current AsyncObserver::observeLosses()
+	 */
+
+	std::vector<std::pair<std::uint32_t, size_t>> previousCounts;
+	std::vector<std::pair<std::uint32_t, size_t>> currentCounts;
+	bool countsKnown;
+
+	/**
+	 * Shared with the writer thread
+	 */
+
+	std::atomic<std::uint64_t> writtenSamples;
+	std::atomic<bool> running;
+
+	std::thread writer;
+};
+
+#endif
@@ -7,6 +7,11 @@
 #include <string>
 #include <sstream>
 #include <iomanip>
+#include <functional>
+#include <numeric>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
 
 // Forward declarations
 class Vector3D;
@@ -15,9 +20,14 @@ class Element;
 class Accelerator;
 class Drawable;
 class Renderer;
+class PhaseSpaceDistribution;
+class ThreadPool;
+class LossMap;
 
 #include "globals.h"
 #include "exceptions.h"
+#include "include/ParticleRecord.h"
+#include "include/Arena.h"
 
 
 class Beam : public Drawable {
@@ -37,13 +47,31 @@ public:
 
 	Beam(Particle const& defaultParticle, size_t const& particleCount, double lambda, Accelerator const& acc, Renderer * engine = nullptr);
 
+	/**
+	 * Constructor spreading the Particles along the ideal trajectory, with offsets drawn from a PhaseSpaceDistribution
+	 *
+	 * - `Particle defaultParticle`: represents the default settings (nominal energy, direction of motion)
+	 * - `size_t particleCount`: number of total particles
+	 * - `double lambda`: scaling factor for the macroparticles (> 1)
+	 * - `PhaseSpaceDistribution distribution`: offsets of the i-th macroparticle, `distribution.sample(i)`
+	 */
+
+	Beam(Particle const& defaultParticle, size_t const& particleCount, double lambda, PhaseSpaceDistribution const& distribution, Accelerator const& acc, Renderer * engine = nullptr);
+
 	/**
 	 * Constructor with only one particle
 	 *
 	 * - `Particle defaultParticle`: represents the default settings
+	 * - `uint32_t particleId`: id of the Particle (see Beam::getParticleId())
 	 */
 
-	Beam(Particle const& defaultParticle, Renderer * engine = nullptr);
+	Beam(Particle const& defaultParticle, Renderer * engine = nullptr, std::uint32_t particleId = 0);
+
+	/**
+	 * Constructor with only one particle, bound to its closest Element of `acc`
+	 */
+
+	Beam(Particle const& defaultParticle, Accelerator const& acc, Renderer * engine = nullptr);
 
 	/****************************************************************
 	 * Destructor
@@ -87,6 +115,12 @@ public:
 
 	double getMeanEnergy() const;
 
+	/**
+	 * Returns the number of macroparticles still in the Beam
+	 */
+
+	size_t getParticleCount() const;
+
 	/**
 	 * Returns the Gamma coefficient of the Particle at index part
 	 */
@@ -99,6 +133,54 @@ public:
 
 	Vector3D getPos(size_t part) const;
 
+	/**
+	 * Returns the horizontal phase space coordinates of the Particle at index part,
+	 * projected on the normal direction of its Element (as in Beam::getEmittanceR())
+	 *
+	 * - X-coor : r
+	 * - Y-coor : vr
+	 */
+
+	Vector3D getPhaseR(size_t part) const;
+
+	/**
+	 * Returns the vertical phase space coordinates of the Particle at index part
+	 *
+	 * - X-coor : z
+	 * - Y-coor : vz
+	 */
+
+	Vector3D getPhaseZ(size_t part) const;
+
+	/**
+	 * Returns a pointer to the Element in which the Particle at index part is
+	 */
+
+	Element const* getElementPtr(size_t part) const;
+
+	/**
+	 * Returns the index of the Element in which the Particle at index part is (see Particle::getElementIndex())
+	 */
+
+	std::uint32_t getElementIndex(size_t part) const;
+
+	/**
+	 * Returns the id of the Particle at index part
+	 *
+	 * The ids are given in the order of construction and follow the Particles when their indexes change
+	 * (Beam::reorder(), Beam::clearDeadParticles()) or when they leave and come back (Beam::insertParticle())
+	 */
+
+	std::uint32_t getParticleId(size_t part) const;
+
+	/**
+	 * Returns the ParticleRecord of the Particle at index part, with `beamCharge` set to Beam::getCharge() and `id` to Beam::getParticleId()
+	 *
+	 * The fields which depend on the Accelerator (progress, beam, element) are set to 0
+	 */
+
+	ParticleRecord getRecord(size_t part) const;
+
 	/**
 	 * Returns the charge of a Particle in the Beam
 	 */
@@ -137,6 +219,25 @@ public:
 
 	Vector3D const getEllipsePhaseCoefZ() const;
 
+	/****************************************************************
+	 * Setters
+	 ****************************************************************/
+
+	/**
+	 * Counts the Particles removed by Beam::clearDeadParticles() in `lossMap_ptr` (not owned), or nowhere if it is a nullptr (the default)
+	 */
+
+	void setLossMap(LossMap * lossMap_ptr);
+
+	/**
+	 * Resolves the indices of the Elements of the Particles (see Particle::getElementIndex()) in `lattice_ptr` (not owned),
+	 * the table of Elements of the Accelerator given to the constructor by default
+	 *
+	 * Without table, the Particles must be in standalone Elements (see Particle::setElement())
+	 */
+
+	void setLattice(std::vector<Element *> const* lattice_ptr);
+
 	/****************************************************************
 	 * Methods
 	 ****************************************************************/
@@ -151,6 +252,30 @@ public:
 
 	void step(double dt = GLOBALS::DT, bool methodChapi = false);
 
+	/**
+	 * Integrates the movement equations over an observation interval `duration`, with an adaptive timestep for each Particle
+	 *
+	 * The error of a step is estimated by step doubling (one step of dt against two steps of dt/2), and the step is
+	 * done again with a smaller timestep while the error on the position is more than `tolerance` (m).
+	 * The timestep of each Element is taken from `timeSteps` (by index of the Element) and adjusted after each step,
+	 * and a step never goes further than the length of its Element or the end of the interval.
+	 * The forces exerted on the Particles before the call (the interactions) apply over the whole interval.
+	 *
+	 * If `duration` is not positive, then this doesn't do anything
+	 */
+
+	void step(double duration, bool methodChapi, double tolerance, std::vector<double> & timeSteps);
+
+	/**
+	 * Same as Beam::step(), the Particles being integrated Element by Element: the fields of all the Particles of an Element
+	 * are computed in one call (see Element::getFields()), then the Particles are pushed one after the other
+	 *
+	 * The Particles of each Element (see Beam::getElementParticles()) are kept between the steps,
+	 * and only built again when the Beam gains or loses Particles
+	 */
+
+	void stepByElement(double dt = GLOBALS::DT, bool methodChapi = false);
+
 	/**
 	 * Returns true if there is no Particle left in the Beam
 	 *
@@ -163,10 +288,38 @@ public:
 	 * Calls Element::updatePointedElement() (with polymorphism) on all particles of the Beam
 	 */
 
-	void updatePointedElement(bool methodChapi = false) const;
+	void updatePointedElement(bool methodChapi = false);
 
 	/**
-	 * Modifies the associatedProgress by updating the progress for each Particle which is still in the Beam (clears the vector and update afterwards to adapt to the loss of Particles)
+	 * Moves the Particles to the table of Elements of the Beam rebuilt from the previous one, the Element at index k of the previous table
+	 * being replaced by the Elements from index `firstElements[k]` on (see Accelerator::flattenElements())
+	 */
+
+	void relinkParticles(std::vector<std::uint32_t> const& firstElements);
+
+	/**
+	 * Returns the indexes of the Particles in the Element at index `element`, in no particular order (see Beam::stepByElement())
+	 *
+	 * The lists are moved along with the Particles which change Element in Beam::updatePointedElement()
+	 */
+
+	std::vector<size_t> const& getElementParticles(size_t element);
+
+	/**
+	 * Sorts the Particles by index of their Element, then by progress in their Element (see Particle::getElementProgress()),
+	 * so that the Particles close in the ring are close in memory
+	 *
+	 * The Particles themselves are moved: they are copied in sorted order in a new Arena, which replaces particleArena.
+	 * The sort is a stable radix sort, whose passes are split between the threads of `threadPool_ptr` if given.
+	 * The ids of the Particles (see Beam::getParticleId()) and `associatedProgress` (see Beam::updateProgresses()) follow the Particles.
+	 */
+
+	void reorder(std::vector<double> & associatedProgress, ThreadPool * threadPool_ptr = nullptr);
+
+	/**
+	 * Modifies the associatedProgress by updating the progress for each Particle which is still in the Beam (resized to adapt to the loss of Particles)
+	 *
+	 * The progresses are written in place: the vector only reallocates when the Beam grows
 	 */
 
 	void updateProgresses(std::vector<double> & associatedProgress, Accelerator const& acc) const;
@@ -177,6 +330,20 @@ public:
 
 	void exertForce(Vector3D const& force, size_t part);
 
+	/**
+	 * Removes the Particle at index part from the Beam, its memory being kept for the next inserted Particle
+	 *
+	 * Uses swap + pop_back: the last Particle takes the index part
+	 */
+
+	void removeParticle(size_t part);
+
+	/**
+	 * Appends a Particle rebuilt from `record` (see Particle::fromRecord()) and returns it, to be bound to its Element
+	 */
+
+	Particle & insertParticle(ParticleRecord const& record);
+
 	/**
 	 * Returns a string representation of the Beam
 	 */
@@ -198,10 +365,10 @@ public:
 	virtual void draw(Renderer * engine_ptr = nullptr) const override;
 
 	/**
-	 * Draw particles
+	 * Draw particles, with the renderer in argument if given, else with the renderer of the Beam (see Beam::draw())
 	 */
 
-	void drawParticles() const;
+	void drawParticles(Renderer * engine_ptr = nullptr) const;
 
 private:
 
@@ -235,6 +402,16 @@ private:
 
 	// void exertInteractions();
 
+	/**
+	 * Resizes the Beam to `count` Particles and runs `body` on chunks of the indexes,
+	 * concurrently if the Accelerator has a ThreadPool (see Accelerator::setThreadPool())
+	 *
+	 * `body` must only write the Particles of its own chunk, constructed in the Arena it receives: each chunk gets an Arena
+	 * holding its `size` bytes Particles in a single block, taken over by particleArena at the end of the chunk (see Arena::merge())
+	 */
+
+	void fillParticles(Accelerator const& acc, size_t count, size_t size, std::function<void(size_t, size_t, Arena &)> const& body);
+
 	/**
 	 * Remove the Particle of the Beam that are out of the Accelerator
 	 *
@@ -243,6 +420,30 @@ private:
 
 	void clearDeadParticles();
 
+	/**
+	 * Lists the Particles of each Element from scratch (see Beam::getElementParticles())
+	 */
+
+	void buildBuckets();
+
+	/**
+	 * Moves the index `part` from the Particles of the Element at index `from` to the ones of the Element at index `to`
+	 */
+
+	void moveToBucket(size_t part, size_t from, size_t to);
+
+	/**
+	 * Integrates the movement of a Particle over `duration` with an adaptive timestep (see Beam::step())
+	 */
+
+	void stepAdaptive(Particle & particle, double duration, bool methodChapi, double tolerance, std::vector<double> & timeSteps) const;
+
+	/**
+	 * Returns the Element of a Particle of the Beam, resolved in the table of Elements of the Beam (see Beam::setLattice())
+	 */
+
+	Element const& getElement(Particle const& particle) const;
+
 	/****************************************************************
 	 * Attributes
 	 ****************************************************************/
@@ -274,10 +475,51 @@ private:
 	double const lambda;
 
 	/**
-	 * Collection of the stored Particles of the same "nature"
+	 * Memory of the Particles: they are bump allocated, and released all at once with the Beam
+	 */
+
+	Arena particleArena;
+
+	/**
+	 * Collection of the stored Particles of the same "nature", owned by the Beam and constructed in particleArena
+	 */
+
+	std::vector<Particle *> particles_ptr;
+
+	/**
+	 * Id of each Particle (see Beam::getParticleId()) and id of the next constructed one
+	 */
+
+	std::vector<std::uint32_t> particleIds;
+	std::uint32_t nextParticleId;
+
+	/**
+	 * Table of Elements in which the Particles are (not owned)
+	 */
+
+	std::vector<Element *> const* lattice_ptr;
+
+	/**
+	 * Where the lost Particles are counted (not owned)
+	 */
+
+	LossMap * lossMap_ptr;
+
+	/**
+	 * Indexes of the Particles in each Element (by index of the Element), the slot of each Particle in its list,
+	 * and whether the lists still match the Particles
+	 */
+
+	std::vector<std::vector<size_t>> elementParticles;
+	std::vector<size_t> bucketSlots;
+	bool bucketsUpToDate;
+
+	/**
+	 * Positions and fields of the Particles of an Element, kept between the steps to avoid the allocations
 	 */
 
-	std::vector<std::unique_ptr<Particle>> particles_ptr;
+	std::vector<Vector3D> bucketPositions;
+	std::vector<Vector3D> bucketFields;
 };
 
 /****************************************************************
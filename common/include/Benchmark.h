@@ -0,0 +1,93 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <ostream>
+#include <iomanip>
+#include <memory>
+#include <cstdint>
+
+// Forward declaration
+class Accelerator;
+
+#include "globals.h"
+#include "exceptions.h"
+
+/**
+ * Measures of a benchmark scenario (see Benchmark::run())
+ */
+
+struct BenchmarkResult {
+	std::string name;									// Name of the scenario
+	std::uint64_t particleSteps;						// Sum over the steps of the number of Particles
+	double seconds;										// Wall time of the measured steps
+	PerfSample hardware;								// Hardware events counted during the measured steps
+	std::array<bool, size_t(PerfEvent::COUNT)> available;	// Events which could be counted
+};
+
+/**
+ * Reference measures of a benchmark scenario, stored in a baseline file (see Benchmark::readBaseline())
+ */
+
+struct BenchmarkBaseline {
+	std::string name;					// Name of the scenario
+	double particleStepsPerSecond;		// Throughput
+	double allocationsPerStep;			// Heap allocations per Accelerator::step()
+};
+
+/**
+ * Benchmark harness of the simulation: times a number of Accelerator::step() after a warm-up
+ * and reports the cost per particle-step (one Particle advanced by one step)
+ *
+ * The hardware counters (see PerfCounters) are read around the measured steps when the system allows it;
+ * otherwise only the time is reported and the events are shown as "n/a".
+ * If the simulation is instrumented (Profiler::ENABLED), the Profiler of the thread is reset before the measured steps,
+ * reads the hardware counters around each phase, and Benchmark::report() adds the details of each phase.
+ */
+
+class Benchmark {
+public:
+
+	/**
+	 * Runs `warmupSteps` then `steps` steps of `dt` on `acc`, and returns the measures of the last `steps`
+	 */
+
+	static BenchmarkResult run(std::string const& name, Accelerator & acc, size_t steps, size_t warmupSteps = 0, double dt = GLOBALS::DT);
+
+	/**
+	 * Writes the measures per particle-step (and per phase if the simulation is instrumented)
+	 */
+
+	static void report(std::ostream & stream, BenchmarkResult const& result);
+
+	/**
+	 * Writes the header of the table of Benchmark::report()
+	 */
+
+	static void reportHeader(std::ostream & stream);
+
+	/**
+	 * Reads a baseline file: the relative tolerance on the throughput and the reference measures of each scenario
+	 *
+	 * The file is the JSON object written by Benchmark::writeBaseline():
+	 *
+	 * { "tolerance": 0.2, "scenarios": [ { "name": "...", "particleStepsPerSecond": 1e6, "allocationsPerStep": 0 }, ... ] }
+	 *
+	 * Throws `EXCEPTIONS::BAD_BASELINE` if a field is missing or is not a number
+	 */
+
+	static std::vector<BenchmarkBaseline> readBaseline(std::istream & stream, double & tolerance);
+
+	/**
+	 * Writes a baseline file (see Benchmark::readBaseline())
+	 */
+
+	static void writeBaseline(std::ostream & stream, std::vector<BenchmarkBaseline> const& baselines, double tolerance);
+};
+
+#endif
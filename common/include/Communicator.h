@@ -0,0 +1,71 @@
+#ifndef COMMUNICATOR_H
+#define COMMUNICATOR_H
+
+#pragma once
+
+#include <vector>
+
+#include "globals.h"
+#include "exceptions.h"
+#include "include/ParticleRecord.h"
+
+/**
+ * Group of workers simulating the shares of one Accelerator (see Shard)
+ *
+ * Every method is collective: all the workers must call it, in the same order.
+ * The operations are those of MPI (rank, size, barrier, all-to-all, all-reduce),
+ * so that a message passing implementation can replace SharedMemoryCommunicator without touching Shard.
+ */
+
+class Communicator {
+public:
+
+	/****************************************************************
+	 * Destructor
+	 ****************************************************************/
+
+	virtual ~Communicator() = default;
+
+	/****************************************************************
+	 * Getters
+	 ****************************************************************/
+
+	/**
+	 * Returns the index of the calling worker, between 0 and Communicator::getSize() - 1
+	 */
+
+	virtual size_t getRank() const = 0;
+
+	/**
+	 * Returns the number of workers
+	 */
+
+	virtual size_t getSize() const = 0;
+
+	/****************************************************************
+	 * Collective operations
+	 ****************************************************************/
+
+	/**
+	 * Waits until every worker reached the barrier
+	 */
+
+	virtual void barrier() = 0;
+
+	/**
+	 * All-to-all exchange (MPI_Alltoallv): `outgoing[i]` is sent to the worker i,
+	 * and the records sent to the calling worker by every worker (itself included) are appended to `incoming`
+	 *
+	 * Throws `EXCEPTIONS::BAD_EXCHANGE` if `outgoing` does not contain Communicator::getSize() lists
+	 */
+
+	virtual void exchange(std::vector<std::vector<ParticleRecord>> const& outgoing, std::vector<ParticleRecord> & incoming) = 0;
+
+	/**
+	 * Returns the sum of `value` over all the workers (MPI_Allreduce)
+	 */
+
+	virtual double sum(double value) = 0;
+};
+
+#endif
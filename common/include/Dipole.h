@@ -62,6 +62,12 @@ public:
 
 	virtual std::shared_ptr<Element> copy() const override;
 
+	/**
+	 * Returns a polymorphic copy of the current Dipole element constructed in `arena` (see Element::copy(Arena &))
+	 */
+
+	virtual Element * copy(Arena & arena) const override;
+
 	/****************************************************************
 	 * Getter (virtual)
 	 ****************************************************************/
@@ -76,6 +82,12 @@ public:
 
 	virtual Vector3D getField(Vector3D const& pos, bool methodChapi = false) const override;
 
+	/**
+	 * Same uniform field for all the positions
+	 */
+
+	virtual void getFields(std::vector<Vector3D> const& positions, std::vector<Vector3D> & fields, bool methodChapi = false) const override;
+
 	/**
 	 * Returns the HORIZONTAL direction perpendicular to the Dipole Element (curved) at a certain position
 	 */
@@ -142,6 +154,12 @@ public:
 
 	double getOutAngle() const;
 
+	/**
+	 * Get the magnetic field exerted by the Dipole
+	 */
+
+	double getB() const;
+
 	/****************************************************************
 	 * Setter
 	 ****************************************************************/
@@ -157,10 +175,12 @@ public:
 	 ****************************************************************/
 
 	/**
-	 * Returns true if the Particle p is outside the dipole (touched the wall)
+	 * Returns true if the position pos is outside the dipole (in the wall)
 	 */
 
-	virtual bool isInWall(Particle const& p) const override;
+	virtual bool isInWall(Vector3D const& pos) const override;
+
+	using Element::isInWall;
 
 	/**
 	 * Returns a string representation of the dipole
@@ -3,11 +3,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <sstream>
+#include <vector>
+#include <cstdint>
+#include <limits>
 
 // Forward declaration
 class Particle;
@@ -17,14 +21,25 @@ class Renderer;
 
 #include "globals.h"
 #include "exceptions.h"
+#include "include/Arena.h"
 
 /**
  * Element is an abstract class which embodies the element of an accelerator
+ *
+ * The Elements of an Accelerator are linked to their neighbours by their indices in the table of Elements of the Accelerator
+ * (see Element::linkAccelerator()), not by pointers: the Elements hold no pointer on one another nor on the table,
+ * which the caller provides to resolve the indices (see Element::updatePointedElement()). A lattice thus stays valid when its table is copied or moved.
  */
 
 class Element : public Drawable {
 public:
 
+	/**
+	 * Index of the missing neighbours (see Element::getNext() and Element::getPrev())
+	 */
+
+	static constexpr std::uint32_t NO_LINK = std::numeric_limits<std::uint32_t>::max();
+
 	/****************************************************************
 	 * Constructors
 	 ****************************************************************/
@@ -47,10 +62,10 @@ public:
 	 ****************************************************************/
 
 	/**
-	 * Destructor for the 2 attributes which are pointers on Element, prev and next, to point to nullptr without deleting these elements
+	 * Virtual destructor, the neighbours being indices there is nothing to unlink
 	 */
 
-	virtual ~Element() override;
+	virtual ~Element() override = default;
 
 	/****************************************************************
 	 * Copy constructor and operator =
@@ -59,7 +74,7 @@ public:
 	// The copy constructor is used for the polymorphic copy
 
 	/**
-	 * operator = deleted because copying an element has no physical meaning (superposition ? how do you modify the pointers ?) and to avoid copying pointers without knowing it
+	 * operator = deleted because copying an element has no physical meaning (superposition ? how do you modify the links ?) and to avoid copying links without knowing it
 	 */
 
 	Element& operator = (Element const&) = delete;
@@ -78,6 +93,14 @@ public:
 
 	virtual std::shared_ptr<Element> copy() const = 0;
 
+	/**
+	 * Returns a polymorphic copy of the current element constructed in `arena`
+	 *
+	 * The copy belongs to the owner of the Arena (Accelerator), which destroys it before releasing the Arena
+	 */
+
+	virtual Element * copy(Arena & arena) const = 0;
+
 	/****************************************************************
 	 * Getters
 	 ****************************************************************/
@@ -100,6 +123,36 @@ public:
 
 	double getRadius() const;
 
+	/**
+	 * Returns the index of the Element in its Accelerator (0 if the Element is not in an Accelerator)
+	 */
+
+	size_t getIndex() const;
+
+	/**
+	 * Returns the length of the ideal trajectory before the Element in its Accelerator
+	 */
+
+	double getStartLength() const;
+
+	/**
+	 * Returns the index of the next Element in the table of Elements, Element::NO_LINK if there is none
+	 */
+
+	std::uint32_t getNext() const;
+
+	/**
+	 * Returns the index of the previous Element in the table of Elements, Element::NO_LINK if there is none
+	 */
+
+	std::uint32_t getPrev() const;
+
+	/**
+	 * Returns true if the Element is in a table of Elements (see Element::linkAccelerator())
+	 */
+
+	bool isLinked() const;
+
 	/****************************************************************
 	 * Getter (virtual)
 	 ****************************************************************/
@@ -112,6 +165,15 @@ public:
 
 	virtual Vector3D getField(Vector3D const& pos, bool methodChapi = false) const = 0;
 
+	/**
+	 * Fills `fields` with the magnetic fields at the positions `positions` (see Element::getField())
+	 *
+	 * Used by Beam::stepByElement() to compute the fields of all the Particles of the Element in one call.
+	 * By default calls Element::getField() for each position, the Elements override it when their field is cheaper in batch.
+	 */
+
+	virtual void getFields(std::vector<Vector3D> const& positions, std::vector<Vector3D> & fields, bool methodChapi = false) const;
+
 	/**
 	 * Returns the HORIZONTAL direction perpendicular to the Element at a certain position
 	 */
@@ -153,15 +215,36 @@ public:
 	 ****************************************************************/
 
 	/**
-	 * Make the pointer next_ptr of the current element point at the _next and reciprocally the pointer prev_ptr of the _next element point at the current element
+	 * Makes `_next` the next Element of the current one, and reciprocally the current one the previous Element of `_next`
 	 *
 	 * Useful in Accelerator in order to make a full circle (link the last one with the first element)
+	 *
+	 * Throws `EXCEPTIONS::NOT_SAME_LATTICE` if one of the two Elements is not in a table of Elements (see Element::linkAccelerator())
 	 */
 
 	void linkNext(Element & _next);
 
 	/**
-	 * Make the pointer "element_ptr" of the Particle p point to the new element in which the particle is
+	 * Stores the place of the Element in an Accelerator: its index in the table of its Elements and the length of the ideal trajectory before it
+	 *
+	 * The previous links are forgotten (see Element::linkNext())
+	 *
+	 * Used in Accelerator::addElement(), so that the progress of a Particle in the Accelerator is derived from its progress in the Element
+	 */
+
+	void linkAccelerator(size_t index, double startLength);
+
+	/**
+	 * Appends the primitive Elements making up the Element to `primitives`, in the order of the ideal trajectory:
+	 * the Element itself, or its sections for a composite Element (see Frodo::appendPrimitives())
+	 *
+	 * Used by Accelerator::flattenElements()
+	 */
+
+	virtual void appendPrimitives(std::vector<Element *> & primitives);
+
+	/**
+	 * Sets the index of the Particle p (see Particle::setElementIndex()) to the one of the new element in which the particle is
 	 *
 	 * Depends on the method wanted (approximation of the accelerator by a circle or not)
 	 *
@@ -171,19 +254,29 @@ public:
 	 * We return the element whose distance is the shortest
 	 *
 	 * If the distance are the same are both prev and next are nullptr we will return the ancient element without doing anything by CONVENTION, but it should never happen normally
+	 *
+	 * The progress in the new Element is stored in the Particle (see Particle::getElementProgress())
+	 *
+	 * The neighbours are looked up in `lattice`, the table of Elements the Element is linked in (see Element::linkAccelerator())
 	 */
 
-	void updatePointedElement(Particle & p, bool methodChapi = false) const;
+	void updatePointedElement(Particle & p, std::vector<Element *> const& lattice, bool methodChapi = false) const;
+
+	/**
+	 * Returns true if the Particle p is outside the Element (touched the wall)
+	 */
+
+	bool isInWall(Particle const& p) const;
 
 	/****************************************************************
 	 * Virtual methods
 	 ****************************************************************/
 
 	/**
-	 * Returns true if the Particle p is outside the Element (touched the wall)
+	 * Returns true if the position pos is outside the Element (in the wall)
 	 */
 
-	virtual bool isInWall(Particle const& p) const = 0;
+	virtual bool isInWall(Vector3D const& pos) const = 0;
 
 	/**
 	 * Returns a string representation of the element
@@ -198,8 +291,11 @@ protected:
 	Vector3D posIn;
 	Vector3D posOut;
 	double const radius;
-	Element * next_ptr;		// initialised to nullptr
-	Element * prev_ptr;		// initialised to nullptr
+	bool linked;			// initialised to false
+	std::uint32_t next;		// initialised to NO_LINK
+	std::uint32_t prev;		// initialised to NO_LINK
+	size_t index;			// initialised to 0
+	double startLength;		// initialised to 0
 };
 
 /**
@@ -0,0 +1,141 @@
+#ifndef ELEMENTINDEX_H
+#define ELEMENTINDEX_H
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+// Forward declaration
+class Vector3D;
+class Element;
+class ThreadPool;
+
+#include "globals.h"
+#include "exceptions.h"
+
+/**
+ * Angular index over the Elements of an Accelerator, answering "which Element contains this point"
+ *
+ * The plane is cut into angular bins around the origin (the center of the ring), and each bin lists the Elements
+ * which cross it. A query only tests the few Elements of the bin of the point, in the order of the Accelerator,
+ * and falls back to testing all the Elements if none of them matches (e.g. for a lattice which does not go around the origin).
+ *
+ * An Element contains a point if Element::getParticleProgress() is between 0 and 1 and the point is not in its wall,
+ * as in Accelerator::initParticleToClosestElement().
+ */
+
+class ElementIndex {
+public:
+
+	/****************************************************************
+	 * Constants
+	 ****************************************************************/
+
+	/**
+	 * Returned by the queries when no Element contains the point
+	 */
+
+	static constexpr size_t NOT_FOUND = std::numeric_limits<size_t>::max();
+
+	/****************************************************************
+	 * Constructors
+	 ****************************************************************/
+
+	/**
+	 * Constructor of an empty index (every query returns ElementIndex::NOT_FOUND)
+	 */
+
+	ElementIndex();
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Indexes a list of Elements (replaces the previous content)
+	 *
+	 * The Elements are not owned and must outlive the index, or until the next ElementIndex::build()
+	 */
+
+	void build(std::vector<Element *> const& elements, bool methodChapi);
+
+	void build(std::vector<std::shared_ptr<Element>> const& elements, bool methodChapi);
+
+	/**
+	 * Empties the index
+	 */
+
+	void clear();
+
+	/**
+	 * Returns the index of the first Element containing `pos`, or ElementIndex::NOT_FOUND
+	 */
+
+	size_t find(Vector3D const& pos) const;
+
+	/**
+	 * Batch version of ElementIndex::find(): `indexes[i]` is the Element containing `points[i]`
+	 *
+	 * The points are split between the threads of `threadPool_ptr` if given
+	 */
+
+	void find(std::vector<Vector3D> const& points, std::vector<size_t> & indexes, ThreadPool * threadPool_ptr = nullptr) const;
+
+	/**
+	 * Returns the number of angular bins
+	 */
+
+	size_t getBinCount() const;
+
+private:
+
+	/****************************************************************
+	 * Private methods
+	 ****************************************************************/
+
+	/**
+	 * Returns the bin of a position
+	 */
+
+	size_t getBin(Vector3D const& pos) const;
+
+	/**
+	 * Returns true if the Element at index `index` contains `pos`
+	 */
+
+	bool contains(size_t index, Vector3D const& pos) const;
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	/**
+	 * Indexed Elements, in the order of the Accelerator
+	 */
+
+	std::vector<Element const*> elements;
+
+	/**
+	 * Method used to compute the progress in the Elements (see Accelerator)
+	 */
+
+	bool methodChapi;
+
+	/**
+	 * Elements of the bin i are `binElements[binStarts[i]]` to `binElements[binStarts[i + 1] - 1]`
+	 */
+
+	std::vector<size_t> binStarts;
+
+	/**
+	 * Concatenated lists of the Elements of each bin
+	 */
+
+	std::vector<size_t> binElements;
+};
+
+#endif
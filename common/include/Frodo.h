@@ -9,6 +9,7 @@
 #include <string>
 #include <sstream>
 #include <cmath>
+#include <vector>
 
 // Forward declaration
 class Vector3D;
@@ -75,6 +76,12 @@ public:
 
 	virtual std::shared_ptr<Element> copy() const override;
 
+	/**
+	 * Returns a polymorphic copy of the current FODO element constructed in `arena` (see Element::copy(Arena &))
+	 */
+
+	virtual Element * copy(Arena & arena) const override;
+
 	/****************************************************************
 	 * Getter (virtual)
 	 ****************************************************************/
@@ -87,6 +94,22 @@ public:
 
 	virtual Vector3D getField(Vector3D const& pos, bool methodChapi = false) const override;
 
+	/****************************************************************
+	 * Getters
+	 ****************************************************************/
+
+	/**
+	 * Returns the intensity of the magnetic field of the Quadrupoles
+	 */
+
+	double getB() const;
+
+	/**
+	 * Returns the length of the straight neutral sections
+	 */
+
+	double getStraightLength() const;
+
 	/****************************************************************
 	 * Virtual methods
 	 ****************************************************************/
@@ -97,6 +120,14 @@ public:
 
 	virtual std::string const to_string() const override;
 
+	/**
+	 * Appends the focalizer, the first straight, the defocalizer and the last straight
+	 *
+	 * Once flattened, the Frodo is only displayed: the Particles are integrated in its sections (see Accelerator::flattenElements())
+	 */
+
+	virtual void appendPrimitives(std::vector<Element *> & primitives) override;
+
 	/****************************************************************
 	 * Rendering engine
 	 ****************************************************************/
@@ -112,10 +143,10 @@ public:
 	virtual void draw(Renderer * engine_ptr = nullptr) const override;
 
 	/**
-	 * Draw elements in the Frodo element (Quadrupole and Straight)
+	 * Draw elements in the Frodo element (Quadrupole and Straight), with the renderer in argument if given, else with the renderer of the Frodo
 	 */
 
-	void drawElements() const;
+	void drawElements(Renderer * engine_ptr = nullptr) const;
 
 private:
 
@@ -0,0 +1,64 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <QVector3D>
+#include <QMatrix4x4>
+
+/**
+ * View frustum of the camera, used to skip the draw calls of the objects which cannot be seen
+ *
+ * The 6 planes are extracted from the world to clip space matrix (projection * camera),
+ * each of them being stored normalized as (a, b, c, d) with the inside being a*x + b*y + c*z + d >= 0
+ */
+
+class Frustum {
+public:
+
+	/****************************************************************
+	 * Constructors
+	 ****************************************************************/
+
+	/**
+	 * Frustum containing the whole space
+	 */
+
+	Frustum();
+
+	/**
+	 * Frustum of the world to clip space matrix `worldToClip`
+	 *
+	 * The constructor is explicit to prevent accidental type casting.
+	 */
+
+	explicit Frustum(QMatrix4x4 const& worldToClip);
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Returns false if the sphere of center `center` and radius `radius` is entirely outside the frustum
+	 *
+	 * The test is conservative: a sphere near a corner of the frustum may be reported visible while it is not
+	 */
+
+	bool containsSphere(QVector3D const& center, double radius) const;
+
+private:
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	/**
+	 * Left, right, bottom, top, near and far planes
+	 */
+
+	std::array<std::array<double, 4>, 6> planes;
+};
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef LATTICE_H
+#define LATTICE_H
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <istream>
+#include <ostream>
+#include <fstream>
+#include <sstream>
+#include <cstdint>
+#include <type_traits>
+
+// Forward declaration
+class Vector3D;
+class Particle;
+class Element;
+class Accelerator;
+class Renderer;
+
+#include "globals.h"
+#include "exceptions.h"
+#include "include/ParticleRecord.h"
+
+/**
+ * Description of an Accelerator (elements, Beams, closed loop) read from a lattice file, so that the ring can be changed without a rebuild
+ *
+ * A lattice file is a text file with one entry per line, the positions being given as 3 coordinates `x y z`:
+ *
+ * - `straight posIn posOut radius`
+ * - `quadrupole posIn posOut radius b`
+ * - `frodo posIn posOut radius b straightLength`
+ * - `dipole posIn posOut radius curvature B`
+ * - `beam proton|antiproton|electron pos energy speed particleCount lambda`
+ * - `close` : closes the loop (see Accelerator::closeElementLoop())
+ *
+ * Empty lines and everything after a `#` are ignored. See `assets/lattices/` for examples.
+ *
+ * Lattice::load() keeps the validated lattice in a binary cache next to the file,
+ * which is used instead of the text as long as the hash of the text has not changed.
+ */
+
+class Lattice {
+public:
+
+	/****************************************************************
+	 * Constructors
+	 ****************************************************************/
+
+	/**
+	 * Constructor of an empty lattice
+	 */
+
+	Lattice();
+
+	/**
+	 * Reads and validates the lattice of the text `stream`
+	 *
+	 * Throws `EXCEPTIONS::BAD_LATTICE` if a line cannot be read, and the Accelerator exceptions if the geometry is invalid
+	 */
+
+	static Lattice parse(std::istream & stream);
+
+	/**
+	 * Reads the lattice file `fileName`, from its binary cache (see Lattice::getCacheName()) if it is up to date,
+	 * otherwise from the text, in which case the cache is (re)written
+	 *
+	 * Throws `EXCEPTIONS::FILE_EXCEPTION` if the file cannot be opened, and the exceptions of Lattice::parse()
+	 */
+
+	static Lattice load(std::string const& fileName);
+
+	/****************************************************************
+	 * Getters
+	 ****************************************************************/
+
+	size_t getElementCount() const;
+
+	size_t getBeamCount() const;
+
+	/**
+	 * Does the lattice close the loop ?
+	 */
+
+	bool isClosed() const;
+
+	/**
+	 * Was the lattice read from a binary cache by Lattice::load() ?
+	 */
+
+	bool isFromCache() const;
+
+	/**
+	 * Returns the name of the binary cache of the lattice file `fileName`
+	 */
+
+	static std::string getCacheName(std::string const& fileName);
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Adds the elements, then the Beams of the lattice to the (empty) Accelerator `acc`,
+	 * the elements being drawn by `engine_ptr`
+	 */
+
+	void build(Accelerator & acc, Renderer * engine_ptr = nullptr) const;
+
+	/**
+	 * Writes the binary cache of the lattice, tagged with the hash of the text it was read from
+	 */
+
+	void writeCache(std::ostream & stream, std::uint64_t hash) const;
+
+	/**
+	 * Reads the binary cache of `stream` into `lattice`
+	 *
+	 * Returns false (and leaves `lattice` untouched) if the cache is not tagged with `hash`, was written by another version,
+	 * or is truncated
+	 */
+
+	static bool readCache(std::istream & stream, std::uint64_t hash, Lattice & lattice);
+
+	/**
+	 * FNV-1a hash of `text`, used to know if a cache is up to date
+	 */
+
+	static std::uint64_t hash(std::string const& text);
+
+private:
+
+	/****************************************************************
+	 * Private types
+	 ****************************************************************/
+
+	/**
+	 * Kinds of elements of a lattice
+	 */
+
+	enum class ElementKind : std::uint32_t { STRAIGHT, QUADRUPOLE, FRODO, DIPOLE };
+
+	/**
+	 * Element of the lattice
+	 *
+	 * Plain data, so that the slots are written to and read from the cache as raw bytes
+	 */
+
+	struct ElementSlot {
+		ElementKind kind;
+		double posIn[3];
+		double posOut[3];
+		double radius;
+		double b;				// Quadrupoles and Frodo sections
+		double straightLength;	// Frodo sections
+		double curvature;		// Dipoles
+		double B;				// Dipoles
+	};
+
+	/**
+	 * Beam of the lattice
+	 */
+
+	struct BeamSlot {
+		ParticleKind kind;
+		double pos[3];
+		double energy;
+		double speed[3];
+		std::uint64_t particleCount;
+		double lambda;
+	};
+
+	static_assert(std::is_trivially_copyable<ElementSlot>::value, "ElementSlot must be cached as raw bytes");
+	static_assert(std::is_trivially_copyable<BeamSlot>::value, "BeamSlot must be cached as raw bytes");
+
+	/****************************************************************
+	 * Private methods
+	 ****************************************************************/
+
+	/**
+	 * Returns a new Element built from `slot`
+	 */
+
+	static std::unique_ptr<Element> makeElement(ElementSlot const& slot, Renderer * engine_ptr);
+
+	/**
+	 * Returns a new Particle built from `slot`
+	 */
+
+	static std::unique_ptr<Particle> makeParticle(BeamSlot const& slot);
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	std::vector<ElementSlot> elements;
+
+	std::vector<BeamSlot> beams;
+
+	bool closed;
+
+	bool fromCache;
+};
+
+#endif
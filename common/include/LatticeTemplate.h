@@ -0,0 +1,176 @@
+#ifndef LATTICETEMPLATE_H
+#define LATTICETEMPLATE_H
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <string>
+
+// Forward declaration
+class Vector3D;
+class Particle;
+class Accelerator;
+struct SweepPoint;
+
+#include "globals.h"
+#include "exceptions.h"
+
+/**
+ * Description of a ring whose geometry is fixed but whose tuning parameters are not
+ *
+ * The geometry (positions, radii, curvatures) is validated once by LatticeTemplate::compile(),
+ * then LatticeTemplate::instantiate() fills an Accelerator for any given SweepPoint:
+ *
+ * - `Frodo` elements receive the gradient `b` and the `straightLength` of the point
+ * - `Dipole` elements receive the field `B` of the point
+ * - Beams receive the `energy` of the point
+ *
+ * A compiled template is read-only, so it can be shared by all the runs of a Sweep at the same time
+ */
+
+class LatticeTemplate {
+public:
+
+	/****************************************************************
+	 * Constructors
+	 ****************************************************************/
+
+	/**
+	 * Constructor of an empty template
+	 *
+	 * The Accelerators will be instantiated with the given `methodChapi` and `beamFromParticle` (see Accelerator::Accelerator())
+	 *
+	 * The constructor is explicit to prevent accidental type casting.
+	 */
+
+	explicit LatticeTemplate(bool methodChapi = true, bool beamFromParticle = false);
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Appends a `Straight` element, which has no tuning parameter
+	 */
+
+	void addStraight(Vector3D const& posIn, Vector3D const& posOut, double radius);
+
+	/**
+	 * Appends a `Frodo` element, whose `b` and `straightLength` are given by the SweepPoint
+	 */
+
+	void addFrodo(Vector3D const& posIn, Vector3D const& posOut, double radius);
+
+	/**
+	 * Appends a `Dipole` element, whose field `B` is given by the SweepPoint
+	 */
+
+	void addDipole(Vector3D const& posIn, Vector3D const& posOut, double radius, double curvature);
+
+	/**
+	 * Appends a Beam built from `defaultParticle`, whose energy is given by the SweepPoint
+	 *
+	 * See Accelerator::addBeam()
+	 */
+
+	void addBeam(Particle const& defaultParticle, size_t particleCount, double lambda);
+
+	/**
+	 * Validates the template: the elements must touch each other and close the loop
+	 *
+	 * Throws `EXCEPTIONS::EMPTY_TEMPLATE` if there is no element or no Beam, and the Accelerator exceptions if the geometry is invalid
+	 */
+
+	void compile();
+
+	/**
+	 * Returns true once LatticeTemplate::compile() succeeded
+	 */
+
+	bool isCompiled() const;
+
+	/**
+	 * Adds the elements and the Beams of the template to the (empty) Accelerator `acc`, tuned with `point`
+	 *
+	 * Throws `EXCEPTIONS::TEMPLATE_NOT_COMPILED` if LatticeTemplate::compile() was not called before
+	 */
+
+	void instantiate(Accelerator & acc, SweepPoint const& point) const;
+
+	/**
+	 * Returns a new Accelerator instantiated with `point` (see LatticeTemplate::instantiate())
+	 */
+
+	std::unique_ptr<Accelerator> instantiate(SweepPoint const& point) const;
+
+private:
+
+	/****************************************************************
+	 * Private types
+	 ****************************************************************/
+
+	/**
+	 * Kinds of elements supported by the template
+	 */
+
+	enum class ElementKind { STRAIGHT, FRODO, DIPOLE };
+
+	/**
+	 * Fixed geometry of an element of the template
+	 */
+
+	struct ElementSlot {
+		ElementKind kind;
+		Vector3D posIn;
+		Vector3D posOut;
+		double radius;
+		double curvature;	// Only used by dipoles
+	};
+
+	/**
+	 * Beam of the template
+	 */
+
+	struct BeamSlot {
+		std::shared_ptr<Particle> defaultParticle_ptr;
+		size_t particleCount;
+		double lambda;
+	};
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	/**
+	 * Ordered elements of the ring
+	 */
+
+	std::vector<ElementSlot> elements;
+
+	/**
+	 * Beams of the ring
+	 */
+
+	std::vector<BeamSlot> beams;
+
+	/**
+	 * Method used for the instantiated Accelerators
+	 */
+
+	bool const methodChapi;
+
+	/**
+	 * Beam construction used for the instantiated Accelerators
+	 */
+
+	bool const beamFromParticle;
+
+	/**
+	 * Has the geometry been validated ?
+	 */
+
+	bool compiled;
+};
+
+#endif
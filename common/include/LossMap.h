@@ -0,0 +1,172 @@
+#ifndef LOSSMAP_H
+#define LOSSMAP_H
+
+#pragma once
+
+#include <vector>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+// Forward declaration
+class Particle;
+class Element;
+
+#include "globals.h"
+#include "exceptions.h"
+
+/**
+ * Where the Particles of an Accelerator are lost: number of macroparticles lost in each Element,
+ * with their distribution around the ideal trajectory at the moment of the loss
+ *
+ * For each Element, two histograms of the transverse offset of the lost Particles from the ideal trajectory:
+ *
+ * - radial : offset along the normal direction of the Element (see Element::getNormalDirection()), from -radius to +radius
+ * - azimuthal : angle of the offset around the ideal trajectory, from -pi to pi, 0 being along the normal direction
+ *   and pi/2 upwards
+ *
+ * The losses are recorded by Beam::clearDeadParticles() on the thread which steps the Accelerator, so the counters
+ * are plain integers: nothing is done for the Particles which are not lost.
+ * The simulated time is counted by Accelerator::step(), for the loss rates.
+ */
+
+class LossMap {
+public:
+
+	/****************************************************************
+	 * Constructors
+	 ****************************************************************/
+
+	/**
+	 * Constructor of an empty map, with `radialBins` and `azimuthalBins` bins per Element
+	 *
+	 * Throws `EXCEPTIONS::BAD_LOSS_MAP` if `radialBins` or `azimuthalBins` is 0
+	 *
+	 * The constructor is explicit to prevent accidental type casting.
+	 */
+
+	explicit LossMap(size_t radialBins = GLOBALS::LOSS_BINS, size_t azimuthalBins = GLOBALS::LOSS_BINS);
+
+	/****************************************************************
+	 * Getters
+	 ****************************************************************/
+
+	size_t getElementCount() const;
+
+	size_t getRadialBinCount() const;
+
+	size_t getAzimuthalBinCount() const;
+
+	/**
+	 * Returns the simulated time over which the losses were counted (s)
+	 */
+
+	double getTime() const;
+
+	/**
+	 * Returns the number of macroparticles lost in the Element at index `element`
+	 *
+	 * Throws `EXCEPTIONS::NO_ELEMENT` if there is no such Element
+	 */
+
+	std::uint64_t getLosses(size_t element) const;
+
+	/**
+	 * Returns the number of macroparticles lost in the whole Accelerator
+	 */
+
+	std::uint64_t getTotalLosses() const;
+
+	/**
+	 * Returns the largest number of macroparticles lost in a single Element (e.g. to scale a colour map)
+	 */
+
+	std::uint64_t getMaxLosses() const;
+
+	/**
+	 * Returns the number of macroparticles lost per second of simulated time in the Element at index `element`, 0 before any step
+	 *
+	 * Throws `EXCEPTIONS::NO_ELEMENT` if there is no such Element
+	 */
+
+	double getLossRate(size_t element) const;
+
+	/**
+	 * Returns the radial histogram of the losses in the Element at index `element`
+	 *
+	 * Throws `EXCEPTIONS::NO_ELEMENT` if there is no such Element
+	 */
+
+	std::vector<std::uint64_t> getRadialHistogram(size_t element) const;
+
+	/**
+	 * Returns the azimuthal histogram of the losses in the Element at index `element`
+	 *
+	 * Throws `EXCEPTIONS::NO_ELEMENT` if there is no such Element
+	 */
+
+	std::vector<std::uint64_t> getAzimuthalHistogram(size_t element) const;
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Changes the number of Elements, keeping the losses of the Elements which remain
+	 */
+
+	void resize(size_t elementCount);
+
+	/**
+	 * Counts the loss of `particle` in `element`, the Element it is in
+	 *
+	 * The Element must be one of the map
+	 */
+
+	void record(Particle const& particle, Element const& element);
+
+	/**
+	 * Adds `dt` to the simulated time
+	 */
+
+	void advance(double dt);
+
+	/**
+	 * Forgets the losses and the simulated time, keeping the Elements
+	 */
+
+	void reset();
+
+	/**
+	 * Writes one CSV line per Element which lost Particles:
+	 *
+	 * losses,step,time,element,count,rate,radial bins...,azimuthal bins...
+	 *
+	 * To be called at intervals, the counts being cumulated since the last LossMap::reset()
+	 */
+
+	void write(std::ostream & stream, std::uint64_t step) const;
+
+private:
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	size_t radialBins;
+	size_t azimuthalBins;
+
+	double time;
+
+	/**
+	 * Losses of each Element, and the histograms of all the Elements one after the other
+	 */
+
+	std::vector<std::uint64_t> losses;
+	std::vector<std::uint64_t> radial;
+	std::vector<std::uint64_t> azimuthal;
+};
+
+#endif
@@ -14,10 +14,14 @@
 #include <QOpenGLShaderProgram>
 // Maths !!
 #include <QMatrix4x4>
+// Phase space panel
+#include <QOpenGLTexture>
+#include <QOpenGLPixelTransferOptions>
 // Timer
 #include <QTime>
 
 #include <vector>
+#include <memory>
 #include <cmath>
 
 class Vector3D;
@@ -33,6 +37,7 @@ class Frodo;
 class Beam;
 class Accelerator;
 class Renderer;
+class LossMap;
 
 class Transform3D;
 class Camera3D;
@@ -43,6 +48,9 @@ class Camera3D;
 // Use class field size (otherwise compiler-chan in vewwy confusion)
 #include "include/bundle/Transform3D.bundle.h"
 #include "include/bundle/Camera3D.bundle.h"
+#include "include/bundle/Frustum.bundle.h"
+#include "include/bundle/TrailHistory.bundle.h"
+#include "include/bundle/PhaseSpaceHistogram.bundle.h"
 
 #include "globals.h"
 
@@ -194,18 +202,91 @@ public:
 	void drawAxes();
 
 	/**
-	 * Draw a generalized cylinder (Geometry::Penne)
+	 * Draw a generalized cylinder (Geometry::Penne) at the level of detail `lod`
 	 */
 
-	void drawCylinder(QVector3D const& posIn, QVector3D const& posOut, double radius);
+	void drawCylinder(QVector3D const& posIn, QVector3D const& posOut, double radius, size_t lod = 0);
 
 	/**
-	 * Draw a generalized torus (Geometry::Macaroni)
+	 * Draw a generalized torus (Geometry::Macaroni) at the level of detail `lod`
 	 */
 
-	void drawTorus(QVector3D const& center, double startAngle, double totalAngle, double curvature, double innerRadius);
+	void drawTorus(QVector3D const& center, double startAngle, double totalAngle, double curvature, double innerRadius, size_t lod = 0);
+
+	/**
+	 * Records the positions of the particles of `acc` in the trail buffer and draws the trails with a single draw call
+	 * (see TrailHistory)
+	 */
+
+	void drawTrails(Accelerator const& acc);
+
+	/**
+	 * Draws the phase space panel: the (r, vr) and (z, vz) histograms of each Beam, in the bottom left corner of the view
+	 *
+	 * Only the histograms of a new pass are uploaded (see PhaseSpaceHistogram::getPassCount())
+	 */
+
+	void drawPhaseSpace(std::vector<PhaseSpaceHistogram> const& histograms);
+
+	/****************************************************************
+	 * Trails
+	 ****************************************************************/
+
+	/**
+	 * Returns the number of frames of the trails behind the particles, 0 if they are hidden
+	 */
+
+	size_t getTrailLength() const;
+
+	/**
+	 * Changes the number of frames of the trails behind the particles, 0 hiding them
+	 *
+	 * Throws `EXCEPTIONS::BAD_TRAIL_LENGTH` if the length is more than `GRAPHICS::TRAIL_MAX_LENGTH`
+	 */
+
+	void setTrailLength(size_t length);
+
+	/****************************************************************
+	 * Loss map
+	 ****************************************************************/
+
+	/**
+	 * Colours the Elements from their base colour to red, in proportion to their losses in `lossMap_ptr`
+	 * (see LossMap::getMaxLosses()), nullptr hiding the loss map
+	 *
+	 * The LossMap must outlive the renderer or be unset before it is destroyed
+	 */
+
+	void setLossMap(LossMap const* lossMap_ptr);
+
+	/****************************************************************
+	 * Culling and level of detail
+	 ****************************************************************/
+
+	/**
+	 * Returns false if the sphere of center `center` and radius `radius` is out of the view of the camera (see Frustum)
+	 */
+
+	bool isVisible(QVector3D const& center, double radius) const;
+
+	/**
+	 * Returns the level of detail of the meshes for an object in the sphere of center `center` and radius `radius`,
+	 * chosen from the size of its projection on the view (see GRAPHICS::LOD_SIZE)
+	 */
+
+	size_t getLevelOfDetail(QVector3D const& center, double radius) const;
 
 private:
+	/****************************************************************
+	 * Private methods
+	 ****************************************************************/
+
+	/**
+	 * Sets the colour of `element`, tinted by its losses when the loss map is shown
+	 */
+
+	void setElementColor(Element const& element, double red, double green, double blue);
+
 	/****************************************************************
 	  * OpenGL state information (buffers and vertex array objects)
 	  ****************************************************************/
@@ -228,6 +309,54 @@ private:
 
 	QOpenGLShaderProgram * program;
 
+	/**
+	 * Trail positions, one slot of the ring of TrailHistory rewritten per frame
+	 */
+
+	QOpenGLBuffer trailBuffer;
+
+	/**
+	 * Trail segments (see TrailHistory::getIndices())
+	 */
+
+	QOpenGLBuffer trailIndices;
+
+	/**
+	 * Trail vertex array object, with positions only
+	 */
+
+	QOpenGLVertexArrayObject trailObject;
+
+	/**
+	 * Phase space panel shader program
+	 */
+
+	QOpenGLShaderProgram * panelProgram;
+
+	/**
+	 * Unit square of the panels
+	 */
+
+	QOpenGLBuffer panelBuffer;
+
+	/**
+	 * Panel vertex array object
+	 */
+
+	QOpenGLVertexArrayObject panelObject;
+
+	/**
+	 * Histogram textures, (r, vr) then (z, vz) for each Beam
+	 */
+
+	std::vector<std::unique_ptr<QOpenGLTexture>> phaseSpaceTextures;
+
+	/**
+	 * Pass of each PhaseSpaceHistogram in the textures
+	 */
+
+	std::vector<size_t> phaseSpacePasses;
+
 	/****************************************************************
 	 * Buffer offsets
 	 ****************************************************************/
@@ -245,22 +374,22 @@ private:
 	int offsetSpaghetti;
 
 	/**
-	 * Penne geometry offset in buffer
+	 * Penne geometry offset in buffer, for each level of detail
 	 */
 
-	int offsetPenne;
+	int offsetPenne[GRAPHICS::LOD_COUNT];
 
 	/**
-	 * Macaroni geometry offset in buffer
+	 * Macaroni geometry offset in buffer, for each level of detail
 	 */
 
-	int offsetMacaroni;
+	int offsetMacaroni[GRAPHICS::LOD_COUNT];
 
 	/**
-	 * Pancake geometry offset in buffer
+	 * Pancake geometry offset in buffer, for each level of detail
 	 */
 
-	int offsetPancake;
+	int offsetPancake[GRAPHICS::LOD_COUNT];
 
 	/**
 	 * Pea geometry offset in buffer
@@ -290,6 +419,36 @@ private:
 
 	QMatrix4x4 projection;
 
+	/**
+	 * Width / height of the view
+	 */
+
+	double aspectRatio;
+
+	/**
+	 * View frustum of the current frame, updated by OpenGLRenderer::begin()
+	 */
+
+	Frustum frustum;
+
+	/****************************************************************
+	 * Trails
+	 ****************************************************************/
+
+	TrailHistory trails;
+
+	/****************************************************************
+	 * Loss map
+	 ****************************************************************/
+
+	LossMap const* lossMap_ptr;
+
+	/**
+	 * Frodo being drawn, whose losses colour its sub-elements when they are not indexed in the Accelerator (not flattened)
+	 */
+
+	Frodo const* frodo_ptr;
+
 	/****************************************************************
 	 * Timer
 	 ****************************************************************/
@@ -8,6 +8,9 @@
 #include <memory>
 #include <string>
 #include <sstream>
+#include <vector>
+#include <cstdint>
+#include <limits>
 
 // Forward declaration
 class Vector3D;
@@ -17,14 +20,26 @@ class Renderer;
 
 #include "globals.h"
 #include "exceptions.h"
+#include "include/ParticleRecord.h"
+#include "include/Arena.h"
 
 /**
  * The Particle Class represents a particle evolving in the 3D carthesian space
+ *
+ * A Particle in an Accelerator knows its Element by the index of the Element in the table of Elements of the Accelerator
+ * (see Accelerator::getElements()), resolved by the caller (see Particle::getElement()), so that the Particles stay valid
+ * when the table is moved or rebuilt. A standalone Particle may instead point at a standalone Element (see Particle::setElement()).
  */
 
 class Particle : public Drawable {
 public:
 
+	/**
+	 * Index of the Element of a Particle which is in no table of Elements (see Particle::getElementIndex())
+	 */
+
+	static constexpr std::uint32_t NO_ELEMENT = std::numeric_limits<std::uint32_t>::max();
+
 	/****************************************************************
 	 * Constructors
 	 ****************************************************************/
@@ -101,6 +116,62 @@ public:
 
 	virtual std::unique_ptr<Particle> scaledCopy(Vector3D const& pos, double energy, Vector3D speed, double _mass, int charge, double lambda) const;
 
+	/****************************************************************
+	 * Polymorphic copy in an Arena (for Beam)
+	 ****************************************************************/
+
+	/**
+	 * Returns a polymorphic copy of the current Particle constructed in `arena`
+	 *
+	 * The copy belongs to the owner of the Arena, which destroys it with Arena::destroy() and Particle::getSize()
+	 */
+
+	virtual Particle * copy(Arena & arena) const;
+
+	/**
+	 * Returns a polymorphic copy with constructor arguments, constructed in `arena` (see Particle::copy(Arena &))
+	 */
+
+	virtual Particle * scaledCopy(Vector3D const& pos, double energy, Vector3D speed, double _mass, int charge, double lambda, Arena & arena) const;
+
+	/**
+	 * Returns the size of the dynamic type of the Particle, for Arena::destroy()
+	 */
+
+	virtual size_t getSize() const;
+
+	/****************************************************************
+	 * Flat copy (ParticleRecord)
+	 ****************************************************************/
+
+	/**
+	 * Returns the dynamic type of the Particle
+	 */
+
+	virtual ParticleKind getKind() const;
+
+	/**
+	 * Returns a ParticleRecord containing the position, momentum, mass, charge and type of the Particle
+	 *
+	 * The fields which depend on the Accelerator (progress, beam, element, beamCharge) are set to 0
+	 */
+
+	ParticleRecord toRecord() const;
+
+	/**
+	 * Returns a new Particle of the type given by `record.kind`, with exactly the position, momentum, mass and charge of the record
+	 *
+	 * The Particle does not point to any Element
+	 */
+
+	static std::unique_ptr<Particle> fromRecord(ParticleRecord const& record, Renderer * engine_ptr = nullptr);
+
+	/**
+	 * Same as Particle::fromRecord(), the Particle being constructed in `arena` (see Particle::copy(Arena &))
+	 */
+
+	static Particle * fromRecord(ParticleRecord const& record, Arena & arena, Renderer * engine_ptr = nullptr);
+
 	/****************************************************************
 	 * Getters (SI units)
 	 ****************************************************************/
@@ -160,25 +231,58 @@ public:
 	Vector3D getPos() const;
 
 	/**
-	 * Returns a pointer (for polymorphism purposes) to the Element the Particle is in
+	 * Returns a pointer (for polymorphism purposes) to the standalone Element the Particle is in (see Particle::setElement())
 	 *
-	 * Used primarily in Accelerator::updateParticleElement()
+	 * Throws `EXCEPTIONS::NULLPTR` if the Particle is not in a standalone Element, e.g. if it is in an Accelerator
 	 *
 	 * Return: pointer on a constant Element to prevent mistakes (and hoping not to transgress the principles of the OOP)
 	 */
 
 	Element const * getElementPtr() const;
 
+	/**
+	 * Returns the index of the Element the Particle is in, in the table of Elements of its Accelerator,
+	 * Particle::NO_ELEMENT if the Particle is in no table
+	 */
+
+	std::uint32_t getElementIndex() const;
+
+	/**
+	 * Returns the Element the Particle is in: the Element at its index in `lattice`, or its standalone Element if it has no index
+	 *
+	 * Throws `EXCEPTIONS::NO_ELEMENT` if the index is out of `lattice`, and `EXCEPTIONS::NULLPTR` if the Particle is in no Element
+	 */
+
+	Element const& getElement(std::vector<Element *> const& lattice) const;
+
+	/**
+	 * Returns the progress of the Particle in its Element (between 0 and 1), as of the last Element::updatePointedElement()
+	 */
+
+	double getElementProgress() const;
+
 	/****************************************************************
 	 * Setters
 	 ****************************************************************/
 
 	/**
-	 * Make the particle point a given element pointer
+	 * Make the particle point a given standalone element pointer, forgetting its index (see Particle::getElementIndex())
 	 */
 
 	void setElement(Element * element_ptr);
 
+	/**
+	 * Puts the Particle in the Element at index `element` of the table of Elements of its Accelerator, forgetting its standalone Element
+	 */
+
+	void setElementIndex(std::size_t element);
+
+	/**
+	 * Sets the progress of the Particle in its Element
+	 */
+
+	void setElementProgress(double elementProgress);
+
 	/****************************************************************
 	 * Methods
 	 ****************************************************************/
@@ -194,7 +298,8 @@ public:
 	 ****************************************************************/
 
 	/**
-	 * Integrates the movement equations over a time step `dt`, which defaults to `GLOBALS::DT(1e-11)`.
+	 * Integrates the movement equations over a time step `dt`, which defaults to `GLOBALS::DT(1e-11)`, in the field of the standalone Element
+	 * (see Particle::setElement()). The Particles of an Accelerator are given their field (see Beam::step()).
 	 *
 	 * We need the methodChapi for the getField (if it's a FODO element)
 	 *
@@ -203,6 +308,13 @@ public:
 
 	void step(double dt = GLOBALS::DT, bool methodChapi = false);
 
+	/**
+	 * Same as Particle::step(), in the magnetic field `B` given by the caller instead of the field of the Element
+	 * (see Element::getFields())
+	 */
+
+	void step(double dt, Vector3D const& B);
+
 	/**
 	 * Exerts a force onto a particle until the next `step` is called.
 	 */
@@ -239,6 +351,16 @@ public:
 
 private:
 
+	/****************************************************************
+	 * Private methods (flat copy)
+	 ****************************************************************/
+
+	/**
+	 * Overwrites the mass, charge and momentum with the ones of `record` (see Particle::fromRecord())
+	 */
+
+	void loadRecord(ParticleRecord const& record);
+
 	/****************************************************************
 	 * Attributes
 	 ****************************************************************/
@@ -276,11 +398,23 @@ private:
 	Vector3D forces;
 
 	/**
-	 * Pointer on the Element the Particle is in
+	 * Pointer on the standalone Element the Particle is in, nullptr in an Accelerator
 	 */
 
 	Element * element_ptr;
 
+	/**
+	 * Index of the Element the Particle is in, in the table of Elements of its Accelerator
+	 */
+
+	std::uint32_t element;
+
+	/**
+	 * Progress in the Element the Particle is in (see Element::getParticleProgress())
+	 */
+
+	double elementProgress;
+
 };
 
 /****************************************************************
@@ -298,6 +432,10 @@ public:
 	virtual void draw(Renderer * engine_ptr = nullptr) const override;
 	virtual std::unique_ptr<Particle> copy() const override;
 	virtual std::unique_ptr<Particle> scaledCopy(Vector3D const& pos, double energy, Vector3D speed, double _mass, int charge, double lambda) const override;
+	virtual Particle * copy(Arena & arena) const override;
+	virtual Particle * scaledCopy(Vector3D const& pos, double energy, Vector3D speed, double _mass, int charge, double lambda, Arena & arena) const override;
+	virtual size_t getSize() const override;
+	virtual ParticleKind getKind() const override;
 };
 
 /**
@@ -311,6 +449,10 @@ public:
 	virtual void draw(Renderer * engine_ptr = nullptr) const override;
 	virtual std::unique_ptr<Particle> copy() const override;
 	virtual std::unique_ptr<Particle> scaledCopy(Vector3D const& pos, double energy, Vector3D speed, double _mass, int charge, double lambda) const override;
+	virtual Particle * copy(Arena & arena) const override;
+	virtual Particle * scaledCopy(Vector3D const& pos, double energy, Vector3D speed, double _mass, int charge, double lambda, Arena & arena) const override;
+	virtual size_t getSize() const override;
+	virtual ParticleKind getKind() const override;
 };
 
 /**
@@ -324,6 +466,10 @@ public:
 	virtual void draw(Renderer * engine_ptr = nullptr) const override;
 	virtual std::unique_ptr<Particle> copy() const override;
 	virtual std::unique_ptr<Particle> scaledCopy(Vector3D const& pos, double energy, Vector3D speed, double _mass, int charge, double lambda) const override;
+	virtual Particle * copy(Arena & arena) const override;
+	virtual Particle * scaledCopy(Vector3D const& pos, double energy, Vector3D speed, double _mass, int charge, double lambda, Arena & arena) const override;
+	virtual size_t getSize() const override;
+	virtual ParticleKind getKind() const override;
 };
 
 /****************************************************************
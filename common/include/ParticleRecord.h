@@ -0,0 +1,39 @@
+#ifndef PARTICLERECORD_H
+#define PARTICLERECORD_H
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * Dynamic type of a Particle, so that it can be rebuilt from a ParticleRecord
+ */
+
+enum class ParticleKind : std::uint32_t { PARTICLE, PROTON, ANTIPROTON, ELECTRON };
+
+/**
+ * Flat, pointer-free copy of the state of a Particle in an Accelerator
+ *
+ * Records are trivially copyable, so they can be exchanged as raw bytes (shared memory, sockets, MPI)
+ * and stored in preallocated buffers without touching the heap.
+ *
+ * See Particle::toRecord(), Particle::fromRecord() and Accelerator::exportParticles()
+ */
+
+struct ParticleRecord {
+	double pos[3];				// Position (m)
+	double momentum[3];			// Momentum, as stored by Particle (mass * speed)
+	double mass;				// Mass (kg)
+	double progress;			// Progress in the Accelerator (see Accelerator::getParticleProgress())
+	double beamCharge;			// Charge used for the interactions (see Beam::getCharge())
+	std::int32_t charge;		// Number of elementary charges
+	ParticleKind kind;			// Dynamic type of the Particle
+	std::uint32_t beam;			// Id of the Beam containing the Particle (see Beam::getId())
+	std::uint32_t element;		// Index of the Element the Particle is in
+	std::uint32_t id;			// Id of the Particle in its Beam, which does not change when the Particles are reordered (see Beam::getParticleId())
+};
+
+static_assert(std::is_trivially_copyable<ParticleRecord>::value, "ParticleRecord must be exchangeable as raw bytes");
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+	#include <unistd.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <linux/perf_event.h>
+#endif
+
+#include "globals.h"
+#include "exceptions.h"
+
+/**
+ * Hardware events read by PerfCounters
+ */
+
+enum class PerfEvent {
+	CYCLES,				// CPU cycles
+	INSTRUCTIONS,		// Retired instructions
+	L1D_MISSES,			// Level 1 data cache read misses
+	LLC_MISSES,			// Last level cache misses
+	BRANCH_MISSES,		// Mispredicted branches
+	COUNT				// Number of events (not an event)
+};
+
+/**
+ * Values of the PerfEvents, indexed by `size_t(PerfEvent)`
+ */
+
+typedef std::array<std::uint64_t, size_t(PerfEvent::COUNT)> PerfSample;
+
+/**
+ * Hardware performance counters of the calling thread (Linux `perf_event_open`, user space only)
+ *
+ * The counters are opened as one group, so that they are read at once and count the same instructions.
+ * Each event which cannot be opened (no PMU, e.g. in a virtual machine or a container, or `perf_event_paranoid` too high)
+ * is left out: PerfCounters::isAvailable() tells which ones are counted, and the others always read 0.
+ * On other systems, none of them is available.
+ *
+ * The counts are scaled if the kernel had to multiplex the counters.
+ */
+
+class PerfCounters {
+public:
+
+	/****************************************************************
+	 * Constructors and destructors
+	 ****************************************************************/
+
+	/**
+	 * Opens and starts the counters for the calling thread
+	 */
+
+	PerfCounters();
+
+	/**
+	 * Closes the counters
+	 */
+
+	~PerfCounters();
+
+	/**
+	 * File descriptors cannot be copied
+	 */
+
+	PerfCounters(PerfCounters const&) = delete;
+
+	/**
+	 * File descriptors cannot be copied
+	 */
+
+	PerfCounters& operator = (PerfCounters const&) = delete;
+
+	/****************************************************************
+	 * Getters
+	 ****************************************************************/
+
+	/**
+	 * Returns true if at least one event is counted
+	 */
+
+	bool isAvailable() const;
+
+	/**
+	 * Returns true if the event is counted
+	 */
+
+	bool isAvailable(PerfEvent event) const;
+
+	/**
+	 * Returns the name of an event
+	 */
+
+	static char const* getName(PerfEvent event);
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Returns the values of the counters since their opening (0 for the unavailable events)
+	 */
+
+	PerfSample read() const;
+
+	/**
+	 * Returns `end - start` for each event
+	 */
+
+	static PerfSample difference(PerfSample const& start, PerfSample const& end);
+
+private:
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	/**
+	 * File descriptor of each event (-1 if unavailable), the first opened one leads the group
+	 */
+
+	std::array<int, size_t(PerfEvent::COUNT)> descriptors;
+
+	/**
+	 * File descriptor of the leader of the group (-1 if no event is available)
+	 */
+
+	int leader;
+
+	/**
+	 * Position of each event in the values read from the group
+	 */
+
+	std::array<size_t, size_t(PerfEvent::COUNT)> positions;
+
+	/**
+	 * Number of events in the group
+	 */
+
+	size_t openCount;
+};
+
+#endif
@@ -0,0 +1,169 @@
+#ifndef PHASESPACEDISTRIBUTION_H
+#define PHASESPACEDISTRIBUTION_H
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+// Forward declaration
+class Vector3D;
+class Philox;
+
+#include "globals.h"
+#include "exceptions.h"
+
+/**
+ * Shape of a PhaseSpaceDistribution
+ *
+ * - GAUSSIAN : independent normal laws in both planes, truncated at PhaseSpaceDistribution::getTruncation() sigmas
+ * - WATERBAG : uniform density inside a 4D hyperellipsoid (bounded, no tails)
+ */
+
+enum class DistributionShape { GAUSSIAN, WATERBAG };
+
+/**
+ * Offsets of one Particle from the ideal trajectory
+ *
+ * r and vr are along the horizontal normal of the Element (see Element::getNormalDirection()), z and vz along the vertical axis,
+ * with the conventions of Beam::getEmittanceR() and Beam::getEmittanceZ()
+ */
+
+struct PhaseSpaceSample {
+	double r;				// Horizontal offset (m)
+	double vr;				// Horizontal speed (m/s)
+	double z;				// Vertical offset (m)
+	double vz;				// Vertical speed (m/s)
+	double energyFactor;	// Energy of the Particle / nominal energy
+};
+
+/**
+ * Transverse phase space distribution of the Particles of a Beam, matched to given emittances and ellipse coefficients
+ *
+ * The ellipse of each plane is given as returned by Beam::getEllipsePhaseCoefR() and Beam::getEllipsePhaseCoefZ()
+ * (X-coord : A11, Y-coord : A22, Z-coord : A12), so that a generated Beam gives back the same values:
+ *
+ * - <r²> = A22 * emittance
+ * - <vr²> = A11 * emittance
+ * - <r * vr> = -A12 * emittance
+ *
+ * The samples come from a Philox generator: the i-th sample only depends on the seed and on i.
+ */
+
+class PhaseSpaceDistribution {
+public:
+
+	/****************************************************************
+	 * Constructors
+	 ****************************************************************/
+
+	/**
+	 * Constructor of a distribution without any spread (all the Particles on the ideal trajectory)
+	 *
+	 * The constructor is explicit to prevent accidental type casting.
+	 */
+
+	explicit PhaseSpaceDistribution(DistributionShape shape = DistributionShape::GAUSSIAN, std::uint64_t seed = 0);
+
+	/****************************************************************
+	 * Getters
+	 ****************************************************************/
+
+	DistributionShape getShape() const;
+
+	std::uint64_t getSeed() const;
+
+	/**
+	 * Returns the number of sigmas at which the GAUSSIAN shape is cut
+	 */
+
+	double getTruncation() const;
+
+	/****************************************************************
+	 * Setters
+	 ****************************************************************/
+
+	/**
+	 * Sets the emittance and the ellipse coefficients (A11, A22, A12) of the horizontal plane
+	 *
+	 * Throws `EXCEPTIONS::BAD_EMITTANCE` if the emittance is negative,
+	 * `EXCEPTIONS::BAD_ELLIPSE` if the coefficients do not describe an ellipse (A22 <= 0 or A11 * A22 - A12² <= 0)
+	 */
+
+	void setR(double emittance, Vector3D const& ellipseCoef);
+
+	/**
+	 * Same as PhaseSpaceDistribution::setR() for the vertical plane
+	 */
+
+	void setZ(double emittance, Vector3D const& ellipseCoef);
+
+	/**
+	 * Sets the rms relative energy spread (normal law, truncated like the transverse planes)
+	 */
+
+	void setEnergySpread(double energySpread);
+
+	/**
+	 * Sets the number of sigmas at which the GAUSSIAN shape is cut (e.g. to stay inside the aperture)
+	 */
+
+	void setTruncation(double truncation);
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Returns the offsets of the `index`-th Particle
+	 */
+
+	PhaseSpaceSample sample(std::uint64_t index) const;
+
+private:
+
+	/****************************************************************
+	 * Private types
+	 ****************************************************************/
+
+	/**
+	 * Linear map from two normalized coordinates to (position, speed) in one plane
+	 *
+	 * position = a * u1, speed = b * u1 + c * u2
+	 */
+
+	struct Plane {
+		double a;
+		double b;
+		double c;
+	};
+
+	/****************************************************************
+	 * Private methods
+	 ****************************************************************/
+
+	/**
+	 * Returns the map of a plane from its emittance and ellipse coefficients
+	 */
+
+	static Plane matchedPlane(double emittance, Vector3D const& ellipseCoef);
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	DistributionShape const shape;
+
+	std::uint64_t const seed;
+
+	Plane planeR;
+
+	Plane planeZ;
+
+	double energySpread;
+
+	double truncation;
+};
+
+#endif
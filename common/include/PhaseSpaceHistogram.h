@@ -0,0 +1,182 @@
+#ifndef PHASESPACEHISTOGRAM_H
+#define PHASESPACEHISTOGRAM_H
+
+#pragma once
+
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+// Forward declaration
+class Beam;
+
+#include "globals.h"
+#include "exceptions.h"
+
+/**
+ * Phase space planes of a Beam
+ *
+ * - R : (r, vr), projected on the normal direction of the Element (see Beam::getPhaseR())
+ * - Z : (z, vz) (see Beam::getPhaseZ())
+ */
+
+enum class PhasePlane { R, Z };
+
+/**
+ * Bounds of the histogram of a PhasePlane
+ */
+
+struct PhaseRange {
+	double min;
+	double max;
+	double speedMin;
+	double speedMax;
+};
+
+/**
+ * 2D histograms of the density of a Beam in its (r, vr) and (z, vz) phase spaces, for the phase space panel of the viewer
+ *
+ * The histograms are built incrementally: each call to PhaseSpaceHistogram::update() bins the Particles of the next `chunk` ids
+ * (see Beam::getParticleId()), so that the phase space computations per frame stay bounded whatever the size of the Beam.
+ * Once every Particle was binned (a pass), the histograms are published, with an 8-bit image of each, and the next pass starts
+ * with the bounds measured during this one. The first pass only measures the bounds.
+ *
+ * The Particles are walked by id rather than by index, as the Beam moves them between two updates (losses, Beam::reorder(), ...):
+ * each Particle is binned once per pass, except those lost before their turn and those received with an id already walked.
+ */
+
+class PhaseSpaceHistogram {
+public:
+
+	/****************************************************************
+	 * Constructors
+	 ****************************************************************/
+
+	/**
+	 * Constructor of histograms of `bins` x `bins` bins, binning `chunk` Particles per update
+	 *
+	 * Throws `EXCEPTIONS::BAD_HISTOGRAM` if `bins` or `chunk` is 0
+	 *
+	 * The constructor is explicit to prevent accidental type casting.
+	 */
+
+	explicit PhaseSpaceHistogram(size_t bins = GRAPHICS::PHASE_SPACE_BINS, size_t chunk = GLOBALS::PHASE_SPACE_CHUNK);
+
+	/****************************************************************
+	 * Getters
+	 ****************************************************************/
+
+	/**
+	 * Returns the number of bins along each axis
+	 */
+
+	size_t getBins() const;
+
+	/**
+	 * Returns the number of published passes
+	 */
+
+	size_t getPassCount() const;
+
+	/**
+	 * Returns the counts of the last pass, row by row (the rows along the speed, the columns along the position)
+	 */
+
+	std::vector<std::uint32_t> const& getCounts(PhasePlane plane) const;
+
+	/**
+	 * Returns the counts of the last pass as an 8-bit image (logarithmic scale, 255 in the fullest bin),
+	 * ready to be uploaded as a texture
+	 */
+
+	std::vector<std::uint8_t> const& getImage(PhasePlane plane) const;
+
+	/**
+	 * Returns the bounds of the last pass
+	 */
+
+	PhaseRange const& getRange(PhasePlane plane) const;
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Bins the Particles of `beam` whose ids are the next `chunk` ones
+	 *
+	 * Returns true if a pass was completed and new histograms published
+	 */
+
+	bool update(Beam const& beam);
+
+	/**
+	 * Forgets the histograms and the bounds, for a new Beam
+	 */
+
+	void reset();
+
+private:
+
+	/****************************************************************
+	 * Private types
+	 ****************************************************************/
+
+	/**
+	 * Histogram of a PhasePlane
+	 */
+
+	struct Plane {
+		std::vector<std::uint32_t> counts;
+		std::vector<std::uint32_t> building;
+		std::vector<std::uint8_t> image;
+		PhaseRange range;		// Bounds of the published histogram
+		PhaseRange binning;		// Bounds of the histogram being built
+		PhaseRange measuring;	// Bounds of the Particles binned in this pass
+	};
+
+	/****************************************************************
+	 * Private methods
+	 ****************************************************************/
+
+	/**
+	 * Bins the point (`position`, `speed`) in the histogram being built and widens the bounds being measured
+	 */
+
+	void add(Plane & plane, double position, double speed);
+
+	/**
+	 * Publishes the histogram being built and starts a new one
+	 */
+
+	void publish(Plane & plane);
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	size_t bins;
+
+	size_t chunk;
+
+	/**
+	 * Id of the next Particle to bin
+	 */
+
+	size_t cursor;
+
+	size_t passCount;
+
+	/**
+	 * Are the bounds known (i.e. did the first pass end) ?
+	 */
+
+	bool ranged;
+
+	std::array<Plane, 2> planes;
+};
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cmath>
+
+#include "globals.h"
+#include "exceptions.h"
+
+/**
+ * Philox4x32-10 counter-based random number generator (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", 2011)
+ *
+ * There is no state to advance: the numbers are a pure function of a key (the seed) and a 128-bit counter.
+ * The i-th sample can thus be drawn by any thread, in any order, and is the same whatever the number of threads.
+ */
+
+class Philox {
+public:
+
+	/****************************************************************
+	 * Types
+	 ****************************************************************/
+
+	/**
+	 * Four 32-bit words: the counter given to the generator, or the random words it returns
+	 */
+
+	typedef std::array<std::uint32_t, 4> Block;
+
+	/****************************************************************
+	 * Constructors
+	 ****************************************************************/
+
+	/**
+	 * Constructor with the 64-bit key
+	 *
+	 * The constructor is explicit to prevent accidental type casting.
+	 */
+
+	explicit Philox(std::uint64_t seed = 0);
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Returns the four random words of a counter
+	 */
+
+	Block operator () (Block const& counter) const;
+
+	/**
+	 * Returns the four random words of the counter (`index`, `draw`), e.g. the `draw`-th block of the `index`-th particle
+	 */
+
+	Block operator () (std::uint64_t index, std::uint64_t draw) const;
+
+	/**
+	 * Returns two uniform numbers in ]0, 1[ (53 random bits each) from one block
+	 */
+
+	static std::array<double, 2> uniforms(Block const& block);
+
+	/**
+	 * Returns two independent standard normal numbers from one block (Box-Muller)
+	 */
+
+	static std::array<double, 2> normals(Block const& block);
+
+private:
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	/**
+	 * Key (seed)
+	 */
+
+	std::array<std::uint32_t, 2> key;
+};
+
+#endif
@@ -0,0 +1,366 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <iomanip>
+
+// Forward declaration
+class PerfCounters;
+
+#include "globals.h"
+#include "exceptions.h"
+
+/****************************************************************
+ * Instrumentation macros
+ ****************************************************************/
+
+/**
+ * The instrumentation of the simulation is only compiled with `PROFILING` defined (`qmake CONFIG+=profiling`),
+ * otherwise the macros below expand to nothing and the simulation does not pay anything
+ *
+ * - PROFILE_SCOPE(phase) : times the rest of the enclosing block as the ProfilerPhase `phase`
+ * - PROFILE_COUNT(counter, n) : adds `n` to the ProfilerCounter `counter`
+ * - PROFILE_SAMPLE() : records the current values of the counters in the trace
+ */
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef PROFILING
+	#define PROFILE_SCOPE(phase) ProfilerScope const PROFILE_CONCAT(profilerScope, __LINE__)(phase)
+	#define PROFILE_COUNT(counter, n) Profiler::local().count(counter, n)
+	#define PROFILE_SAMPLE() Profiler::local().sample()
+#else
+	#define PROFILE_SCOPE(phase)
+	#define PROFILE_COUNT(counter, n)
+	#define PROFILE_SAMPLE()
+#endif
+
+/****************************************************************
+ * Phases and counters
+ ****************************************************************/
+
+/**
+ * Timed phases of a step of the simulation
+ */
+
+enum class ProfilerPhase {
+	ACCELERATOR_STEP,			// The whole Accelerator::step()
+	UPDATE_POINTED_ELEMENT,		// Beam::updatePointedElement()
+	UPDATE_PROGRESSES,			// Beam::updateProgresses()
+	INTERACTIONS,				// Loop over the pairs of Particles in Accelerator::step()
+	BEAM_STEP,					// The whole Beam::step()
+	PARTICLE_STEP,				// Particle::step() of all the Particles of a Beam
+	CLEAR_DEAD_PARTICLES,		// Beam::clearDeadParticles()
+	CLEAR_DEAD_BEAMS,			// Accelerator::clearDeadBeams()
+	REORDER_PARTICLES,			// Accelerator::reorderParticles()
+	COUNT						// Number of phases (not a phase)
+};
+
+/**
+ * Events counted during the simulation
+ */
+
+enum class ProfilerCounter {
+	INTERACTION_PAIRS,			// Pairs of Particles close enough to interact
+	ELEMENT_TRANSITIONS,		// Particles which changed Element
+	PARTICLES_LOST,				// Particles removed because they touched the wall
+	ARENA_ALLOCATIONS,			// Particles and Elements allocated in an Arena
+	ARENA_BLOCKS,				// Blocks allocated by the Arenas
+	REJECTED_STEPS,				// Steps of the adaptive integration done again with a smaller timestep
+	COUNT						// Number of counters (not a counter)
+};
+
+/****************************************************************
+ * Profiler
+ ****************************************************************/
+
+/**
+ * Per-thread profiler of the simulation: time spent in each ProfilerPhase, number of calls and counters
+ *
+ * Each thread has its own instance (Profiler::local()), so that the simulations run in parallel (e.g. by a Sweep)
+ * do not share anything. The last GLOBALS::PROFILER_EVENTS timed phases are also kept to be exported
+ * in the trace-event format of Chrome (chrome://tracing or https://ui.perfetto.dev).
+ *
+ * The hardware counters of the thread (see PerfCounters) can also be read around each phase,
+ * at the cost of two system calls per phase (Profiler::enableHardwareCounters()).
+ */
+
+class Profiler {
+public:
+
+	/****************************************************************
+	 * Constants
+	 ****************************************************************/
+
+	/**
+	 * True if the simulation is instrumented (`PROFILING` defined)
+	 */
+
+	#ifdef PROFILING
+		static constexpr bool ENABLED = true;
+	#else
+		static constexpr bool ENABLED = false;
+	#endif
+
+	/****************************************************************
+	 * Constructors
+	 ****************************************************************/
+
+	/**
+	 * Constructor of an empty profiler
+	 */
+
+	Profiler();
+
+	/**
+	 * Destructor closing the hardware counters
+	 */
+
+	~Profiler();
+
+	Profiler(Profiler const&) = delete;
+
+	Profiler& operator = (Profiler const&) = delete;
+
+	/**
+	 * Returns the profiler of the calling thread
+	 */
+
+	static Profiler & local();
+
+	/****************************************************************
+	 * Getters
+	 ****************************************************************/
+
+	/**
+	 * Returns the total time spent in a phase (s)
+	 */
+
+	double getTotalTime(ProfilerPhase phase) const;
+
+	/**
+	 * Returns the number of times a phase was timed
+	 */
+
+	std::uint64_t getCallCount(ProfilerPhase phase) const;
+
+	/**
+	 * Returns the value of a counter
+	 */
+
+	std::uint64_t getCount(ProfilerCounter counter) const;
+
+	/**
+	 * Returns the number of timed phases which are not in the trace anymore (more than GLOBALS::PROFILER_EVENTS)
+	 */
+
+	std::uint64_t getDroppedEvents() const;
+
+	/**
+	 * Returns true if the hardware counters are read around the phases
+	 */
+
+	bool hasHardwareCounters() const;
+
+	/**
+	 * Returns the total count of a hardware event in a phase (0 if the event is not available)
+	 */
+
+	std::uint64_t getHardwareCount(ProfilerPhase phase, PerfEvent event) const;
+
+	/**
+	 * Returns the hardware counters of the thread (nullptr if they are not read)
+	 */
+
+	PerfCounters const* getPerfCounters() const;
+
+	/**
+	 * Returns the name of a phase, as written in the trace
+	 */
+
+	static char const* getName(ProfilerPhase phase);
+
+	/**
+	 * Returns the name of a counter, as written in the trace
+	 */
+
+	static char const* getName(ProfilerCounter counter);
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Records a phase which started at `start` and ended at `end` (see Profiler::now())
+	 */
+
+	void record(ProfilerPhase phase, std::int64_t start, std::int64_t end);
+
+	/**
+	 * Same as Profiler::record(), with the hardware events counted during the phase
+	 */
+
+	void record(ProfilerPhase phase, std::int64_t start, std::int64_t end, PerfSample const& hardware);
+
+	/**
+	 * Starts reading the hardware counters around the phases, if at least one of them is available
+	 *
+	 * Must be called from the thread of the profiler. Returns false, and the phases are only timed, if no counter is available.
+	 */
+
+	bool enableHardwareCounters();
+
+	/**
+	 * Stops reading the hardware counters
+	 */
+
+	void disableHardwareCounters();
+
+	/**
+	 * Adds `n` to a counter
+	 */
+
+	void count(ProfilerCounter counter, std::uint64_t n = 1);
+
+	/**
+	 * Records the current values of the counters in the trace
+	 */
+
+	void sample();
+
+	/**
+	 * Sets the times, the counters (hardware ones included) and the trace back to 0
+	 */
+
+	void reset();
+
+	/**
+	 * Writes the trace as a JSON object of the trace-event format of Chrome
+	 *
+	 * The phases are complete events ("ph": "X") and the samples of the counters are counter events ("ph": "C").
+	 */
+
+	void writeTrace(std::ostream & stream) const;
+
+	/**
+	 * Returns the time since the start of the program (ns), on a steady clock common to all the threads
+	 */
+
+	static std::int64_t now();
+
+private:
+
+	/****************************************************************
+	 * Private types
+	 ****************************************************************/
+
+	/**
+	 * Entry of the trace: a timed phase, or a sample of the counters if `phase` is ProfilerPhase::COUNT
+	 */
+
+	struct Event {
+		ProfilerPhase phase;
+		std::int64_t start;
+		std::int64_t end;
+		std::array<std::uint64_t, size_t(ProfilerCounter::COUNT)> counts;
+	};
+
+	/****************************************************************
+	 * Private methods
+	 ****************************************************************/
+
+	/**
+	 * Adds an event to the trace (the oldest one is overwritten if the trace is full)
+	 */
+
+	void push(Event const& event);
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	/**
+	 * Identifier of the thread in the trace
+	 */
+
+	unsigned int const threadId;
+
+	std::array<std::int64_t, size_t(ProfilerPhase::COUNT)> totalTimes;
+
+	std::array<std::uint64_t, size_t(ProfilerPhase::COUNT)> callCounts;
+
+	std::array<std::uint64_t, size_t(ProfilerCounter::COUNT)> counts;
+
+	std::array<PerfSample, size_t(ProfilerPhase::COUNT)> hardwareCounts;
+
+	/**
+	 * Hardware counters of the thread, nullptr if they are not read
+	 */
+
+	std::unique_ptr<PerfCounters> perfCounters;
+
+	/**
+	 * Circular buffer of the last events, `nextEvent` is the index of the next one to write
+	 */
+
+	std::vector<Event> events;
+
+	size_t nextEvent;
+
+	std::uint64_t droppedEvents;
+};
+
+/****************************************************************
+ * Scoped timer
+ ****************************************************************/
+
+/**
+ * Times a phase from its construction to its destruction, in Profiler::local() (see PROFILE_SCOPE)
+ */
+
+class ProfilerScope {
+public:
+
+	/**
+	 * Starts timing the phase
+	 *
+	 * The constructor is explicit to prevent accidental type casting.
+	 */
+
+	explicit ProfilerScope(ProfilerPhase phase);
+
+	/**
+	 * Records the phase
+	 */
+
+	~ProfilerScope();
+
+	ProfilerScope(ProfilerScope const&) = delete;
+
+	ProfilerScope& operator = (ProfilerScope const&) = delete;
+
+private:
+
+	Profiler & profiler;
+
+	ProfilerPhase const phase;
+
+	/**
+	 * Hardware counters at the start of the phase (only read if Profiler::hasHardwareCounters())
+	 */
+
+	PerfSample hardwareStart;
+
+	std::int64_t const start;
+};
+
+#endif
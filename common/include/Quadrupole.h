@@ -77,6 +77,12 @@ public:
 
 	virtual std::shared_ptr<Element> copy() const override;
 
+	/**
+	 * Returns a polymorphic copy of the current Quadrupole element constructed in `arena` (see Element::copy(Arena &))
+	 */
+
+	virtual Element * copy(Arena & arena) const override;
+
 	/****************************************************************
 	 * Getter (virtual)
 	 ****************************************************************/
@@ -89,6 +95,22 @@ public:
 
 	virtual Vector3D getField(Vector3D const& pos, bool methodChapi = false) const override;
 
+	/**
+	 * Same as Quadrupole::getField() for each position, the direction of the Quadrupole being only computed once
+	 */
+
+	virtual void getFields(std::vector<Vector3D> const& positions, std::vector<Vector3D> & fields, bool methodChapi = false) const override;
+
+	/****************************************************************
+	 * Getters
+	 ****************************************************************/
+
+	/**
+	 * Returns the intensity of the magnetic field of the Quadrupole
+	 */
+
+	double getB() const;
+
 	/****************************************************************
 	 * Virtual methods
 	 ****************************************************************/
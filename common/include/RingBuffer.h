@@ -0,0 +1,133 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+#include "globals.h"
+#include "exceptions.h"
+
+/**
+ * Lock-free ring buffer between exactly one producer thread and one consumer thread
+ *
+ * All the slots are allocated by the constructor: pushing and popping never allocate.
+ * The capacity is rounded up to a power of 2 so that the positions wrap with a mask.
+ *
+ * The producer only writes `head` and the consumer only writes `tail`: each of them reads the position of the other
+ * with acquire semantics, and publishes its own with release semantics, so a slot is never read before it is written.
+ * Both positions are on their own cache line to avoid false sharing between the two threads.
+ */
+
+template <typename T>
+class RingBuffer {
+public:
+
+	/****************************************************************
+	 * Constructors
+	 ****************************************************************/
+
+	/**
+	 * Constructor of an empty buffer of at least `capacity` slots
+	 *
+	 * The constructor is explicit to prevent accidental type casting.
+	 */
+
+	explicit RingBuffer(size_t capacity)
+	: slots(roundUp(capacity)), mask(slots.size() - 1), head(0), tail(0)
+	{}
+
+	/**
+	 * The positions are atomic: a buffer cannot be copied
+	 */
+
+	RingBuffer(RingBuffer const&) = delete;
+
+	RingBuffer& operator = (RingBuffer const&) = delete;
+
+	/****************************************************************
+	 * Getters
+	 ****************************************************************/
+
+	/**
+	 * Returns the number of slots
+	 */
+
+	size_t getCapacity() const { return slots.size(); }
+
+	/**
+	 * Returns the number of values waiting to be popped (only exact when called from one of the two threads while the other one is idle)
+	 */
+
+	size_t getSize() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Producer: copies `value` in the buffer, returns false (and does nothing) if the buffer is full
+	 */
+
+	bool tryPush(T const& value) {
+		size_t position(head.load(std::memory_order_relaxed));
+		if (position - tail.load(std::memory_order_acquire) == slots.size()) { return false; }
+
+		slots[position & mask] = value;
+		head.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Consumer: moves the oldest value to `value`, returns false (and does nothing) if the buffer is empty
+	 */
+
+	bool tryPop(T & value) {
+		size_t position(tail.load(std::memory_order_relaxed));
+		if (position == head.load(std::memory_order_acquire)) { return false; }
+
+		value = slots[position & mask];
+		tail.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+private:
+
+	/****************************************************************
+	 * Private methods
+	 ****************************************************************/
+
+	/**
+	 * Returns the smallest power of 2 greater or equal to `capacity` (at least 2)
+	 */
+
+	static size_t roundUp(size_t capacity) {
+		size_t rounded(2);
+		while (rounded < capacity) { rounded *= 2; }
+		return rounded;
+	}
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	std::vector<T> slots;
+
+	size_t const mask;
+
+	/**
+	 * Position of the next value to push (only written by the producer)
+	 */
+
+	alignas(GLOBALS::CACHE_LINE) std::atomic<size_t> head;
+
+	/**
+	 * Position of the next value to pop (only written by the consumer)
+	 */
+
+	alignas(GLOBALS::CACHE_LINE) std::atomic<size_t> tail;
+};
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef SHARD_H
+#define SHARD_H
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+// Forward declaration
+class Accelerator;
+class Communicator;
+
+#include "globals.h"
+#include "exceptions.h"
+#include "include/ParticleRecord.h"
+
+/**
+ * Share of an Accelerator simulated by one worker of a Communicator
+ *
+ * The ring is cut into Communicator::getSize() slices of equal progress (see Accelerator::getParticleProgress()),
+ * and each worker only simulates the Particles in its own slice. Each step, the workers exchange:
+ *
+ * - ghosts: copies of the Particles closer than GLOBALS::DELTA_INTERACTION to another slice, for the interactions
+ * - migrants: the Particles which moved to another slice, which change owner
+ *
+ * Every worker holds the complete list of Elements, so no Element is ever exchanged.
+ */
+
+class Shard {
+public:
+
+	/****************************************************************
+	 * Constructors
+	 ****************************************************************/
+
+	/**
+	 * Constructor
+	 *
+	 * - `Accelerator acc`: copy of the whole ring (all the Elements and Beams) owned by this worker
+	 * - `Communicator comm`: group of workers sharing the ring
+	 *
+	 * Both must outlive the Shard. Call Shard::partition() before the first step.
+	 */
+
+	explicit Shard(Accelerator & acc, Communicator & comm);
+
+	/****************************************************************
+	 * Getters
+	 ****************************************************************/
+
+	/**
+	 * Returns the worker simulating the Particles at a given progress
+	 */
+
+	size_t getOwner(double progress) const;
+
+	/**
+	 * Returns the lowest progress of the slice of this worker
+	 */
+
+	double getProgressMin() const;
+
+	/**
+	 * Returns the highest progress of the slice of this worker
+	 */
+
+	double getProgressMax() const;
+
+	/**
+	 * Returns the number of ghosts received during the last step
+	 */
+
+	size_t getGhostCount() const;
+
+	/**
+	 * Returns the number of Particles received from other workers during the last step
+	 */
+
+	size_t getMigrantCount() const;
+
+	/****************************************************************
+	 * Collective methods (see Communicator)
+	 ****************************************************************/
+
+	/**
+	 * Removes from the Accelerator the Particles which are outside the slice of this worker
+	 */
+
+	void partition();
+
+	/**
+	 * Simulates the slice over a timestep `dt` (see Accelerator::step()), then sends the Particles which left the slice to their new owner
+	 */
+
+	void step(double dt = GLOBALS::DT);
+
+	/**
+	 * Returns the number of macroparticles still in the whole ring
+	 */
+
+	size_t getGlobalParticleCount();
+
+	/**
+	 * Returns the records of all the Particles of the ring on the worker 0, an empty list on the others
+	 */
+
+	std::vector<ParticleRecord> gather();
+
+private:
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	/**
+	 * Ring simulated by this worker
+	 */
+
+	Accelerator & acc;
+
+	/**
+	 * Group of workers
+	 */
+
+	Communicator & comm;
+
+	/**
+	 * Records to send to each worker, kept between the steps to reuse the memory
+	 */
+
+	std::vector<std::vector<ParticleRecord>> outgoing;
+
+	/**
+	 * Records received, kept between the steps to reuse the memory
+	 */
+
+	std::vector<ParticleRecord> incoming;
+
+	/**
+	 * Number of ghosts received during the last step
+	 */
+
+	size_t ghostCount;
+
+	/**
+	 * Number of Particles received during the last step
+	 */
+
+	size_t migrantCount;
+};
+
+#endif
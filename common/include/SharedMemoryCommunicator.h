@@ -0,0 +1,217 @@
+#ifndef SHAREDMEMORYCOMMUNICATOR_H
+#define SHAREDMEMORYCOMMUNICATOR_H
+
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <exception>
+#include <iostream>
+#include <cstring>
+#include <cstdint>
+#include <new>
+
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Forward declaration
+class Communicator;
+
+#include "globals.h"
+#include "exceptions.h"
+#include "include/ParticleRecord.h"
+
+/**
+ * Communicator between worker processes of one machine
+ *
+ * The workers are forked by SharedMemoryCommunicator::run() and share an anonymous memory mapping created beforehand.
+ * It holds a mailbox for each (sender, receiver) pair and a spinning barrier, so no file, socket or external service is needed.
+ *
+ * Every process works on its own copy of the objects which existed before SharedMemoryCommunicator::run(),
+ * so the Accelerator must be built before, and no thread (e.g. a ThreadPool) may be running during the fork.
+ */
+
+class SharedMemoryCommunicator : public Communicator {
+public:
+
+	/****************************************************************
+	 * Constructors and destructors
+	 ****************************************************************/
+
+	/**
+	 * Constructor mapping the shared memory of `workerCount` workers
+	 *
+	 * - `size_t workerCount`: number of processes, at least 1
+	 * - `size_t capacity`: number of ParticleRecords one worker can send to another in one exchange
+	 *
+	 * The pages are only allocated when written to, so a large capacity is cheap until it is used.
+	 *
+	 * Throws `EXCEPTIONS::SHARED_MEMORY_FAILED` if the memory cannot be mapped
+	 */
+
+	explicit SharedMemoryCommunicator(size_t workerCount, size_t capacity = GLOBALS::MAILBOX_CAPACITY);
+
+	/**
+	 * Destructor unmaps the shared memory
+	 */
+
+	virtual ~SharedMemoryCommunicator() override;
+
+	/**
+	 * The shared memory cannot be copied
+	 */
+
+	SharedMemoryCommunicator(SharedMemoryCommunicator const&) = delete;
+
+	/**
+	 * The shared memory cannot be copied
+	 */
+
+	SharedMemoryCommunicator& operator = (SharedMemoryCommunicator const&) = delete;
+
+	/****************************************************************
+	 * Getters
+	 ****************************************************************/
+
+	virtual size_t getRank() const override;
+
+	virtual size_t getSize() const override;
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Runs `worker` on every worker: the calling process is the worker 0, and the others are forked from it
+	 *
+	 * Returns once all the workers are done. Returns false if one of the forked workers failed,
+	 * and rethrows the exception if the worker 0 failed.
+	 *
+	 * The forked workers leave with `_exit()`, so nothing they computed is visible to the caller
+	 * unless it is sent to the worker 0 (e.g. with Shard::gather())
+	 *
+	 * Throws `EXCEPTIONS::FORK_FAILED` if a process cannot be created
+	 */
+
+	bool run(std::function<void(Communicator &)> const& worker);
+
+	/****************************************************************
+	 * Collective operations
+	 ****************************************************************/
+
+	/**
+	 * Sense-reversing barrier spinning on the shared memory
+	 *
+	 * Throws `EXCEPTIONS::WORKER_FAILED` if another worker failed while waiting
+	 */
+
+	virtual void barrier() override;
+
+	/**
+	 * Copies `outgoing[i]` in the mailbox of the worker i, then reads the mailboxes of the calling worker
+	 *
+	 * Throws `EXCEPTIONS::MAILBOX_OVERFLOW` if a list is longer than the capacity
+	 */
+
+	virtual void exchange(std::vector<std::vector<ParticleRecord>> const& outgoing, std::vector<ParticleRecord> & incoming) override;
+
+	virtual double sum(double value) override;
+
+private:
+
+	/****************************************************************
+	 * Private types
+	 ****************************************************************/
+
+	/**
+	 * Beginning of the shared memory
+	 */
+
+	struct Header {
+		std::atomic<int> arrived;	// Number of workers in the current barrier
+		std::atomic<int> sense;		// Flipped by the last worker reaching the barrier
+		std::atomic<int> failed;	// Set by a failing worker, so that the others do not wait forever
+	};
+
+	static_assert(ATOMIC_INT_LOCK_FREE == 2, "The barrier needs lock-free atomics to work across processes");
+
+	/****************************************************************
+	 * Private methods
+	 ****************************************************************/
+
+	/**
+	 * Values given to SharedMemoryCommunicator::sum(), one per worker
+	 */
+
+	double * getValues() const;
+
+	/**
+	 * Number of records in the mailbox from `sender` to `receiver`
+	 */
+
+	std::uint64_t & getCount(size_t sender, size_t receiver) const;
+
+	/**
+	 * Records of the mailbox from `sender` to `receiver`
+	 */
+
+	ParticleRecord * getRecords(size_t sender, size_t receiver) const;
+
+	/**
+	 * Tells the other workers that this one failed, then throws `message`
+	 */
+
+	[[noreturn]] void fail(char const* message);
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	/**
+	 * Number of workers
+	 */
+
+	size_t const size;
+
+	/**
+	 * Capacity of each mailbox
+	 */
+
+	size_t const capacity;
+
+	/**
+	 * Index of this worker (set in each process by SharedMemoryCommunicator::run())
+	 */
+
+	size_t rank;
+
+	/**
+	 * Sense of the last barrier passed by this worker
+	 */
+
+	int localSense;
+
+	/**
+	 * Size of the shared mapping (bytes)
+	 */
+
+	size_t mappingSize;
+
+	/**
+	 * Shared mapping: Header, values of SharedMemoryCommunicator::sum(), then size * size mailboxes
+	 */
+
+	char * mapping;
+
+	/**
+	 * Header at the beginning of the mapping
+	 */
+
+	Header * header;
+};
+
+#endif
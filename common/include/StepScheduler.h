@@ -0,0 +1,173 @@
+#ifndef STEPSCHEDULER_H
+#define STEPSCHEDULER_H
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <cstdint>
+
+// Forward declaration
+class Accelerator;
+
+#include "globals.h"
+#include "exceptions.h"
+
+/**
+ * How StepScheduler::advance() chooses the number of steps of a frame
+ *
+ * - FIXED  : a fixed number of steps per frame (the simulated speed follows the refresh rate)
+ * - BUDGET : as many steps as fit in a wall time budget per frame
+ * - RATE   : the steps needed to keep a target number of steps per wall second, within the budget of the frame
+ */
+
+enum class SteppingMode { FIXED, BUDGET, RATE };
+
+/**
+ * Decides how many Accelerator::step() a viewer runs between two frames, so that the simulation rate
+ * does not have to follow the refresh rate of the display
+ *
+ * The scheduler also counts the simulated time, so that the viewer can report the simulated time per wall second.
+ */
+
+class StepScheduler {
+public:
+
+	/****************************************************************
+	 * Constructors
+	 ****************************************************************/
+
+	/**
+	 * Constructor
+	 *
+	 * - `stepsPerFrame` : steps per frame in SteppingMode::FIXED (a fractional part is carried to the next frames)
+	 * - `budget` : wall time (s) given to the steps of a frame in SteppingMode::BUDGET and SteppingMode::RATE
+	 * - `targetRate` : steps per wall second in SteppingMode::RATE
+	 *
+	 * Throws `EXCEPTIONS::BAD_SCHEDULE` if one of them is negative
+	 *
+	 * The constructor is explicit to prevent accidental type casting.
+	 */
+
+	explicit StepScheduler(SteppingMode mode = SteppingMode::FIXED, double stepsPerFrame = 1, double budget = APP::FRAME_BUDGET, double targetRate = APP::TARGET_RATE);
+
+	/****************************************************************
+	 * Getters
+	 ****************************************************************/
+
+	SteppingMode getMode() const;
+
+	double getStepsPerFrame() const;
+
+	double getBudget() const;
+
+	double getTargetRate() const;
+
+	/**
+	 * Returns the total simulated time (s) of the steps run by StepScheduler::advance()
+	 */
+
+	double getSimulatedTime() const;
+
+	/**
+	 * Returns the total number of steps run by StepScheduler::advance()
+	 */
+
+	std::uint64_t getStepCount() const;
+
+	/**
+	 * Returns the name of a SteppingMode, for the title of the viewer
+	 */
+
+	static char const* getName(SteppingMode mode);
+
+	/****************************************************************
+	 * Setters
+	 ****************************************************************/
+
+	/**
+	 * Changes the mode, the next frame starting without any step owed
+	 */
+
+	void setMode(SteppingMode mode);
+
+	/**
+	 * Switches to the next SteppingMode (FIXED, BUDGET, RATE, FIXED, ...)
+	 */
+
+	void nextMode();
+
+	/**
+	 * Throw `EXCEPTIONS::BAD_SCHEDULE` if the value is negative
+	 */
+
+	void setStepsPerFrame(double stepsPerFrame);
+
+	void setBudget(double budget);
+
+	void setTargetRate(double targetRate);
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Runs the steps of `dt` of one frame on `acc` and returns their number
+	 */
+
+	size_t advance(Accelerator & acc, double dt = GLOBALS::DT);
+
+	/**
+	 * Runs the steps of `dt` of one frame of the current mode, `elapsed` being the wall time (s) elapsed since the previous frame
+	 *
+	 * Used by StepScheduler::advance(), exposed so that the schedule can be reproduced with a given frame time
+	 */
+
+	size_t advance(Accelerator & acc, double dt, double elapsed);
+
+private:
+
+	/****************************************************************
+	 * Private methods
+	 ****************************************************************/
+
+	/**
+	 * Runs steps while fewer than `maxSteps` were run and the budget is not exhausted
+	 */
+
+	size_t stepWithinBudget(Accelerator & acc, double dt, double maxSteps);
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	SteppingMode mode;
+
+	double stepsPerFrame;
+
+	double budget;
+
+	double targetRate;
+
+	/**
+	 * Steps owed to the next frames (fractional steps in SteppingMode::FIXED, late steps in SteppingMode::RATE)
+	 */
+
+	double owedSteps;
+
+	/**
+	 * Time of the previous call to StepScheduler::advance(), to know the wall time elapsed in SteppingMode::RATE
+	 */
+
+	std::chrono::steady_clock::time_point previousFrame;
+
+	bool started;
+
+	double simulatedTime;
+
+	std::uint64_t stepCount;
+};
+
+#endif
@@ -73,6 +73,12 @@ public:
 
 	virtual std::shared_ptr<Element> copy() const override;
 
+	/**
+	 * Returns a polymorphic copy of the current Straight element constructed in `arena` (see Element::copy(Arena &))
+	 */
+
+	virtual Element * copy(Arena & arena) const override;
+
 	/****************************************************************
 	 * Getter (virtual)
 	 ****************************************************************/
@@ -87,6 +93,12 @@ public:
 
 	virtual Vector3D getField(Vector3D const& pos, bool methodChapi = false) const override;
 
+	/**
+	 * Null field for all the positions
+	 */
+
+	virtual void getFields(std::vector<Vector3D> const& positions, std::vector<Vector3D> & fields, bool methodChapi = false) const override;
+
 	/**
 	 * Returns the HORIZONTAL direction perpendicular to the Straight Element at a certain position
 	 *
@@ -130,10 +142,12 @@ public:
 	 ****************************************************************/
 
 	/**
-	 * Returns true if the Particle p is outside the straight element (touched the wall)
+	 * Returns true if the position pos is outside the straight element (in the wall)
 	 */
 
-	virtual bool isInWall(Particle const& p) const override;
+	virtual bool isInWall(Vector3D const& pos) const override;
+
+	using Element::isInWall;
 
 	/**
 	 * Returns a string representation of the straight element
@@ -0,0 +1,191 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <mutex>
+#include <chrono>
+#include <memory>
+
+// Forward declaration
+class Accelerator;
+class LatticeTemplate;
+class ThreadPool;
+
+#include "globals.h"
+#include "exceptions.h"
+
+/**
+ * Tuning parameters of one run of a Sweep
+ *
+ * See LatticeTemplate for where each of them is used
+ */
+
+struct SweepPoint {
+	double b;				// Frodo quadrupole gradient
+	double straightLength;	// Frodo straight sections length
+	double B;				// Dipole magnetic field
+	double energy;			// Beam energy (GeV)
+};
+
+/**
+ * Range of values of one parameter: `count` values evenly spaced between `min` and `max` (both included)
+ *
+ * A range with `count = 1` only contains `min`
+ */
+
+struct SweepRange {
+	double min;
+	double max;
+	size_t count;
+};
+
+/**
+ * Summary of one run of a Sweep
+ */
+
+struct SweepResult {
+	size_t index;				// Index of the point in the list given to Sweep::run()
+	SweepPoint point;
+	size_t initialParticles;	// Number of macroparticles after instantiation
+	size_t finalParticles;		// Number of macroparticles after the last step
+	double survival;			// finalParticles / initialParticles
+	double emittanceGrowthR;	// Final / initial Accelerator::getMeanEmittanceR() (0 if undefined)
+	double emittanceGrowthZ;	// Final / initial Accelerator::getMeanEmittanceZ() (0 if undefined)
+	size_t steps;				// Number of steps actually simulated
+	bool terminatedEarly;		// True if the run stopped because all the particles were lost
+	double wallTime;			// Duration of the run (s)
+	std::string error;			// Exception message if the run failed (e.g. invalid Frodo length), empty otherwise
+
+	/**
+	 * Returns the CSV header matching SweepResult::to_string()
+	 */
+
+	static std::string const header();
+
+	/**
+	 * Returns the result as a CSV record (without line break)
+	 */
+
+	std::string const to_string() const;
+};
+
+/**
+ * Runs independent copies of a LatticeTemplate tuned with different SweepPoints concurrently on a ThreadPool
+ */
+
+class Sweep {
+public:
+
+	/****************************************************************
+	 * Constructors
+	 ****************************************************************/
+
+	/**
+	 * Constructor
+	 *
+	 * - `LatticeTemplate lattice`: ring to simulate, compiled by the constructor if needed
+	 * - `size_t steps`: number of Accelerator::step() of each run
+	 * - `ThreadPool pool`: workers running the sweep
+	 * - `double dt`: timestep of each Accelerator::step()
+	 *
+	 * The template and the pool must outlive the Sweep
+	 */
+
+	explicit Sweep(LatticeTemplate & lattice, size_t steps, ThreadPool & pool, double dt = GLOBALS::DT);
+
+	/****************************************************************
+	 * Sampling
+	 ****************************************************************/
+
+	/**
+	 * Returns the cartesian product of the four ranges
+	 *
+	 * Throws `EXCEPTIONS::BAD_RANGE` if a range is empty or reversed
+	 */
+
+	static std::vector<SweepPoint> grid(SweepRange const& b, SweepRange const& straightLength, SweepRange const& B, SweepRange const& energy);
+
+	/**
+	 * Returns `count` points drawn uniformly in the box `[min, max]`
+	 *
+	 * The points only depend on `seed`
+	 */
+
+	static std::vector<SweepPoint> random(SweepPoint const& min, SweepPoint const& max, size_t count, unsigned int seed);
+
+	/**
+	 * Returns `count` points of a Latin hypercube sample of the box `[min, max]`:
+	 * each parameter takes exactly one value in each of its `count` strata
+	 *
+	 * The points only depend on `seed`
+	 */
+
+	static std::vector<SweepPoint> latinHypercube(SweepPoint const& min, SweepPoint const& max, size_t count, unsigned int seed);
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Runs one simulation per point and returns the results in the order of `points`
+	 *
+	 * If `summary` is given, the CSV header and then one record per run are written to it as soon as each run finishes
+	 */
+
+	std::vector<SweepResult> run(std::vector<SweepPoint> const& points, std::ostream * summary = nullptr) const;
+
+	/**
+	 * Runs the simulation of a single point (on the calling thread)
+	 *
+	 * Stops as soon as all the particles are lost
+	 */
+
+	SweepResult runPoint(SweepPoint const& point, size_t index = 0) const;
+
+private:
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	/**
+	 * Compiled ring shared by every run
+	 */
+
+	LatticeTemplate const& lattice;
+
+	/**
+	 * Number of steps of each run
+	 */
+
+	size_t const steps;
+
+	/**
+	 * Workers running the sweep
+	 */
+
+	ThreadPool & pool;
+
+	/**
+	 * Timestep of each run
+	 */
+
+	double const dt;
+};
+
+/**
+ * Streams the `SweepResult::to_string()` representation to a given stream
+ */
+
+std::ostream& operator << (std::ostream& stream, SweepResult const& result);
+
+#endif
@@ -7,6 +7,9 @@
 #include <cmath>
 #include <cassert>
 #include <string> // assert exceptions
+// Forward declaration
+class Accelerator;
+
 #include "globals.h"
 #include "exceptions.h"
 
@@ -21,6 +24,13 @@ public:
 	 */
 
 	static bool eq(double x, double y, double = GLOBALS::EPSILON);
+
+	/**
+	 * Fills `acc` with the ring of the application (see assets/lattices/fodo.lattice), whose loop is closed:
+	 * 4 sections of 4 m joined by 90° Dipoles, the sections being Straights, or Frodos if `frodos`
+	 */
+
+	static void makeRing(Accelerator & acc, bool frodos = false);
 };
 
 /**
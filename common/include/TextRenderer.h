@@ -6,6 +6,10 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
+#include <charconv>
+#include <cstring>
+#include <cmath>
 
 // Forward declaration
 class Beam;
@@ -19,6 +23,42 @@ class Particle;
 class Vector3D;
 class Renderer;
 
+#include "globals.h"
+#include "exceptions.h"
+#include "include/ParticleRecord.h"
+
+/**
+ * Output formats of a TextRenderer
+ *
+ * - HUMAN : the `to_string()` of the objects, with colours
+ * - CSV   : one line per record, starting with the type of the record
+ * - JSONL : one JSON object per line, with a "type" field
+ */
+
+enum class TextFormat { HUMAN, CSV, JSONL };
+
+/**
+ * Renders the simulation as text
+ *
+ * In the machine-oriented formats (TextFormat::CSV and TextFormat::JSONL), the records are, in this order of fields:
+ *
+ * - `accelerator`: beams, particles, then the records of its elements and Beams
+ * - `beam`: particles, meanEnergy, emittanceR, emittanceZ, charge, then the records of its particles
+ * - `particle`: kind, x, y, z, px, py, pz, mass, charge (momentum as stored by Particle, charge in elementary charges)
+ * - `straight`: index, xIn, yIn, zIn, xOut, yOut, zOut, radius
+ * - `quadrupole`: the fields of `straight`, b
+ * - `frodo`: the fields of `straight`, b, straightLength
+ * - `dipole`: the fields of `straight`, curvature, B
+ * - `vector`: x, y, z
+ *
+ * A CSV file has no header line, as its records are of several types: the first column of a line is the type of the record,
+ * and the next columns are its fields in the order above, e.g. `dipole,index,xIn,yIn,zIn,xOut,yOut,zOut,radius,curvature,B`.
+ * The index of an Element which is in no Accelerator (see Element::isLinked()) is an empty column in CSV, `null` in JSONL.
+ *
+ * The numbers are written with `std::to_chars` (shortest representation) in a buffer of `GLOBALS::TEXT_BUFFER` bytes,
+ * which is only written to the stream when it is full, on TextRenderer::flush() and on destruction.
+ */
+
 class TextRenderer : public Renderer {
 public:
 
@@ -33,13 +73,13 @@ public:
 	 * The constructor is explicit to prevent accidental type casting.
 	 */
 
-	explicit TextRenderer(std::ostream * stream_ptr = &std::cout);
+	explicit TextRenderer(std::ostream * stream_ptr = &std::cout, TextFormat format = TextFormat::HUMAN);
 
 	/**
 	 * Give `TextRenderer` a file name to print to
 	 */
 
-	explicit TextRenderer(std::string const& fileName);
+	explicit TextRenderer(std::string const& fileName, TextFormat format = TextFormat::HUMAN);
 
 	/**
 	 * Get the default destructor but allow it to be overridden
@@ -65,6 +105,22 @@ public:
 
 	TextRenderer& operator = (TextRenderer const& engine) = delete;
 
+	/****************************************************************
+	 * Getters
+	 ****************************************************************/
+
+	TextFormat getFormat() const;
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Writes the buffered records to the stream and flushes it
+	 */
+
+	void flush();
+
 	/****************************************************************
 	 * Drawing methods
 	 ****************************************************************/
@@ -136,8 +192,82 @@ public:
 	virtual void draw(Vector3D const& vec) override;
 
 private:
+
+	/****************************************************************
+	 * Private methods (machine-oriented formats)
+	 ****************************************************************/
+
+	/**
+	 * Starts a record of type `type`
+	 */
+
+	void beginRecord(char const* type);
+
+	/**
+	 * Adds the field `name` to the current record
+	 */
+
+	void field(char const* name, double value);
+
+	void field(char const* name, char const* value);
+
+	/**
+	 * Adds the field `name` without value to the current record
+	 */
+
+	void field(char const* name);
+
+	/**
+	 * Adds the fields index, xIn, yIn, zIn, xOut, yOut, zOut and radius of `element`
+	 */
+
+	void elementFields(Element const& element);
+
+	/**
+	 * Ends the current record
+	 */
+
+	void endRecord();
+
+	/**
+	 * Writes a `particle` record
+	 */
+
+	void writeParticle(ParticleRecord const& record);
+
+	/**
+	 * Appends `text` to the buffer
+	 */
+
+	void write(char const* text);
+
+	/**
+	 * Makes room for `size` bytes in the buffer, writing it to the stream if needed
+	 */
+
+	void reserve(size_t size);
+
+	/**
+	 * Writes the buffer to the stream, without flushing the stream
+	 */
+
+	void writeBuffer();
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
 	std::ostream * stream_ptr;
 	std::ofstream fileStream;
+
+	TextFormat format;
+
+	/**
+	 * Records waiting to be written to the stream, `used` bytes of it being filled
+	 */
+
+	std::vector<char> buffer;
+	size_t used;
 };
 
 #endif
@@ -0,0 +1,199 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+#include "globals.h"
+#include "exceptions.h"
+
+/**
+ * Fixed-size pool of worker threads shared by everything that runs work concurrently
+ * (parameter sweeps, bulk beam construction, etc.)
+ *
+ * Tasks are queued and picked up by the first idle worker. Each task belongs to a ThreadPool::Batch, and a caller only waits
+ * for the tasks of its own Batch (running them itself while they are queued), so that the pool can be shared:
+ * a parallel loop does not wait for unrelated work, and a task can run a parallel loop on the pool without a deadlock.
+ * Exceptions thrown by a task are caught and rethrown by `ThreadPool::wait()` for its Batch.
+ */
+
+class ThreadPool {
+public:
+
+	/**
+	 * Tasks waited for together (see ThreadPool::submit() and ThreadPool::wait()), with their first exception
+	 *
+	 * The Batch must outlive its tasks, which ThreadPool::wait() ensures
+	 */
+
+	class Batch {
+	public:
+		Batch();
+
+		Batch(Batch const&) = delete;
+
+		Batch& operator = (Batch const&) = delete;
+
+	private:
+		friend class ThreadPool;
+
+		/**
+		 * Number of tasks of the Batch which are not done yet
+		 */
+
+		size_t pending;
+
+		/**
+		 * First exception thrown by a task of the Batch
+		 */
+
+		std::exception_ptr error;
+	};
+
+	/****************************************************************
+	 * Constructors and destructors
+	 ****************************************************************/
+
+	/**
+	 * Constructor spawning `threadCount` workers
+	 *
+	 * - `size_t threadCount`: number of workers, 0 means one per hardware thread
+	 *
+	 * The constructor is explicit to prevent accidental type casting.
+	 */
+
+	explicit ThreadPool(size_t threadCount = 0);
+
+	/**
+	 * Destructor finishes the queued tasks and joins the workers
+	 */
+
+	~ThreadPool();
+
+	/**
+	 * Threads cannot be copied
+	 */
+
+	ThreadPool(ThreadPool const&) = delete;
+
+	/**
+	 * Threads cannot be copied
+	 */
+
+	ThreadPool& operator = (ThreadPool const&) = delete;
+
+	/****************************************************************
+	 * Getters
+	 ****************************************************************/
+
+	/**
+	 * Returns the number of workers
+	 */
+
+	size_t getThreadCount() const;
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Queues a task of `batch`, which will be run by the first idle worker (or by the thread waiting for `batch`)
+	 */
+
+	void submit(Batch & batch, std::function<void()> task);
+
+	/**
+	 * Blocks until every task of `batch` has been run, running its queued tasks on the calling thread meanwhile
+	 *
+	 * If a task of `batch` threw an exception, the first one is rethrown here
+	 */
+
+	void wait(Batch & batch);
+
+	/**
+	 * Splits `[begin, end)` in contiguous chunks, runs `body(chunkBegin, chunkEnd)` on each of them concurrently and waits for the result
+	 *
+	 * The chunks only depend on the range and on `GLOBALS::PARALLEL_GRAIN`, so a body which only writes at its own indexes gives the same result whatever the number of threads
+	 *
+	 * The chunks form a Batch of their own: the call can be made from a task of the pool
+	 */
+
+	void parallelFor(size_t begin, size_t end, std::function<void(size_t, size_t)> const& body);
+
+private:
+
+	/****************************************************************
+	 * Private methods
+	 ****************************************************************/
+
+	/**
+	 * Task queued with its Batch
+	 */
+
+	struct Task {
+		std::function<void()> run;
+		Batch * batch_ptr;
+	};
+
+	/**
+	 * Main loop of a worker: pop a task, run it, repeat until the pool is stopped
+	 */
+
+	void work();
+
+	/**
+	 * Runs `task` with `lock` released, then records its exception and its completion in its Batch
+	 */
+
+	void run(Task & task, std::unique_lock<std::mutex> & lock);
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	/**
+	 * Worker threads
+	 */
+
+	std::vector<std::thread> workers;
+
+	/**
+	 * Queued tasks
+	 */
+
+	std::deque<Task> tasks;
+
+	/**
+	 * Protects `tasks`, `stopping` and the Batches
+	 */
+
+	std::mutex mutex;
+
+	/**
+	 * Signaled when a task is queued or when the pool is stopped
+	 */
+
+	std::condition_variable taskAvailable;
+
+	/**
+	 * Signaled when the last pending task of a Batch is done
+	 */
+
+	std::condition_variable batchDone;
+
+	/**
+	 * Set by the destructor to release the workers
+	 */
+
+	bool stopping;
+};
+
+#endif
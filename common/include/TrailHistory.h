@@ -0,0 +1,181 @@
+#ifndef TRAILHISTORY_H
+#define TRAILHISTORY_H
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+
+// Forward declaration
+class Accelerator;
+
+#include "globals.h"
+#include "exceptions.h"
+
+/**
+ * History of the positions of the particles over the last frames, drawn as trails behind them
+ *
+ * The history is a ring of `length` slots, one per frame, each slot holding the positions of all the particles,
+ * so that a frame only changes one contiguous slot (see TrailHistory::getHead()), uploaded with a single sub-buffer write.
+ *
+ * The segments of the trails are described by a fixed index list (see TrailHistory::getIndices()),
+ * holding the segments of the ring twice, so that the segments from the oldest to the newest slot are always
+ * a contiguous range of indices (see TrailHistory::getFirstIndex()), drawn with a single draw call.
+ *
+ * The particles are identified by their Beam and their id (see Beam::getParticleId()): when they are only reordered
+ * (see Accelerator::reorderParticles()), their positions are put back in the order of the slots,
+ * and the history is reset when a particle is lost or received.
+ */
+
+class TrailHistory {
+public:
+
+	/****************************************************************
+	 * Constructors
+	 ****************************************************************/
+
+	/**
+	 * Constructor of a history of `length` frames, a length of 0 disabling the trails
+	 *
+	 * Throws `EXCEPTIONS::BAD_TRAIL_LENGTH` if the length is more than `GRAPHICS::TRAIL_MAX_LENGTH`
+	 *
+	 * The constructor is explicit to prevent accidental type casting.
+	 */
+
+	explicit TrailHistory(size_t length = 0);
+
+	/****************************************************************
+	 * Getters
+	 ****************************************************************/
+
+	size_t getLength() const;
+
+	/**
+	 * Returns the number of particles in each slot
+	 */
+
+	size_t getParticleCount() const;
+
+	/**
+	 * Returns the slot of the last recorded frame
+	 */
+
+	size_t getHead() const;
+
+	/**
+	 * Returns the positions (x, y, z) of the particles of the last recorded frame, to be written in the slot TrailHistory::getHead()
+	 */
+
+	std::vector<float> const& getPositions() const;
+
+	/**
+	 * Returns the indices of the vertices (slot * particles + particle) of the segments of the ring, in which the positions
+	 * are stored slot after slot
+	 */
+
+	std::vector<std::uint32_t> const& getIndices() const;
+
+	/**
+	 * Returns the first index of the segments to draw, from the oldest to the newest slot
+	 */
+
+	size_t getFirstIndex() const;
+
+	/**
+	 * Returns the number of indices of the segments to draw
+	 */
+
+	size_t getIndexCount() const;
+
+	/****************************************************************
+	 * Setters
+	 ****************************************************************/
+
+	/**
+	 * Changes the number of frames of the history, which is then reset
+	 *
+	 * Throws `EXCEPTIONS::BAD_TRAIL_LENGTH` if the length is more than `GRAPHICS::TRAIL_MAX_LENGTH`
+	 */
+
+	void setLength(size_t length);
+
+	/****************************************************************
+	 * Methods
+	 ****************************************************************/
+
+	/**
+	 * Records the positions of the particles of `acc` in the next slot
+	 *
+	 * Nothing is recorded if the particles did not move since the last frame (e.g. when the simulation is paused)
+	 *
+	 * Returns true if the history was reset (first frame, new length or new number of particles),
+	 * in which case every slot holds the current positions and the indices changed
+	 */
+
+	bool record(Accelerator const& acc);
+
+private:
+
+	/****************************************************************
+	 * Private methods
+	 ****************************************************************/
+
+	/**
+	 * Builds the indices of the segments for the current length and number of particles
+	 */
+
+	void buildIndices();
+
+	/**
+	 * Puts the positions being read back in the order of the particles of the slots, if they are the same particles
+	 *
+	 * Returns false if some particles are not in the slots
+	 */
+
+	bool matchSlots();
+
+	/****************************************************************
+	 * Attributes
+	 ****************************************************************/
+
+	size_t length;
+
+	size_t particleCount;
+
+	size_t head;
+
+	/**
+	 * Has a frame been recorded since the last reset ?
+	 */
+
+	bool recorded;
+
+	std::vector<float> positions;
+
+	/**
+	 * Positions being read, swapped with the current ones, to avoid a reallocation every frame
+	 */
+
+	std::vector<float> next;
+
+	/**
+	 * Identifiers (id of the Beam in the high bits, id of the particle in the low bits) of the particles of the slots,
+	 * and of the particles being read
+	 */
+
+	std::vector<std::uint64_t> ids;
+	std::vector<std::uint64_t> nextIds;
+
+	/**
+	 * Slot of each identifier and positions put back in order, for TrailHistory::matchSlots()
+	 */
+
+	std::unordered_map<std::uint64_t, size_t> slots;
+	std::vector<float> matched;
+
+	std::vector<std::uint32_t> indices;
+};
+
+#endif
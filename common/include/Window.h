@@ -14,6 +14,10 @@
 
 // Title generation
 #include <string>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
 
 class OpenGLRenderer;
 class Accelerator;
@@ -21,6 +25,7 @@ class Accelerator;
 // Needed because the compiler needs to know the size of the class
 #include "include/bundle/OpenGLRenderer.bundle.h"
 #include "include/bundle/Accelerator.bundle.h"
+#include "include/bundle/StepScheduler.bundle.h"
 
 #include "globals.h"
 
@@ -34,8 +39,16 @@ class Window : public QOpenGLWindow {
 	Q_OBJECT
 
 public:
-	// General constructor
-	Window();
+	/**
+	 * General constructor
+	 *
+	 * The Accelerator is read from the lattice file `latticeFile` (see Lattice) if one is given,
+	 * otherwise the default FODO ring is built
+	 *
+	 * The constructor is explicit to prevent accidental type casting.
+	 */
+
+	explicit Window(std::string const& latticeFile = "");
 
 	/**
 	 * Qt constructor
@@ -104,6 +117,24 @@ private:
 
 	void printContextInformation();
 
+	/**
+	 * Builds the default FODO ring and its two Beams, used when no lattice file is given
+	 */
+
+	void buildDefaultLattice();
+
+	/**
+	 * Speeds up (`direction` = 1) or slows down (`direction` = -1) the physics engine, by changing the setting of the current SteppingMode
+	 */
+
+	void changeEngineSpeed(int direction);
+
+	/**
+	 * Bins the next Particles of each Beam in the phase space histograms, which are reset when the Beams change
+	 */
+
+	void updatePhaseSpace();
+
 	/**
 	 * Does the window have focus ?
 	 */
@@ -141,10 +172,36 @@ private:
 	unsigned int frames;
 
 	/**
-	 * Iterations per second for the physics engine
+	 * Number of iterations of the physics engine per frame (see StepScheduler)
+	 */
+
+	StepScheduler scheduler;
+
+	/**
+	 * Simulated time at the last FPS counter refresh
+	 */
+
+	double simulatedTime;
+
+	/**
+	 * Is the phase space panel shown ?
+	 */
+
+	bool showPhaseSpace;
+
+	/**
+	 * Are the Elements coloured by their losses ? (see LossMap)
+	 */
+
+	bool showLossMap;
+
+	/**
+	 * Phase space histograms of the Beams, and the Beam (see Accelerator::getBeamId()) of each of them
 	 */
 
-	double engineSpeed;
+	std::vector<PhaseSpaceHistogram> phaseSpace;
+
+	std::vector<std::uint32_t> phaseSpaceBeams;
 };
 
 #endif
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "include/PerfCounters.h"
+#include "include/Profiler.h"
+
+#include "include/Arena.h"
@@ -3,11 +3,17 @@
 #include "include/Drawable.h"
 #include "include/Renderer.h"
 
+#include "include/PerfCounters.h"
+#include "include/Profiler.h"
+
 #include "include/Vector3D.h"
 
 #include "include/Element.h"
 #include "include/Convert.h"
 #include "include/Particle.h"
 #include "include/Accelerator.h"
+#include "include/ThreadPool.h"
+#include "include/Philox.h"
+#include "include/PhaseSpaceDistribution.h"
 
 #include "include/Beam.h"
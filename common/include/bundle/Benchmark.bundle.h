@@ -0,0 +1,15 @@
+#pragma once
+
+#include "include/Drawable.h"
+#include "include/Renderer.h"
+
+#include "include/PerfCounters.h"
+#include "include/Profiler.h"
+
+#include "include/Vector3D.h"
+#include "include/Particle.h"
+#include "include/Element.h"
+#include "include/Beam.h"
+#include "include/Accelerator.h"
+
+#include "include/Benchmark.h"
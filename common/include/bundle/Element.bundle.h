@@ -3,6 +3,9 @@
 #include "include/Drawable.h"
 #include "include/Renderer.h"
 
+#include "include/PerfCounters.h"
+#include "include/Profiler.h"
+
 #include "include/Vector3D.h"
 #include "include/Convert.h"
 #include "include/Particle.h"
@@ -0,0 +1,4 @@
+#pragma once
+
+#include "include/Vertex.h"
+#include "include/Geometry.h"
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "include/Drawable.h"
+#include "include/Renderer.h"
+
+#include "include/Vector3D.h"
+#include "include/Convert.h"
+#include "include/Particle.h"
+#include "include/Element.h"
+#include "include/Straight.h"
+#include "include/Dipole.h"
+#include "include/Quadrupole.h"
+#include "include/Frodo.h"
+#include "include/Beam.h"
+#include "include/Accelerator.h"
+
+#include "include/Sweep.h"
+#include "include/LatticeTemplate.h"
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "include/Drawable.h"
+#include "include/Renderer.h"
+
+#include "include/Vector3D.h"
+#include "include/Particle.h"
+#include "include/Element.h"
+
+#include "include/LossMap.h"
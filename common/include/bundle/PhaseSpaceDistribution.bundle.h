@@ -0,0 +1,8 @@
+#pragma once
+
+#include "include/Drawable.h"
+#include "include/Renderer.h"
+
+#include "include/Vector3D.h"
+#include "include/Philox.h"
+#include "include/PhaseSpaceDistribution.h"
@@ -0,0 +1,4 @@
+#pragma once
+
+#include "include/PerfCounters.h"
+#include "include/Profiler.h"
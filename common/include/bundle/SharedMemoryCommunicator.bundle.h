@@ -0,0 +1,4 @@
+#pragma once
+
+#include "include/Communicator.h"
+#include "include/SharedMemoryCommunicator.h"
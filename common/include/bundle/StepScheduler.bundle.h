@@ -0,0 +1,12 @@
+#pragma once
+
+#include "include/Drawable.h"
+#include "include/Renderer.h"
+
+#include "include/Vector3D.h"
+#include "include/Particle.h"
+#include "include/Element.h"
+#include "include/Beam.h"
+#include "include/Accelerator.h"
+
+#include "include/StepScheduler.h"
@@ -1,3 +1,16 @@
 #pragma once
 
-#include "include/Test.h"
\ No newline at end of file
+#include "include/Drawable.h"
+#include "include/Renderer.h"
+
+#include "include/Vector3D.h"
+#include "include/Particle.h"
+#include "include/Element.h"
+#include "include/Straight.h"
+#include "include/Dipole.h"
+#include "include/Quadrupole.h"
+#include "include/Frodo.h"
+#include "include/Beam.h"
+#include "include/Accelerator.h"
+
+#include "include/Test.h"
@@ -13,12 +13,16 @@
 #include "include/Beam.h"
 
 #include "include/Accelerator.h"
+#include "include/PhaseSpaceHistogram.h"
+#include "include/Lattice.h"
+#include "include/StepScheduler.h"
 
 #include "include/Vertex.h"
 #include "include/Geometry.h"
 #include "include/Transform3D.h"
 #include "include/Camera3D.h"
 #include "include/Input.h"
+#include "include/TrailHistory.h"
 
 #include "include/OpenGLRenderer.h"
 
@@ -2,12 +2,14 @@
 
 using namespace std;
 
+constexpr size_t Accelerator::NO_INTERACTION_REGION;
+
 /****************************************************************
  * Constructor
  ****************************************************************/
 
 Accelerator::Accelerator(Renderer * engine_ptr, bool methodChapi, bool beamFromParticle)
-: Drawable(engine_ptr), methodChapi(methodChapi), beamFromParticle(beamFromParticle)
+: Drawable(engine_ptr), nextBeamId(0), progressesUpToDate(false), arcLengths(1, 0), elementIndexUpToDate(true), threadPool_ptr(nullptr), methodChapi(methodChapi), beamFromParticle(beamFromParticle), spaceCharge(true), tolerance(0), bucketed(false), flattened(false), reorderInterval(0), stepCount(0)
 {}
 
 /****************************************************************
@@ -22,29 +24,167 @@ Accelerator::~Accelerator() { this->clear(); };
 
 bool Accelerator::getBeamFromParticle() const { return beamFromParticle; }
 
+ThreadPool * Accelerator::getThreadPool() const { return threadPool_ptr; }
+
+ElementIndex const& Accelerator::getElementIndex() const {
+	if (not elementIndexUpToDate) {
+		elementIndex.build(elements_ptr, methodChapi);
+		elementIndexUpToDate = true;
+	}
+	return elementIndex;
+}
+
+vector<Element *> const& Accelerator::getElements() const { return elements_ptr; }
+
+vector<Element *> const& Accelerator::getAddedElements() const { return addedElements_ptr; }
+
+LossMap const& Accelerator::getLossMap() const { return lossMap; }
+
+size_t Accelerator::getBeamCount() const { return beams_ptr.size(); }
+
+Beam const& Accelerator::getBeam(size_t beam) const {
+	if (beam >= beams_ptr.size()) { ERROR(EXCEPTIONS::NO_BEAM); }
+	return *beams_ptr[beam];
+}
+
+uint32_t Accelerator::getBeamId(size_t beam) const {
+	if (beam >= beamIds.size()) { ERROR(EXCEPTIONS::NO_BEAM); }
+	return beamIds[beam];
+}
+
+size_t Accelerator::getParticleCount() const {
+	size_t count(0);
+	for (unique_ptr<Beam> const& beam_ptr : beams_ptr) {
+		count += beam_ptr->getParticleCount();
+	}
+	return count;
+}
+
+double Accelerator::getMeanEmittanceR() const {
+	double emittance(0);
+	size_t count(getParticleCount());
+	if (count == 0) { return 0; }
+
+	for (unique_ptr<Beam> const& beam_ptr : beams_ptr) {
+		emittance += beam_ptr->getEmittanceR() * beam_ptr->getParticleCount();
+	}
+	return emittance / count;
+}
+
+double Accelerator::getMeanEmittanceZ() const {
+	double emittance(0);
+	size_t count(getParticleCount());
+	if (count == 0) { return 0; }
+
+	for (unique_ptr<Beam> const& beam_ptr : beams_ptr) {
+		emittance += beam_ptr->getEmittanceZ() * beam_ptr->getParticleCount();
+	}
+	return emittance / count;
+}
+
+bool Accelerator::getSpaceCharge() const { return spaceCharge; }
+
+size_t Accelerator::getInteractionRegionCount() const { return interactionRegions.size(); }
+
+size_t Accelerator::getInteractionRegion(double progress) const {
+	if (interactionRegions.empty()) { return 0; }
+
+	double length(progress * getTotalLength());
+	for (size_t region(0); region < interactionRegions.size(); ++region) {
+		InteractionRegion const& bounds(interactionRegions[region]);
+		if (bounds.begin <= bounds.end) {
+			if (length >= bounds.begin and length <= bounds.end) { return region; }
+		} else {
+			// Across the entrance of the first Element
+			if (length >= bounds.begin or length <= bounds.end) { return region; }
+		}
+	}
+	return NO_INTERACTION_REGION;
+}
+
+double Accelerator::getTolerance() const { return tolerance; }
+
+bool Accelerator::getBucketed() const { return bucketed; }
+
+bool Accelerator::getFlattened() const { return flattened; }
+
+size_t Accelerator::getReorderInterval() const { return reorderInterval; }
+
+double Accelerator::getTimeStep(size_t element) const {
+	if (element >= timeSteps.size()) { ERROR(EXCEPTIONS::NO_ELEMENT); }
+	return timeSteps[element];
+}
+
+/****************************************************************
+ * Setters
+ ****************************************************************/
+
+void Accelerator::setThreadPool(ThreadPool * threadPool_ptr) { this->threadPool_ptr = threadPool_ptr; }
+
+void Accelerator::setSpaceCharge(bool spaceCharge) { this->spaceCharge = spaceCharge; }
+
+void Accelerator::setTolerance(double tolerance) {
+	if (tolerance < 0) { ERROR(EXCEPTIONS::BAD_TOLERANCE); }
+	if (tolerance > 0 and bucketed) { ERROR(EXCEPTIONS::ADAPTIVE_BUCKETED); }
+	this->tolerance = tolerance;
+}
+
+void Accelerator::setBucketed(bool bucketed) {
+	if (bucketed and tolerance > 0) { ERROR(EXCEPTIONS::ADAPTIVE_BUCKETED); }
+	this->bucketed = bucketed;
+}
+
+void Accelerator::setReorderInterval(size_t steps) { reorderInterval = steps; }
+
 /****************************************************************
  * Methods
  ****************************************************************/
 
-void Accelerator::addElement(Element const& element) {
-	// Protection against empty vector elements
-	if (elements_ptr.size() > 0) {
-		// Protection against non-touching elements
-		if (elements_ptr[elements_ptr.size() - 1]->getPosOut() == element.getPosIn()) {
-			elements_ptr.push_back(element.copy());
-			elements_ptr[elements_ptr.size() - 2]->linkNext(*elements_ptr[elements_ptr.size() - 1]);
-		} else {
-			ERROR(EXCEPTIONS::ELEMENTS_NOT_TOUCHING);
-		}
-	} else {
-		elements_ptr.push_back(element.copy());
+void Accelerator::addElement(Element const& element) { appendElement(element); }
+
+void Accelerator::addElements(vector<unique_ptr<Element>> const& elements) {
+	for (unique_ptr<Element> const& element_ptr : elements) { appendElement(*element_ptr); }
+}
+
+void Accelerator::appendElement(Element const& element) {
+	// Protection against non-touching elements
+	if (elements_ptr.size() > 0 and not (elements_ptr[elements_ptr.size() - 1]->getPosOut() == element.getPosIn())) {
+		ERROR(EXCEPTIONS::ELEMENTS_NOT_TOUCHING);
 	}
+
+	addedElements_ptr.push_back(element.copy(elementArena));
+
+	if (flattened) { expandElement(addedElements_ptr.back()); }
+	else { linkElement(addedElements_ptr.back()); }
+}
+
+void Accelerator::expandElement(Element * element_ptr) {
+	vector<Element *> primitives;
+	element_ptr->appendPrimitives(primitives);
+	for (Element * primitive_ptr : primitives) { linkElement(primitive_ptr); }
+
+	// A composite Element takes the place of its first section, without neighbours: it is not in the tracking lattice any more
+	if (primitives.front() != element_ptr) { element_ptr->linkAccelerator(primitives.front()->getIndex(), primitives.front()->getStartLength()); }
+}
+
+void Accelerator::linkElement(Element * element_ptr) {
+	elements_ptr.push_back(element_ptr);
+	element_ptr->linkAccelerator(elements_ptr.size() - 1, arcLengths.back());
+	if (elements_ptr.size() > 1) { elements_ptr[elements_ptr.size() - 2]->linkNext(*element_ptr); }
+
+	arcLengths.push_back(arcLengths.back() + element_ptr->getLength());
+	timeSteps.push_back(GLOBALS::DT);
+	lossMap.resize(elements_ptr.size());
+	// Rebuilt once by the next search (see Accelerator::getElementIndex())
+	elementIndexUpToDate = false;
 }
 
 void Accelerator::addBeam(Particle const& defaultParticle, size_t const& particleCount, double lambda) {
 	// Protection against no element to point to
 	if (elements_ptr.size() > 0) {
 		beams_ptr.push_back(unique_ptr<Beam>(new Beam(defaultParticle, particleCount, lambda, *this, engine_ptr)));
+		beams_ptr.back()->setLossMap(&lossMap);
+		beamIds.push_back(nextBeamId++);
 		// Beam is automatically initialize
 
 		associatedProgresses.push_back(vector<double>(1, 0));
@@ -56,43 +196,60 @@ void Accelerator::addBeam(Particle const& defaultParticle, size_t const& particl
 	}
 }
 
-void Accelerator::addParticle(Particle const& particle) {
+void Accelerator::addBeam(Particle const& defaultParticle, size_t const& particleCount, double lambda, PhaseSpaceDistribution const& distribution) {
 	// Protection against no element to point to
 	if (elements_ptr.size() > 0) {
-		// make polymorphic copy on given particle, because we will init its bound Element
-		unique_ptr<Particle> particleCopy_ptr(particle.copy());
-		// If there is only one particle, the beam is not automatically initialized !
-		initParticleToClosestElement(*particleCopy_ptr);
-		beams_ptr.push_back(unique_ptr<Beam>(new Beam(*particleCopy_ptr, engine_ptr)));
+		beams_ptr.push_back(unique_ptr<Beam>(new Beam(defaultParticle, particleCount, lambda, distribution, *this, engine_ptr)));
+		beams_ptr.back()->setLossMap(&lossMap);
+		beamIds.push_back(nextBeamId++);
+		// Beam is automatically initialize
 
 		associatedProgresses.push_back(vector<double>(1, 0));
 		size_t i(associatedProgresses.size() - 1);
 		size_t j(beams_ptr.size() - 1);
 		beams_ptr[j]->updateProgresses(associatedProgresses[i], *this);
+	} else {
+		ERROR(EXCEPTIONS::NO_ELEMENTS);
+	}
+}
 
-		// Free memory on polymorphic particle
-		particleCopy_ptr.reset();
+void Accelerator::addParticle(Particle const& particle) {
+	// Protection against no element to point to
+	if (elements_ptr.size() > 0) {
+		// The Beam binds its own copy of the particle to its Element, no intermediate copy
+		beams_ptr.push_back(unique_ptr<Beam>(new Beam(particle, *this, engine_ptr)));
+		beams_ptr.back()->setLossMap(&lossMap);
+		beamIds.push_back(nextBeamId++);
+
+		associatedProgresses.push_back(vector<double>(1, 0));
+		size_t i(associatedProgresses.size() - 1);
+		size_t j(beams_ptr.size() - 1);
+		beams_ptr[j]->updateProgresses(associatedProgresses[i], *this);
 	} else {
 		ERROR(EXCEPTIONS::NO_ELEMENTS);
 	}
 }
 
 void Accelerator::initParticleToClosestElement(Particle & particle) const {
-	bool found(false);
-	size_t index(0);
-	do {
-		double const pos(elements_ptr[index]->getParticleProgress(particle.getPos(), methodChapi));
-		bool const inWall(elements_ptr[index]->isInWall(particle));
-		if ((pos >= 0 and pos <= 1) and (not inWall)) {
-			found = true;
-			particle.setElement(elements_ptr[index].get());
-		}
-		++index;
-	} while ((not found) and index < elements_ptr.size());
+	size_t index(getElementIndex().find(particle.getPos()));
 
-	if (not found) {
+	if (index == ElementIndex::NOT_FOUND) {
 		ERROR(EXCEPTIONS::PARTICLE_NOT_IN_ACCELERATOR);
 	}
+
+	particle.setElementIndex(index);
+	particle.setElementProgress(min(max(elements_ptr[index]->getParticleProgress(particle.getPos()), 0.0), 1.0));
+}
+
+void Accelerator::initParticleAtProgress(Particle & particle, double progress) const {
+	if (elements_ptr.empty()) { ERROR(EXCEPTIONS::NO_ELEMENTS); }
+
+	double elementProgress(0);
+	size_t element(getElementIndexAtProgress(progress, elementProgress));
+
+	if (elements_ptr[element]->isInWall(particle)) { ERROR(EXCEPTIONS::PARTICLE_NOT_IN_ACCELERATOR); }
+	particle.setElementIndex(element);
+	particle.setElementProgress(elementProgress);
 }
 
 void Accelerator::closeElementLoop() {
@@ -106,12 +263,64 @@ void Accelerator::closeElementLoop() {
 	}
 }
 
+void Accelerator::flattenElements() {
+	if (flattened) { return; }
+	flattened = true;
+
+	// The tracking lattice is rebuilt from the Elements as added, closed again if it was
+	bool closed(elements_ptr.size() > 1 and elements_ptr.back()->getNext() != Element::NO_LINK);
+	elements_ptr.clear();
+	arcLengths.assign(1, 0);
+	timeSteps.clear();
+	lossMap.resize(0);
+	lossMap.reset();
+
+	for (Element * element_ptr : addedElements_ptr) { expandElement(element_ptr); }
+	if (closed) { closeElementLoop(); }
+
+	// The Particles were in the Elements as added, whose indices were their positions in addedElements_ptr
+	vector<uint32_t> firstElements(addedElements_ptr.size());
+	for (size_t i(0); i < addedElements_ptr.size(); ++i) { firstElements[i] = addedElements_ptr[i]->getIndex(); }
+	for (unique_ptr<Beam> const& beam_ptr : beams_ptr) { beam_ptr->relinkParticles(firstElements); }
+	progressesUpToDate = false;
+}
+
+void Accelerator::addInteractionRegion(double begin, double end) {
+	double length(getTotalLength());
+	if (not (begin >= 0 and begin <= length and end >= 0 and end <= length)) { ERROR(EXCEPTIONS::BAD_INTERACTION_REGION); }
+	interactionRegions.push_back(InteractionRegion{ begin, end });
+}
+
+void Accelerator::addInteractionRegion(size_t element) {
+	if (element >= elements_ptr.size()) { ERROR(EXCEPTIONS::BAD_INTERACTION_REGION); }
+	addInteractionRegion(arcLengths[element], arcLengths[element + 1]);
+}
+
+void Accelerator::clearInteractionRegions() { interactionRegions.clear(); }
+
+void Accelerator::clearLosses() { lossMap.reset(); }
+
 void Accelerator::clearBeams() {
 	beams_ptr.clear();
 	associatedProgresses.clear();
+	beamIds.clear();
 }
 
-void Accelerator::clearElements() { elements_ptr.clear(); }
+void Accelerator::clearElements() {
+	// The destructors of the Elements (and of their sections), then a single release of their memory
+	for (Element * element_ptr : addedElements_ptr) { element_ptr->~Element(); }
+	addedElements_ptr.clear();
+	elements_ptr.clear();
+	elementArena.release();
+	arcLengths.assign(1, 0);
+	timeSteps.clear();
+	lossMap.resize(0);
+	lossMap.reset();
+	elementIndex.clear();
+	elementIndexUpToDate = true;
+	// The regions are arc lengths of these Elements
+	interactionRegions.clear();
+}
 
 void Accelerator::clear() {
 	clearBeams();
@@ -119,6 +328,8 @@ void Accelerator::clear() {
 }
 
 void Accelerator::clearDeadBeams() {
+	PROFILE_SCOPE(ProfilerPhase::CLEAR_DEAD_BEAMS);
+
 	// Remove beams that does not contain any particles from the simulation
 	size_t size(beams_ptr.size());
 	for (size_t i(0); i < size; ++i) {
@@ -129,8 +340,10 @@ void Accelerator::clearDeadBeams() {
 			// faster but changes indexes
 			swap(beams_ptr[i], beams_ptr[size - 1]);
 			swap(associatedProgresses[i], associatedProgresses[size - 1]);
+			swap(beamIds[i], beamIds[size - 1]);
 			beams_ptr.pop_back();
 			associatedProgresses.pop_back();
+			beamIds.pop_back();
 
 			// using erase
 			// slower but preserves indexes
@@ -146,52 +359,42 @@ void Accelerator::clearDeadBeams() {
 
 Vector3D Accelerator::getPosAtProgress(double progress) const {
 	if (progress < 0 or progress > 1) { ERROR(EXCEPTIONS::BAD_PROGRESS); }
+	if (elements_ptr.empty()) { return Vector3D(); }
 
-	double length(getTotalLength() * progress);
-	size_t i(0);
-	size_t size(elements_ptr.size());
-	if (size == 0) { return Vector3D(); }
-
-	do {
-		length -= elements_ptr[i]->getLength();
-		++i;
-	} while (length >= 0 and i < size);
-	--i;
+	double elementProgress(0);
+	size_t i(getElementIndexAtProgress(progress, elementProgress));
+	return elements_ptr[i]->getPosAtProgress(elementProgress);
+}
 
-	double lengthElement(elements_ptr[i]->getLength());
-	length += lengthElement;
+Vector3D Accelerator::getVelAtProgress(double progress, bool clockwise) const {
+	if (progress < 0 or progress > 1) { ERROR(EXCEPTIONS::BAD_PROGRESS); }
+	if (elements_ptr.empty()) { return Vector3D(); }
 
-	double prog(length / lengthElement);
-	return elements_ptr[i]->getPosAtProgress(prog);
+	double elementProgress(0);
+	size_t i(getElementIndexAtProgress(progress, elementProgress));
+	return elements_ptr[i]->getVelAtProgress(elementProgress, clockwise);
 }
 
-Vector3D Accelerator::getVelAtProgress(double progress, bool clockwise) const {
+Vector3D Accelerator::getNormalAtProgress(double progress) const {
 	if (progress < 0 or progress > 1) { ERROR(EXCEPTIONS::BAD_PROGRESS); }
+	if (elements_ptr.empty()) { return Vector3D(); }
 
-	double length(getTotalLength() * progress);
-	size_t i(0);
-	size_t size(elements_ptr.size());
-	if (size == 0) { return Vector3D(); }
+	double elementProgress(0);
+	size_t i(getElementIndexAtProgress(progress, elementProgress));
+	return elements_ptr[i]->getNormalDirection(elements_ptr[i]->getPosAtProgress(elementProgress));
+}
 
-	do {
-		length -= elements_ptr[i]->getLength();
-		++i;
-	} while(length >= 0 and i < size);
-	--i;
+double Accelerator::getTotalLength() const { return arcLengths.back(); }
 
-	double lengthElement(elements_ptr[i]->getLength());
-	length += lengthElement;
+size_t Accelerator::getElementIndexAtProgress(double progress, double & elementProgress) const {
+	double length(getTotalLength() * progress);
 
-	double prog(length / lengthElement);
-	return elements_ptr[i]->getVelAtProgress(prog, clockwise);
-}
+	// First Element ending after `length` (the last one if `length` is the total length)
+	size_t i(upper_bound(arcLengths.begin() + 1, arcLengths.end(), length) - arcLengths.begin() - 1);
+	if (i >= elements_ptr.size()) { i = elements_ptr.size() - 1; }
 
-double Accelerator::getTotalLength() const {
-	double length(0);
-	for (shared_ptr<Element> const& element_ptr : elements_ptr) {
-		length += element_ptr->getLength();
-	}
-	return length;
+	elementProgress = (length - arcLengths[i]) / elements_ptr[i]->getLength();
+	return i;
 }
 
 double Accelerator::getParticleProgress(Vector3D const& pos) const {
@@ -207,6 +410,11 @@ double Accelerator::getParticleProgress(Vector3D const& pos) const {
 	return angle / (2 * M_PI);
 }
 
+double Accelerator::getParticleProgress(Particle const& particle) const {
+	Element const* element_ptr(&particle.getElement(elements_ptr));
+	return (element_ptr->getStartLength() + particle.getElementProgress() * element_ptr->getLength()) / getTotalLength();
+}
+
 void Accelerator::exertInteraction(size_t beam1, size_t part1, size_t beam2, size_t part2) {
 	Vector3D force(beams_ptr[beam2]->getPos(part2) - beams_ptr[beam1]->getPos(part1));
 	double r(force.norm());
@@ -220,6 +428,7 @@ void Accelerator::exertInteraction(size_t beam1, size_t part1, size_t beam2, siz
 	double charge2(beams_ptr[beam2]->getCharge());
 
 	double cst(charge1 * charge2 / (4 * M_PI * CONSTANTS::EPISLON0));
+	PROFILE_COUNT(ProfilerCounter::INTERACTION_PAIRS, 1);
 
 	// Mean of the 2 gammas
 	double gamma1(beams_ptr[beam1]->getGamma(part1));
@@ -232,10 +441,97 @@ void Accelerator::exertInteraction(size_t beam1, size_t part1, size_t beam2, siz
 	beams_ptr[beam1]->exertForce(-force, part1);
 }
 
+void Accelerator::exertSpaceCharge() {
+	for (size_t beam(0); beam < associatedProgresses.size(); ++beam) {
+		vector<double> const& progresses(associatedProgresses[beam]);
+
+		for (size_t part1(0); part1 < progresses.size(); ++part1) {
+			for (size_t part2(part1 + 1); part2 < progresses.size(); ++part2) {
+				if (abs(progresses[part1] - progresses[part2]) < GLOBALS::DELTA_INTERACTION) {
+					exertInteraction(beam, part1, beam, part2);
+				}
+			}
+		}
+	}
+}
+
+void Accelerator::exertBeamBeam() {
+	size_t nbrBeam(associatedProgresses.size());
+	if (nbrBeam < 2) { return; }
+
+	// The Particles out of the regions are left out once and for all, instead of for each pair
+	size_t nbrRegion(max<size_t>(interactionRegions.size(), 1));
+	regionParticles.resize(nbrRegion * nbrBeam);
+	for (vector<size_t> & particles : regionParticles) { particles.clear(); }
+
+	for (size_t beam(0); beam < nbrBeam; ++beam) {
+		for (size_t part(0); part < associatedProgresses[beam].size(); ++part) {
+			size_t region(getInteractionRegion(associatedProgresses[beam][part]));
+			if (region != NO_INTERACTION_REGION) { regionParticles[region * nbrBeam + beam].push_back(part); }
+		}
+	}
+
+	for (size_t region(0); region < nbrRegion; ++region) {
+		for (size_t beam1(0); beam1 < nbrBeam; ++beam1) {
+			for (size_t beam2(beam1 + 1); beam2 < nbrBeam; ++beam2) {
+
+				for (size_t part1 : regionParticles[region * nbrBeam + beam1]) {
+					for (size_t part2 : regionParticles[region * nbrBeam + beam2]) {
+						if (abs(associatedProgresses[beam1][part1] - associatedProgresses[beam2][part2]) < GLOBALS::DELTA_INTERACTION) {
+							exertInteraction(beam1, part1, beam2, part2);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
 void Accelerator::step(double dt) {
 	// Do nothing if dt is null
 	if (abs(dt) < GLOBALS::DELTA_DIV0) { return; }
+	PROFILE_SCOPE(ProfilerPhase::ACCELERATOR_STEP);
+
+	if (not progressesUpToDate) { updateProgresses(); }
+	if (reorderInterval > 0 and stepCount % reorderInterval == 0) { reorderParticles(); }
+	++stepCount;
+
+	// The progresses are normaly initialized so we can use them here
+	// 		to add interaction
+	{
+		PROFILE_SCOPE(ProfilerPhase::INTERACTIONS);
+		if (spaceCharge) { exertSpaceCharge(); }
+		exertBeamBeam();
+	}
+
+	// Step through all the particles
+	for (unique_ptr<Beam> & beam_ptr : beams_ptr) {
+		if (tolerance > 0) {
+			beam_ptr->step(dt, methodChapi, tolerance, timeSteps);
+		} else if (bucketed) {
+			beam_ptr->stepByElement(dt, methodChapi);
+		} else {
+			beam_ptr->step(dt, methodChapi);
+		}
+	}
+
+	progressesUpToDate = false;
+	lossMap.advance(dt);
+	clearDeadBeams();
+	PROFILE_SAMPLE();
+}
 
+void Accelerator::reorderParticles() {
+	PROFILE_SCOPE(ProfilerPhase::REORDER_PARTICLES);
+	// The keys of the sort are the Elements and progresses of the last Beam::updatePointedElement()
+	if (not progressesUpToDate) { updateProgresses(); }
+
+	for (size_t beam(0); beam < beams_ptr.size(); ++beam) {
+		beams_ptr[beam]->reorder(associatedProgresses[beam], threadPool_ptr);
+	}
+}
+
+void Accelerator::updateProgresses() {
 	double i(0);
 	for (unique_ptr<Beam> & beam_ptr : beams_ptr) {
 		// Change the element if the particle goes out
@@ -244,45 +540,133 @@ void Accelerator::step(double dt) {
 		beam_ptr->updateProgresses(associatedProgresses[i], *this);
 		++i;
 	}
+	progressesUpToDate = true;
+}
 
-	// The progresses are normaly initialized so we can use them here
-	// 		to add interaction
-	size_t nbrBeam(associatedProgresses.size());
+/****************************************************************
+ * Particle exchange
+ ****************************************************************/
 
-	for (size_t beam1(0); beam1 < nbrBeam; ++beam1) {
-		size_t nbrPart1(associatedProgresses[beam1].size());
-
-		for (size_t part1(0); part1 < nbrPart1; ++part1) {
-
-			for (size_t beam2(0); beam2 < nbrBeam; ++beam2) {
-				if (beam1 <= beam2) {
-					size_t nbrPart2(associatedProgresses[beam2].size());
-
-					for (size_t part2(0); part2 < nbrPart2; ++part2) 	{
-						// no interaction if the particle is the same
-						if (part1 <= part2) {
-							// cout << beam1 << "    " << part1 << "    " << beam2 << "    " << part2	 << endl;
-							if (not((beam1 == beam2) and (part1 == part2))) {
-								if (abs(associatedProgresses[beam1][part1] - associatedProgresses[	beam2][part2]) < GLOBALS::DELTA_INTERACTION) {
-									// cout << "Interaction" << endl;
-									exertInteraction(beam1, part1, beam2, part2);
-								}
-							}
-						}
-					}
-				}
-			}
+ParticleRecord Accelerator::getRecord(size_t beam, size_t part) const {
+	ParticleRecord record(beams_ptr[beam]->getRecord(part));
+	record.beam = beamIds[beam];
+	record.progress = associatedProgresses[beam][part];
+
+	record.element = beams_ptr[beam]->getElementIndex(part);
+	return record;
+}
+
+void Accelerator::exportParticles(vector<ParticleRecord> & records, function<bool(ParticleRecord const&)> const& selected) const {
+	for (size_t beam(0); beam < beams_ptr.size(); ++beam) {
+		for (size_t part(0); part < associatedProgresses[beam].size(); ++part) {
+			ParticleRecord record(getRecord(beam, part));
+			if (not selected or selected(record)) { records.push_back(record); }
 		}
 	}
+}
 
-	// Step through all the particles
-	for (unique_ptr<Beam> & beam_ptr : beams_ptr) {
-		beam_ptr->step(dt, methodChapi);
+void Accelerator::extractParticles(vector<ParticleRecord> & records, function<bool(ParticleRecord const&)> const& selected) {
+	for (size_t beam(0); beam < beams_ptr.size(); ++beam) {
+		vector<double> & progresses(associatedProgresses[beam]);
+
+		for (size_t part(0); part < progresses.size(); ++part) {
+			ParticleRecord record(getRecord(beam, part));
+			if (not selected or selected(record)) {
+				records.push_back(record);
+
+				// Same swap + pop_back as the Beam, to keep the progresses aligned
+				beams_ptr[beam]->removeParticle(part);
+				swap(progresses[part], progresses[progresses.size() - 1]);
+				progresses.pop_back();
+				--part;
+			}
+		}
 	}
 
 	clearDeadBeams();
 }
 
+void Accelerator::insertParticles(vector<ParticleRecord> const& records) {
+	if (elements_ptr.empty() and not records.empty()) { ERROR(EXCEPTIONS::NO_ELEMENTS); }
+
+	for (ParticleRecord const& record : records) {
+		// The Element is found before the Particle is built, so that a Particle out of the Accelerator is not inserted
+		size_t element(record.element);
+		if (element >= elements_ptr.size()) {
+			element = getElementIndex().find(Vector3D(record.pos[0], record.pos[1], record.pos[2]));
+			if (element == ElementIndex::NOT_FOUND) { ERROR(EXCEPTIONS::PARTICLE_NOT_IN_ACCELERATOR); }
+		}
+
+		size_t beam(0);
+		while (beam < beamIds.size() and beamIds[beam] != record.beam) { ++beam; }
+
+		auto bind = [this, &record, element](Particle & particle) {
+			particle.setElementIndex(element);
+			// As Accelerator::initParticleToClosestElement() if the Element was searched
+			if (element != record.element) {
+				particle.setElementProgress(min(max(elements_ptr[element]->getParticleProgress(particle.getPos()), 0.0), 1.0));
+			}
+		};
+
+		if (beam < beamIds.size()) {
+			// Built directly in the Arena of the Beam
+			bind(beams_ptr[beam]->insertParticle(record));
+			associatedProgresses[beam].push_back(record.progress);
+		} else {
+			// The Beam died here, but lives elsewhere
+			unique_ptr<Particle> particle(Particle::fromRecord(record, engine_ptr));
+			bind(*particle);
+			beams_ptr.push_back(unique_ptr<Beam>(new Beam(*particle, engine_ptr, record.id)));
+			beams_ptr.back()->setLattice(&elements_ptr);
+			beams_ptr.back()->setLossMap(&lossMap);
+			beamIds.push_back(record.beam);
+			associatedProgresses.push_back(vector<double>(1, record.progress));
+			if (record.beam >= nextBeamId) { nextBeamId = record.beam + 1; }
+		}
+	}
+}
+
+void Accelerator::exertInteractions(vector<ParticleRecord> const& ghosts) {
+	if (ghosts.empty()) { return; }
+	if (not progressesUpToDate) { updateProgresses(); }
+
+	for (size_t beam(0); beam < beams_ptr.size(); ++beam) {
+		double charge1(beams_ptr[beam]->getCharge());
+
+		for (size_t part(0); part < associatedProgresses[beam].size(); ++part) {
+			Vector3D pos(beams_ptr[beam]->getPos(part));
+			double gamma1(beams_ptr[beam]->getGamma(part));
+			size_t region(getInteractionRegion(associatedProgresses[beam][part]));
+
+			for (ParticleRecord const& ghost : ghosts) {
+				if (abs(associatedProgresses[beam][part] - ghost.progress) >= GLOBALS::DELTA_INTERACTION) { continue; }
+
+				// Same rules as Accelerator::step(): space charge, or both in the same interaction region
+				if (ghost.beam == beamIds[beam]) {
+					if (not spaceCharge) { continue; }
+				} else if (region == NO_INTERACTION_REGION or getInteractionRegion(ghost.progress) != region) {
+					continue;
+				}
+
+				// Same force as Accelerator::exertInteraction(), applied on one side only
+				Vector3D force(Vector3D(ghost.pos[0], ghost.pos[1], ghost.pos[2]) - pos);
+				double r(force.norm());
+				if (r < GLOBALS::EPSILON) { continue; }
+
+				double cst(charge1 * ghost.beamCharge / (4 * M_PI * CONSTANTS::EPISLON0));
+
+				// Same gamma as Particle::getGamma()
+				Vector3D speed(Vector3D(ghost.momentum[0], ghost.momentum[1], ghost.momentum[2]) / ghost.mass);
+				double gamma2(1 / sqrt(1 - speed.normSquared() / (CONSTANTS::C * CONSTANTS::C)));
+				double gamma((gamma2 + gamma1) / 2);
+
+				force *= cst / (r * r * r * gamma * gamma);
+				beams_ptr[beam]->exertForce(-force, part);
+			}
+		}
+	}
+}
+
 string const Accelerator::to_string() const {
 	stringstream stream;
 	stream << setprecision(STYLES::PRECISION);
@@ -290,10 +674,10 @@ string const Accelerator::to_string() const {
 	stream
 		<< STYLES::COLOR_YELLOW
 		<< STYLES::FORMAT_BOLD
-		<< "Accelerator contains " << elements_ptr.size() << " element(s)"
+		<< "Accelerator contains " << addedElements_ptr.size() << " element(s)"
 		<< STYLES::NONE
 		<< endl;
-	for (shared_ptr<Element> const& element_ptr : elements_ptr) stream << *element_ptr << endl;
+	for (Element const* element_ptr : addedElements_ptr) stream << *element_ptr << endl;
 	stream
 		<< STYLES::COLOR_YELLOW
 		<< STYLES::FORMAT_BOLD
@@ -329,16 +713,18 @@ void Accelerator::draw(Renderer * engine_ptr) const {
 	engine_ptr->draw(*this);
 }
 
-void Accelerator::drawBeams() const {
+void Accelerator::drawBeams(Renderer * engine_ptr) const {
+	if (engine_ptr == nullptr) engine_ptr = this->engine_ptr;
 	if (engine_ptr == nullptr) ERROR(EXCEPTIONS::NULLPTR);
 	for (unique_ptr<Beam> const& beam_ptr : beams_ptr) {
 		beam_ptr->draw(engine_ptr);
 	}
 }
 
-void Accelerator::drawElements() const {
+void Accelerator::drawElements(Renderer * engine_ptr) const {
+	if (engine_ptr == nullptr) engine_ptr = this->engine_ptr;
 	if (engine_ptr == nullptr) ERROR(EXCEPTIONS::NULLPTR);
-	for (shared_ptr<Element> const& element_ptr : elements_ptr) {
+	for (Element const* element_ptr : addedElements_ptr) {
 		element_ptr->draw(engine_ptr);
 	}
 }
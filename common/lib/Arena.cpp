@@ -0,0 +1,126 @@
+#include "include/bundle/Arena.bundle.h"
+
+using namespace std;
+
+/****************************************************************
+ * Constructors and destructors
+ ****************************************************************/
+
+Arena::Arena(size_t blockSize)
+: blockSize(blockSize), used(0), available(0), capacity(0), allocationCount(0), freeCount(0)
+{
+	if (blockSize == 0) { ERROR(EXCEPTIONS::BAD_ARENA); }
+}
+
+Arena::~Arena() { release(); }
+
+/****************************************************************
+ * Getters
+ ****************************************************************/
+
+size_t Arena::getAllocationCount() const { return allocationCount; }
+
+size_t Arena::getBlockCount() const { return blocks.size(); }
+
+size_t Arena::getCapacity() const { return capacity; }
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+void * Arena::allocate(size_t size, size_t alignment) {
+	if (alignment > alignof(max_align_t)) { ERROR(EXCEPTIONS::BAD_ARENA); }
+
+	PROFILE_COUNT(ProfilerCounter::ARENA_ALLOCATIONS, 1);
+	++allocationCount;
+
+	if (freeCount > 0) {
+		lock_guard<std::mutex> lock(mutex);
+		auto freeList(freeLists.find(size));
+		if (freeList != freeLists.end() and not freeList->second.empty()) {
+			void * memory(freeList->second.back());
+			freeList->second.pop_back();
+			--freeCount;
+			return memory;
+		}
+	}
+
+	// Padding for the alignment, the blocks themselves being aligned on max_align_t
+	size_t offset((used + alignment - 1) / alignment * alignment);
+
+	if (blocks.empty() or offset + size > available) {
+		// The objects larger than a block get a block of their own
+		size_t bytes(max(blockSize, size));
+		size_t count((bytes + sizeof(max_align_t) - 1) / sizeof(max_align_t));
+
+		PROFILE_COUNT(ProfilerCounter::ARENA_BLOCKS, 1);
+		blocks.push_back(unique_ptr<max_align_t[]>(new max_align_t[count]));
+		available = count * sizeof(max_align_t);
+		capacity += available;
+		offset = 0;
+	}
+
+	used = offset + size;
+	return reinterpret_cast<char *>(blocks.back().get()) + offset;
+}
+
+void Arena::recycle(void * memory, size_t size) {
+	lock_guard<std::mutex> lock(mutex);
+	freeLists[size].push_back(memory);
+	++freeCount;
+}
+
+void Arena::release() {
+	lock_guard<std::mutex> lock(mutex);
+	blocks.clear();
+	freeLists.clear();
+	freeCount = 0;
+	used = 0;
+	available = 0;
+	capacity = 0;
+	allocationCount = 0;
+}
+
+void Arena::swap(Arena & other) {
+	if (&other == this) { return; }
+
+	scoped_lock<std::mutex, std::mutex> lock(mutex, other.mutex);
+	std::swap(blockSize, other.blockSize);
+	blocks.swap(other.blocks);
+	std::swap(used, other.used);
+	std::swap(available, other.available);
+	std::swap(capacity, other.capacity);
+	std::swap(allocationCount, other.allocationCount);
+	freeLists.swap(other.freeLists);
+	freeCount = other.freeCount.exchange(freeCount);
+}
+
+void Arena::merge(Arena & other) {
+	if (&other == this) { return; }
+
+	scoped_lock<std::mutex, std::mutex> lock(mutex, other.mutex);
+	if (blocks.empty()) {
+		blocks.swap(other.blocks);
+		used = other.used;
+		available = other.available;
+	} else {
+		// The last block stays the one being bumped
+		blocks.insert(blocks.end() - 1, make_move_iterator(other.blocks.begin()), make_move_iterator(other.blocks.end()));
+		other.blocks.clear();
+	}
+	capacity += other.capacity;
+	allocationCount += other.allocationCount;
+
+	for (auto & freeList : other.freeLists) {
+		vector<void *> & target(freeLists[freeList.first]);
+		target.insert(target.end(), freeList.second.begin(), freeList.second.end());
+	}
+	freeCount += other.freeCount;
+
+	other.freeLists.clear();
+	other.freeCount = 0;
+	other.used = 0;
+	other.available = 0;
+	other.capacity = 0;
+	other.allocationCount = 0;
+}
@@ -0,0 +1,178 @@
+#include "include/bundle/AsyncObserver.bundle.h"
+
+using namespace std;
+
+namespace {
+	// Time the writer thread sleeps when the buffer is empty
+	chrono::microseconds const IDLE_WAIT(100);
+
+	char const* getName(ObservableKind kind) {
+		switch (kind) {
+			case ObservableKind::POSITION: return "position";
+			case ObservableKind::STATISTICS: return "statistics";
+			case ObservableKind::LOSS: return "loss";
+		}
+		return "";
+	}
+}
+
+/****************************************************************
+ * Constructors and destructor
+ ****************************************************************/
+
+AsyncObserver::AsyncObserver(ostream & stream, BackpressurePolicy policy, size_t capacity)
+: stream(stream), policy(policy), buffer(capacity), pushedSamples(0), droppedSamples(0),
+  countsKnown(false), writtenSamples(0), running(true)
+{
+	if (capacity == 0) { ERROR(EXCEPTIONS::BAD_CAPACITY); }
+	writer = thread(&AsyncObserver::write, this);
+}
+
+AsyncObserver::AsyncObserver(string const& fileName, BackpressurePolicy policy, size_t capacity)
+: fileStream(fileName), stream(fileStream), policy(policy), buffer(capacity), pushedSamples(0), droppedSamples(0),
+  countsKnown(false), writtenSamples(0), running(true)
+{
+	if (fileStream.fail()) { ERROR(EXCEPTIONS::FILE_EXCEPTION); }
+	if (capacity == 0) { ERROR(EXCEPTIONS::BAD_CAPACITY); }
+	writer = thread(&AsyncObserver::write, this);
+}
+
+AsyncObserver::~AsyncObserver() {
+	running.store(false, memory_order_release);
+	writer.join();
+	stream.flush();
+}
+
+/****************************************************************
+ * Getters
+ ****************************************************************/
+
+BackpressurePolicy AsyncObserver::getPolicy() const { return policy; }
+
+uint64_t AsyncObserver::getDroppedSamples() const { return droppedSamples; }
+
+uint64_t AsyncObserver::getWrittenSamples() const { return writtenSamples.load(memory_order_acquire); }
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+void AsyncObserver::observePositions(Accelerator const& acc, uint64_t step, double time) {
+	records.clear();
+	acc.exportParticles(records);
+
+	ObserverSample sample = {};
+	sample.kind = ObservableKind::POSITION;
+	sample.step = step;
+	sample.time = time;
+
+	for (ParticleRecord const& record : records) {
+		sample.beam = record.beam;
+		sample.record = record;
+		push(sample);
+	}
+}
+
+void AsyncObserver::observeStatistics(Accelerator const& acc, uint64_t step, double time) {
+	ObserverSample sample = {};
+	sample.kind = ObservableKind::STATISTICS;
+	sample.step = step;
+	sample.time = time;
+
+	for (size_t beam(0); beam < acc.getBeamCount(); ++beam) {
+		Beam const& b(acc.getBeam(beam));
+		sample.beam = acc.getBeamId(beam);
+		sample.count = b.getParticleCount();
+		sample.energy = b.getMeanEnergy();
+		sample.emittanceR = b.getEmittanceR();
+		sample.emittanceZ = b.getEmittanceZ();
+		push(sample);
+	}
+}
+
+void AsyncObserver::observeLosses(Accelerator const& acc, uint64_t step, double time) {
+	currentCounts.clear();
+	for (size_t beam(0); beam < acc.getBeamCount(); ++beam) {
+		currentCounts.push_back(make_pair(acc.getBeamId(beam), acc.getBeam(beam).getParticleCount()));
+	}
+
+	if (countsKnown) {
+		ObserverSample sample = {};
+		sample.kind = ObservableKind::LOSS;
+		sample.step = step;
+		sample.time = time;
+
+		// The Beams keep their order in the Accelerator, a Beam which is not found anymore was cleared
+		size_t current(0);
+		for (pair<uint32_t, size_t> const& previous : previousCounts) {
+			size_t count(0);
+			if (current < currentCounts.size() and currentCounts[current].first == previous.first) {
+				count = currentCounts[current].second;
+				++current;
+			}
+
+			if (count < previous.second) {
+				sample.beam = previous.first;
+				sample.count = previous.second - count;
+				push(sample);
+			}
+		}
+	}
+
+	swap(previousCounts, currentCounts);
+	countsKnown = true;
+}
+
+void AsyncObserver::flush() {
+	while (writtenSamples.load(memory_order_acquire) < pushedSamples) { this_thread::yield(); }
+	stream.flush();
+}
+
+/****************************************************************
+ * Private methods
+ ****************************************************************/
+
+void AsyncObserver::push(ObserverSample const& sample) {
+	if (policy == BackpressurePolicy::BLOCK) {
+		while (not buffer.tryPush(sample)) { this_thread::yield(); }
+	} else if (not buffer.tryPush(sample)) {
+		++droppedSamples;
+		return;
+	}
+	++pushedSamples;
+}
+
+void AsyncObserver::write() {
+	stream << setprecision(STYLES::PRECISION);
+
+	ObserverSample sample;
+	while (true) {
+		// Read `running` before trying to pop, so that the samples pushed before the destructor are all written
+		bool stopping(not running.load(memory_order_acquire));
+
+		if (not buffer.tryPop(sample)) {
+			if (stopping) { return; }
+			this_thread::sleep_for(IDLE_WAIT);
+			continue;
+		}
+
+		stream << getName(sample.kind) << ',' << sample.step << ',' << sample.time << ',' << sample.beam << ',';
+		switch (sample.kind) {
+			case ObservableKind::POSITION:
+				stream
+					<< sample.record.element << ',' << sample.record.progress << ','
+					<< sample.record.pos[0] << ',' << sample.record.pos[1] << ',' << sample.record.pos[2] << ','
+					<< sample.record.momentum[0] << ',' << sample.record.momentum[1] << ',' << sample.record.momentum[2];
+				break;
+			case ObservableKind::STATISTICS:
+				stream << sample.count << ',' << sample.energy << ',' << sample.emittanceR << ',' << sample.emittanceZ;
+				break;
+			case ObservableKind::LOSS:
+				stream << sample.count;
+				break;
+		}
+		stream << '\n';
+
+		writtenSamples.fetch_add(1, memory_order_release);
+	}
+}
@@ -2,13 +2,75 @@
 
 using namespace std;
 
+namespace {
+	// Number of values of a digit of the radix sort (8 bits per pass)
+	size_t const RADIX(256);
+
+	/**
+	 * Fills `order` with the indexes of `keys` sorted by increasing key, keeping the order of the equal keys
+	 *
+	 * Least significant digit radix sort: each pass counts the digits of each chunk of GLOBALS::PARALLEL_GRAIN indexes
+	 * (the chunks of ThreadPool::parallelFor()), then each chunk scatters its indexes from its own offsets
+	 */
+
+	void radixSort(vector<uint64_t> const& keys, vector<size_t> & order, ThreadPool * threadPool_ptr) {
+		size_t const count(keys.size());
+		order.resize(count);
+		iota(order.begin(), order.end(), size_t(0));
+		if (count < 2) { return; }
+
+		bool const parallel(threadPool_ptr != nullptr and count > GLOBALS::PARALLEL_GRAIN);
+		size_t const chunkCount(parallel ? (count + GLOBALS::PARALLEL_GRAIN - 1) / GLOBALS::PARALLEL_GRAIN : 1);
+		auto forChunks = [threadPool_ptr, parallel, count](function<void(size_t, size_t)> const& body) {
+			if (parallel) { threadPool_ptr->parallelFor(0, count, body); }
+			else { body(0, count); }
+		};
+
+		// The digits which are the same for all the keys (e.g. the high bits of the Element index) need no pass
+		uint64_t differing(0);
+		for (uint64_t key : keys) { differing |= key ^ keys[0]; }
+
+		vector<size_t> next(count);
+		vector<size_t> offsets(chunkCount * RADIX);
+
+		for (unsigned int shift(0); shift < 64; shift += 8) {
+			if (((differing >> shift) & (RADIX - 1)) == 0) { continue; }
+
+			fill(offsets.begin(), offsets.end(), 0);
+			forChunks([&keys, &order, &offsets, shift](size_t begin, size_t end) {
+				size_t * counts(&offsets[begin / GLOBALS::PARALLEL_GRAIN * RADIX]);
+				for (size_t i(begin); i < end; ++i) { ++counts[(keys[order[i]] >> shift) & (RADIX - 1)]; }
+			});
+
+			// Offsets digit by digit, then chunk by chunk, for the sort to be stable
+			size_t total(0);
+			for (size_t digit(0); digit < RADIX; ++digit) {
+				for (size_t chunk(0); chunk < chunkCount; ++chunk) {
+					size_t counted(offsets[chunk * RADIX + digit]);
+					offsets[chunk * RADIX + digit] = total;
+					total += counted;
+				}
+			}
+
+			forChunks([&keys, &order, &next, &offsets, shift](size_t begin, size_t end) {
+				size_t * offset(&offsets[begin / GLOBALS::PARALLEL_GRAIN * RADIX]);
+				for (size_t i(begin); i < end; ++i) { next[offset[(keys[order[i]] >> shift) & (RADIX - 1)]++] = order[i]; }
+			});
+			order.swap(next);
+		}
+	}
+
+	// Table of the Beams without Accelerator, whose Particles are in standalone Elements (see Particle::setElement())
+	vector<Element *> const NO_LATTICE;
+}
+
 /****************************************************************
  * Constructors
  ****************************************************************/
 
 Beam::Beam(Particle const& defaultParticle, size_t const& particleCount, double lambda, Accelerator const& acc, Renderer * engine)
 : Drawable(engine),
-  defaultParticle_ptr(defaultParticle.copy()), particleCount(particleCount), lambda(lambda)
+  defaultParticle_ptr(defaultParticle.copy()), particleCount(particleCount), lambda(lambda), nextParticleId(0), lattice_ptr(&acc.getElements()), lossMap_ptr(nullptr), bucketsUpToDate(false)
 {
 	if (particleCount == 0) {
 		ERROR(EXCEPTIONS::NO_PARTICLES);
@@ -18,10 +80,9 @@ Beam::Beam(Particle const& defaultParticle, size_t const& particleCount, double
 	}
 
 	bool beamFromParticle(acc.getBeamFromParticle());
+	size_t lastPart(particleCount / lambda);
 
 	if (beamFromParticle) {
-		int lastPart(particleCount / lambda);
-
 		unique_ptr<Particle> temporaryPart(
 			unique_ptr<Particle>(defaultParticle.scaledCopy(
 				defaultParticle_ptr->getPos(),
@@ -36,44 +97,99 @@ Beam::Beam(Particle const& defaultParticle, size_t const& particleCount, double
 		// To trigger the exception if the initial particle is outside the accelerator
 		acc.initParticleToClosestElement(*temporaryPart);
 
-		for (double i(0); i < lastPart; ++i) {
-			temporaryPart->getElementPtr()->updatePointedElement(*temporaryPart);
-			temporaryPart->step();
-			this->particles_ptr.push_back(temporaryPart->copy());
+		// The Particles are allocated in bulk as copies of the source...
+		fillParticles(acc, lastPart, temporaryPart->getSize(), [this, &temporaryPart](size_t begin, size_t end, Arena & arena) {
+			for (size_t i(begin); i < end; ++i) {
+				particles_ptr[i] = temporaryPart->copy(arena);
+			}
+		});
+
+		// ...so that the stepping loop only overwrites their state, without any allocation
+		for (size_t i(0); i < lastPart; ++i) {
+			getElement(*temporaryPart).updatePointedElement(*temporaryPart, acc.getElements());
+			temporaryPart->step(GLOBALS::DT, getElement(*temporaryPart).getField(temporaryPart->getPos(), false));
+			*particles_ptr[i] = *temporaryPart;
 		}
 
-
 	} else {
 		// To trigger the exception if the initial particle is outside the accelerator
 		acc.initParticleToClosestElement(*defaultParticle_ptr);
 
 		double orientation(Vector3D::tripleProduct(Vector3D(0, 0, 1), defaultParticle_ptr->getPos(), defaultParticle_ptr->getPos() + defaultParticle_ptr->getSpeed()));
 		bool clockwise((orientation < 0));
-		int lastPart(particleCount / lambda);
 
-		for (double i(0); i < lastPart; ++i) {
-			// i is a double to avoid division of 2 integers
-			double progress(i / lastPart);
+		double energy(CONVERT::EnergySItoGeV(defaultParticle_ptr->getEnergy()));
+		double mass(CONVERT::MassSItoGeV(defaultParticle_ptr->getMass()));
+		int charge(defaultParticle_ptr->getChargeNumber());
+
+		// Each chunk only writes its own slots
+		fillParticles(acc, lastPart, defaultParticle.getSize(), [this, &defaultParticle, &acc, lastPart, clockwise, energy, mass, charge, lambda](size_t begin, size_t end, Arena & arena) {
+			for (size_t i(begin); i < end; ++i) {
+				// i is converted to avoid division of 2 integers
+				double progress(double(i) / lastPart);
 
-			this->particles_ptr.push_back(
-				unique_ptr<Particle>(defaultParticle.scaledCopy(
+				particles_ptr[i] = defaultParticle.scaledCopy(
 					acc.getPosAtProgress(progress),
-					CONVERT::EnergySItoGeV(defaultParticle_ptr->getEnergy()),
+					energy,
 					acc.getVelAtProgress(progress, clockwise),
-					CONVERT::MassSItoGeV(defaultParticle_ptr->getMass()),
-					defaultParticle_ptr->getChargeNumber(),
-					lambda
-				))
-			);
+					mass,
+					charge,
+					lambda,
+					arena
+				);
+
+				// The Element is known from the arc length, no need to search for it
+				acc.initParticleAtProgress(*particles_ptr[i], progress);
+			}
+		});
+	}
+}
 
-			acc.initParticleToClosestElement(*particles_ptr[i]);
-		}
+Beam::Beam(Particle const& defaultParticle, size_t const& particleCount, double lambda, PhaseSpaceDistribution const& distribution, Accelerator const& acc, Renderer * engine)
+: Drawable(engine),
+  defaultParticle_ptr(defaultParticle.copy()), particleCount(particleCount), lambda(lambda), nextParticleId(0), lattice_ptr(&acc.getElements()), lossMap_ptr(nullptr), bucketsUpToDate(false)
+{
+	if (particleCount == 0) {
+		ERROR(EXCEPTIONS::NO_PARTICLES);
 	}
+	if (lambda < 1) {
+		ERROR(EXCEPTIONS::BAD_LAMBDA);
+	}
+
+	// To trigger the exception if the initial particle is outside the accelerator
+	acc.initParticleToClosestElement(*defaultParticle_ptr);
+
+	double orientation(Vector3D::tripleProduct(Vector3D(0, 0, 1), defaultParticle_ptr->getPos(), defaultParticle_ptr->getPos() + defaultParticle_ptr->getSpeed()));
+	bool clockwise((orientation < 0));
+	size_t lastPart(particleCount / lambda);
+
+	double energy(CONVERT::EnergySItoGeV(defaultParticle_ptr->getEnergy()));
+	double mass(CONVERT::MassSItoGeV(defaultParticle_ptr->getMass()));
+	int charge(defaultParticle_ptr->getChargeNumber());
+	double speed(defaultParticle_ptr->getSpeed().norm());
+
+	// The samples only depend on their index, so the Beam does not depend on the number of threads
+	fillParticles(acc, lastPart, defaultParticle.getSize(), [this, &defaultParticle, &distribution, &acc, lastPart, clockwise, energy, mass, charge, speed, lambda](size_t begin, size_t end, Arena & arena) {
+		Vector3D const vertical(0, 0, 1);
+
+		for (size_t i(begin); i < end; ++i) {
+			double progress(double(i) / lastPart);
+			PhaseSpaceSample sample(distribution.sample(i));
+			Vector3D normal(acc.getNormalAtProgress(progress));
+
+			// Offsets around the ideal trajectory, along the normal and the vertical axis
+			Vector3D pos(acc.getPosAtProgress(progress) + sample.r * normal + sample.z * vertical);
+			Vector3D direction(~acc.getVelAtProgress(progress, clockwise) * speed + sample.vr * normal + sample.vz * vertical);
+
+			particles_ptr[i] = defaultParticle.scaledCopy(pos, energy * sample.energyFactor, direction, mass, charge, lambda, arena);
+			acc.initParticleAtProgress(*particles_ptr[i], progress);
+		}
+	});
 }
 
-Beam::Beam(Particle const& defaultParticle, Renderer * engine)
+Beam::Beam(Particle const& defaultParticle, Renderer * engine, uint32_t particleId)
 : Drawable(engine),
-  defaultParticle_ptr(defaultParticle.copy()), particleCount(1), lambda(1)
+  defaultParticle_ptr(defaultParticle.copy()), particleCount(1), lambda(1), nextParticleId(particleId), lattice_ptr(nullptr), lossMap_ptr(nullptr), bucketsUpToDate(false)
 {
 	if (particleCount == 0) {
 		ERROR(EXCEPTIONS::NO_PARTICLES);
@@ -81,7 +197,17 @@ Beam::Beam(Particle const& defaultParticle, Renderer * engine)
 	if (lambda < 1) {
 		ERROR(EXCEPTIONS::BAD_LAMBDA);
 	}
-	particles_ptr.push_back(defaultParticle.copy());
+	particles_ptr.push_back(defaultParticle.copy(particleArena));
+	particleIds.push_back(nextParticleId++);
+}
+
+Beam::Beam(Particle const& defaultParticle, Accelerator const& acc, Renderer * engine)
+: Beam(defaultParticle, engine)
+{
+	lattice_ptr = &acc.getElements();
+	// To trigger the exception if the particle is outside the accelerator
+	acc.initParticleToClosestElement(*particles_ptr[0]);
+	*defaultParticle_ptr = *particles_ptr[0];
 }
 
 /****************************************************************
@@ -90,7 +216,11 @@ Beam::Beam(Particle const& defaultParticle, Renderer * engine)
 
 Beam::~Beam() {
 	defaultParticle_ptr.reset();
+
+	// The destructors of the Particles, then a single release of their memory
+	for (Particle * particle_ptr : particles_ptr) { particle_ptr->~Particle(); }
 	particles_ptr.clear();
+	particleArena.release();
 }
 
 /****************************************************************
@@ -99,13 +229,15 @@ Beam::~Beam() {
 
 double Beam::getMeanEnergy() const {
 	double mean(0.0);
-	for (unique_ptr<Particle> const& particle_ptr : particles_ptr) {
+	for (Particle const* particle_ptr : particles_ptr) {
 		mean += particle_ptr->getEnergy();
 	}
 	mean /= particles_ptr.size();
 	return CONVERT::EnergySItoGeV(mean);
 }
 
+size_t Beam::getParticleCount() const { return particles_ptr.size(); }
+
 double Beam::getGamma(size_t part) const {
 	if (part < particles_ptr.size()) {
 		return particles_ptr[part]->getGamma();
@@ -122,6 +254,51 @@ Vector3D Beam::getPos(size_t part) const {
 	}
 }
 
+Vector3D Beam::getPhaseR(size_t part) const {
+	if (part >= particles_ptr.size()) { ERROR(EXCEPTIONS::NO_PARTICLES); }
+	Particle const& particle(*particles_ptr[part]);
+	Vector3D perpDirectionElement(getElement(particle).getNormalDirection(particle.getPos()));
+	return Vector3D(particle.getPos() * perpDirectionElement, particle.getSpeed() * perpDirectionElement, 0);
+}
+
+Vector3D Beam::getPhaseZ(size_t part) const {
+	if (part >= particles_ptr.size()) { ERROR(EXCEPTIONS::NO_PARTICLES); }
+	Particle const& particle(*particles_ptr[part]);
+	return Vector3D(particle.getPos().getZ(), particle.getSpeed().getZ(), 0);
+}
+
+Element const* Beam::getElementPtr(size_t part) const {
+	if (part < particles_ptr.size()) {
+		return &getElement(*particles_ptr[part]);
+	} else {
+		ERROR(EXCEPTIONS::NO_PARTICLES);
+	}
+}
+
+uint32_t Beam::getElementIndex(size_t part) const {
+	if (part >= particles_ptr.size()) { ERROR(EXCEPTIONS::NO_PARTICLES); }
+	return particles_ptr[part]->getElementIndex();
+}
+
+uint32_t Beam::getParticleId(size_t part) const {
+	if (part < particleIds.size()) {
+		return particleIds[part];
+	} else {
+		ERROR(EXCEPTIONS::NO_PARTICLES);
+	}
+}
+
+ParticleRecord Beam::getRecord(size_t part) const {
+	if (part < particles_ptr.size()) {
+		ParticleRecord record(particles_ptr[part]->toRecord());
+		record.beamCharge = getCharge();
+		record.id = particleIds[part];
+		return record;
+	} else {
+		ERROR(EXCEPTIONS::NO_PARTICLES);
+	}
+}
+
 double Beam::getCharge() const {
 	return (lambda * defaultParticle_ptr->getCharge());
 }
@@ -196,8 +373,8 @@ Vector3D const Beam::getRMeans() const {
 	double vr(0.0);
 	Vector3D perpDirectionElement;
 
-	for (unique_ptr<Particle> const& particle_ptr : particles_ptr) {
-		perpDirectionElement = particle_ptr->getElementPtr()->getNormalDirection(particle_ptr->getPos());
+	for (Particle const* particle_ptr : particles_ptr) {
+		perpDirectionElement = getElement(*particle_ptr).getNormalDirection(particle_ptr->getPos());
 		r = particle_ptr->getPos() * perpDirectionElement;
 		vr = particle_ptr->getSpeed() * perpDirectionElement;
 
@@ -216,7 +393,7 @@ Vector3D const Beam::getZMeans() const {
 	double z(0.0);
 	double vz(0.0);
 
-	for (unique_ptr<Particle> const& particle_ptr : particles_ptr) {
+	for (Particle const* particle_ptr : particles_ptr) {
 		z = particle_ptr->getPos().getZ();
 		vz = particle_ptr->getSpeed().getZ();
 
@@ -228,23 +405,130 @@ Vector3D const Beam::getZMeans() const {
 	return (Vector3D(moyZ_Squared, moyVz_Squared, moyZ_Vz) /= particleCount);
 }
 
+/****************************************************************
+ * Setters
+ ****************************************************************/
+
+void Beam::setLossMap(LossMap * lossMap_ptr) { this->lossMap_ptr = lossMap_ptr; }
+
+void Beam::setLattice(vector<Element *> const* lattice_ptr) { this->lattice_ptr = lattice_ptr; }
+
 /****************************************************************
  * Methods
  ****************************************************************/
 
 void Beam::step(double dt, bool methodChapi) {
 	if (abs(dt) < GLOBALS::DELTA_DIV0) { return; }
+	PROFILE_SCOPE(ProfilerPhase::BEAM_STEP);
 
 	// exertInteractions();
 
-	for (unique_ptr<Particle> & particle_ptr : particles_ptr) {
-		particle_ptr->step(dt, methodChapi);
+	{
+		PROFILE_SCOPE(ProfilerPhase::PARTICLE_STEP);
+		for (Particle * particle_ptr : particles_ptr) {
+			particle_ptr->step(dt, getElement(*particle_ptr).getField(particle_ptr->getPos(), methodChapi));
+		}
 	}
 
 	// At the end because we can't initialize particles (basis of beams) outside the accelerator
 	clearDeadParticles();
 }
 
+void Beam::step(double duration, bool methodChapi, double tolerance, vector<double> & timeSteps) {
+	if (duration < GLOBALS::DELTA_DIV0) { return; }
+	PROFILE_SCOPE(ProfilerPhase::BEAM_STEP);
+
+	{
+		PROFILE_SCOPE(ProfilerPhase::PARTICLE_STEP);
+		for (Particle * particle_ptr : particles_ptr) {
+			stepAdaptive(*particle_ptr, duration, methodChapi, tolerance, timeSteps);
+		}
+	}
+
+	// The Particles changed Element during the interval
+	bucketsUpToDate = false;
+
+	clearDeadParticles();
+}
+
+void Beam::stepByElement(double dt, bool methodChapi) {
+	if (abs(dt) < GLOBALS::DELTA_DIV0) { return; }
+	PROFILE_SCOPE(ProfilerPhase::BEAM_STEP);
+
+	if (not bucketsUpToDate) { buildBuckets(); }
+
+	{
+		PROFILE_SCOPE(ProfilerPhase::PARTICLE_STEP);
+		for (vector<size_t> const& bucket : elementParticles) {
+			if (bucket.empty()) { continue; }
+			Element const* element_ptr(&getElement(*particles_ptr[bucket[0]]));
+
+			bucketPositions.resize(bucket.size());
+			for (size_t i(0); i < bucket.size(); ++i) { bucketPositions[i] = particles_ptr[bucket[i]]->getPos(); }
+			element_ptr->getFields(bucketPositions, bucketFields, methodChapi);
+			for (size_t i(0); i < bucket.size(); ++i) { particles_ptr[bucket[i]]->step(dt, bucketFields[i]); }
+		}
+	}
+
+	clearDeadParticles();
+}
+
+void Beam::stepAdaptive(Particle & particle, double duration, bool methodChapi, double tolerance, vector<double> & timeSteps) const {
+	if (lattice_ptr == nullptr) { ERROR(EXCEPTIONS::NULLPTR); }
+	vector<Element *> const& lattice(*lattice_ptr);
+	// The interactions are only computed once per interval, so they are exerted again before each step
+	Vector3D const forces(particle.getForces());
+	double time(0);
+
+	while (time < duration) {
+		Element const* element_ptr(&particle.getElement(lattice));
+		double & elementStep(timeSteps[element_ptr->getIndex()]);
+
+		// Not further than the end of the interval, nor than the next Element (see Element::updatePointedElement())
+		double dt(min(elementStep, duration - time));
+		double speed(particle.getSpeed().norm());
+		if (speed > GLOBALS::DELTA_DIV0) { dt = min(dt, element_ptr->getLength() / speed); }
+		bool const clipped(dt < elementStep);
+		bool const last(dt >= duration - time);
+
+		Vector3D const field(element_ptr->getField(particle.getPos(), methodChapi));
+		Particle full(particle);
+		full.step(dt, field);
+
+		Particle half(particle);
+		half.step(dt / 2, field);
+		element_ptr->updatePointedElement(half, lattice, methodChapi);
+		half.exertForce(forces);
+		half.step(dt / 2, half.getElement(lattice).getField(half.getPos(), methodChapi));
+
+		// The local error of the Euler integration is in dt^2
+		double error((full.getPos() - half.getPos()).norm());
+		double factor(error > GLOBALS::DELTA_DIV0 ? GLOBALS::ADAPTIVE_SAFETY * sqrt(tolerance / error) : GLOBALS::ADAPTIVE_MAX_GROWTH);
+		factor = min(max(factor, GLOBALS::ADAPTIVE_MIN_SHRINK), GLOBALS::ADAPTIVE_MAX_GROWTH);
+
+		if (error > tolerance and dt > GLOBALS::DT_MIN) {
+			PROFILE_COUNT(ProfilerCounter::REJECTED_STEPS, 1);
+			elementStep = max(dt * factor, GLOBALS::DT_MIN);
+			continue;
+		}
+
+		// The error is that of the full step, the two half steps being more precise
+		particle = half;
+		// A step shortened by the end of the interval or of the Element says nothing of the next one
+		if (not clipped or factor < 1) { elementStep = max(dt * factor, GLOBALS::DT_MIN); }
+
+		// A Particle which hit the wall of its Element stops there, to be removed (and counted) in this Element by Beam::clearDeadParticles()
+		if (element_ptr->isInWall(particle)) {
+			particle.setElementProgress(min(max(element_ptr->getParticleProgress(particle.getPos()), 0.0), 1.0));
+			break;
+		}
+
+		particle.getElement(lattice).updatePointedElement(particle, lattice, methodChapi);
+		time = last ? duration : time + dt;
+		if (time < duration) { particle.exertForce(forces); }
+	}
+}
+
 // void Beam::exertInteractions() {
 // 	if (particles_ptr.size() < 2) { return; }
 
@@ -264,17 +548,114 @@ void Beam::step(double dt, bool methodChapi) {
 // 	}
 // }
 
+void Beam::reorder(vector<double> & associatedProgress, ThreadPool * threadPool_ptr) {
+	size_t const count(particles_ptr.size());
+
+	// Index of the Element in the high bits, progress in the Element in the low bits
+	vector<uint64_t> keys(count);
+	for (size_t i(0); i < count; ++i) {
+		uint64_t progress(uint64_t(particles_ptr[i]->getElementProgress() * numeric_limits<uint32_t>::max()));
+		keys[i] = uint64_t(particles_ptr[i]->getElementIndex()) << 32 | progress;
+	}
+
+	vector<size_t> order;
+	radixSort(keys, order, threadPool_ptr);
+
+	// The Particles are copied in sorted order at the end of a new Arena, the old one being released at once:
+	// their memory follows the sort, and the memory of the lost Particles is given back on the way
+	Arena sortedArena;
+	vector<Particle *> sorted(count);
+	vector<uint32_t> sortedIds(count);
+	for (size_t i(0); i < count; ++i) {
+		sorted[i] = particles_ptr[order[i]]->copy(sortedArena);
+		sortedIds[i] = particleIds[order[i]];
+	}
+	for (Particle * particle_ptr : particles_ptr) { particle_ptr->~Particle(); }
+	particleArena.swap(sortedArena);
+	particles_ptr.swap(sorted);
+	particleIds.swap(sortedIds);
+
+	if (associatedProgress.size() == count) {
+		vector<double> sortedProgress(count);
+		for (size_t i(0); i < count; ++i) { sortedProgress[i] = associatedProgress[order[i]]; }
+		associatedProgress.swap(sortedProgress);
+	}
+
+	bucketsUpToDate = false;
+}
+
+Element const& Beam::getElement(Particle const& particle) const {
+	return particle.getElement(lattice_ptr != nullptr ? *lattice_ptr : NO_LATTICE);
+}
+
+void Beam::buildBuckets() {
+	for (vector<size_t> & bucket : elementParticles) { bucket.clear(); }
+	bucketSlots.resize(particles_ptr.size());
+
+	for (size_t part(0); part < particles_ptr.size(); ++part) {
+		size_t element(particles_ptr[part]->getElementIndex());
+		if (element >= elementParticles.size()) { elementParticles.resize(element + 1); }
+		bucketSlots[part] = elementParticles[element].size();
+		elementParticles[element].push_back(part);
+	}
+	bucketsUpToDate = true;
+}
+
+void Beam::moveToBucket(size_t part, size_t from, size_t to) {
+	// swap + pop_back in the bucket it leaves
+	vector<size_t> & source(elementParticles[from]);
+	size_t slot(bucketSlots[part]);
+	source[slot] = source.back();
+	bucketSlots[source[slot]] = slot;
+	source.pop_back();
+
+	if (to >= elementParticles.size()) { elementParticles.resize(to + 1); }
+	bucketSlots[part] = elementParticles[to].size();
+	elementParticles[to].push_back(part);
+}
+
+void Beam::fillParticles(Accelerator const& acc, size_t count, size_t size, function<void(size_t, size_t, Arena &)> const& body) {
+	// All the slots at once: no reallocation while filling them
+	particles_ptr.resize(count);
+
+	// The ids follow the order of construction
+	particleIds.resize(count);
+	iota(particleIds.begin(), particleIds.end(), uint32_t(0));
+	nextParticleId = uint32_t(count);
+
+	// The Particles of a chunk are bumped one after the other in a block of their own, without any lock
+	auto chunk = [this, size, &body](size_t begin, size_t end) {
+		if (begin == end) { return; }
+		Arena arena(size * (end - begin));
+		body(begin, end, arena);
+		particleArena.merge(arena);
+	};
+
+	ThreadPool * threadPool_ptr(acc.getThreadPool());
+	if (threadPool_ptr != nullptr) { threadPool_ptr->parallelFor(0, count, chunk); }
+	else { chunk(0, count); }
+}
+
 void Beam::clearDeadParticles() {
+	PROFILE_SCOPE(ProfilerPhase::CLEAR_DEAD_PARTICLES);
+
 	// Remove particles that are out of the simulation
 	size_t size(particles_ptr.size());
 	for (size_t i(0); i < size; ++i) {
-		if (particles_ptr[i]->getElementPtr()->isInWall(*particles_ptr[i])) {
-			particles_ptr[i].reset();
+		Element const& element(getElement(*particles_ptr[i]));
+		if (element.isInWall(*particles_ptr[i])) {
+			PROFILE_COUNT(ProfilerCounter::PARTICLES_LOST, 1);
+			if (lossMap_ptr != nullptr) { lossMap_ptr->record(*particles_ptr[i], element); }
+			// Its memory goes back to the Arena, for the Particles received later (see Beam::insertParticle())
+			particleArena.destroy(particles_ptr[i], particles_ptr[i]->getSize());
+			bucketsUpToDate = false;
 
 			// using swap + pop_back
 			// faster but changes indexes
 			swap(particles_ptr[i], particles_ptr[size - 1]);
 			particles_ptr.pop_back();
+			swap(particleIds[i], particleIds[size - 1]);
+			particleIds.pop_back();
 
 			// using erase
 			// slower but preserves indexes
@@ -293,16 +674,53 @@ bool Beam::noParticle() const {
 	else { return true; }
 }
 
-void Beam::updatePointedElement(bool methodChapi) const {
-	for (unique_ptr<Particle> const& particle_ptr : particles_ptr) {
-		particle_ptr->getElementPtr()->updatePointedElement(*particle_ptr, methodChapi);
+void Beam::updatePointedElement(bool methodChapi) {
+	PROFILE_SCOPE(ProfilerPhase::UPDATE_POINTED_ELEMENT);
+	if (lattice_ptr == nullptr) { ERROR(EXCEPTIONS::NULLPTR); }
+	vector<Element *> const& lattice(*lattice_ptr);
+
+	for (size_t part(0); part < particles_ptr.size(); ++part) {
+		Particle & particle(*particles_ptr[part]);
+		uint32_t element(particle.getElementIndex());
+		particle.getElement(lattice).updatePointedElement(particle, lattice, methodChapi);
+
+		uint32_t next(particle.getElementIndex());
+		if (bucketsUpToDate and next != element) { moveToBucket(part, element, next); }
+	}
+}
+
+void Beam::relinkParticles(vector<uint32_t> const& firstElements) {
+	if (lattice_ptr == nullptr) { ERROR(EXCEPTIONS::NULLPTR); }
+	vector<Element *> const& lattice(*lattice_ptr);
+
+	for (Particle * particle_ptr : particles_ptr) {
+		uint32_t previous(particle_ptr->getElementIndex());
+		if (previous >= firstElements.size()) { ERROR(EXCEPTIONS::NO_ELEMENT); }
+		size_t first(firstElements[previous]);
+		size_t last(previous + 1 < firstElements.size() ? firstElements[previous + 1] : lattice.size());
+
+		// The first of the Elements which replaced the previous one that the Particle has not gone past
+		size_t element(first);
+		double progress(lattice[element]->getParticleProgress(particle_ptr->getPos()));
+		while (progress > 1 and element + 1 < last) { progress = lattice[++element]->getParticleProgress(particle_ptr->getPos()); }
+
+		particle_ptr->setElementIndex(element);
+		particle_ptr->setElementProgress(min(max(progress, 0.0), 1.0));
 	}
+	bucketsUpToDate = false;
+}
+
+vector<size_t> const& Beam::getElementParticles(size_t element) {
+	if (not bucketsUpToDate) { buildBuckets(); }
+	if (element >= elementParticles.size()) { elementParticles.resize(element + 1); }
+	return elementParticles[element];
 }
 
 void Beam::updateProgresses(vector<double> & associatedProgress, Accelerator const& acc) const {
-	associatedProgress.clear();
-	for (unique_ptr<Particle> const& particle_ptr : particles_ptr) {
-		associatedProgress.push_back(acc.getParticleProgress(particle_ptr->getPos()));
+	PROFILE_SCOPE(ProfilerPhase::UPDATE_PROGRESSES);
+	associatedProgress.resize(particles_ptr.size());
+	for (size_t i(0); i < particles_ptr.size(); ++i) {
+		associatedProgress[i] = acc.getParticleProgress(*particles_ptr[i]);
 	}
 }
 
@@ -314,6 +732,27 @@ void Beam::exertForce(Vector3D const& force, size_t part) {
 	}
 }
 
+void Beam::removeParticle(size_t part) {
+	if (part >= particles_ptr.size()) { ERROR(EXCEPTIONS::NO_PARTICLES); }
+
+	particleArena.destroy(particles_ptr[part], particles_ptr[part]->getSize());
+	swap(particles_ptr[part], particles_ptr[particles_ptr.size() - 1]);
+	particles_ptr.pop_back();
+	swap(particleIds[part], particleIds[particleIds.size() - 1]);
+	particleIds.pop_back();
+	bucketsUpToDate = false;
+}
+
+Particle & Beam::insertParticle(ParticleRecord const& record) {
+	particles_ptr.push_back(Particle::fromRecord(record, particleArena, engine_ptr));
+	// A Particle keeps its id when it comes back (see Accelerator::extractParticles())
+	particleIds.push_back(record.id);
+	nextParticleId = max(nextParticleId, record.id + 1);
+	// Not bound to its Element yet
+	bucketsUpToDate = false;
+	return *particles_ptr.back();
+}
+
 string const Beam::to_string() const {
 	stringstream stream;
 	stream << setprecision(STYLES::PRECISION);
@@ -425,9 +864,10 @@ void Beam::draw(Renderer * engine_ptr) const {
 	engine_ptr->draw(*this);
 }
 
-void Beam::drawParticles() const {
+void Beam::drawParticles(Renderer * engine_ptr) const {
+	if (engine_ptr == nullptr) engine_ptr = this->engine_ptr;
 	if (engine_ptr == nullptr) ERROR(EXCEPTIONS::NULLPTR);
-	for (unique_ptr<Particle> const& particle_ptr : particles_ptr) {
+	for (Particle const* particle_ptr : particles_ptr) {
 		particle_ptr->draw(engine_ptr);
 	}
 }
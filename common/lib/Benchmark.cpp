@@ -0,0 +1,179 @@
+#include "include/bundle/Benchmark.bundle.h"
+
+using namespace std;
+
+namespace {
+	// Writes a count per particle-step, or "n/a" if the event could not be counted
+	void writePerStep(ostream & stream, bool available, double count, uint64_t particleSteps) {
+		stream << setw(STYLES::PADDING_MD);
+		if (available and particleSteps > 0) { stream << count / particleSteps; }
+		else { stream << "n/a"; }
+	}
+
+	// Writes one row of the table: time and hardware events per particle-step
+	void writeRow(ostream & stream, string const& name, double seconds, PerfSample const& hardware,
+	              array<bool, size_t(PerfEvent::COUNT)> const& available, uint64_t particleSteps) {
+		stream << setw(STYLES::PADDING_LG) << name;
+		writePerStep(stream, true, seconds * 1e9, particleSteps);
+
+		for (size_t event(0); event < hardware.size(); ++event) {
+			writePerStep(stream, available[event], hardware[event], particleSteps);
+		}
+
+		// Instructions per cycle
+		size_t cycles(size_t(PerfEvent::CYCLES));
+		size_t instructions(size_t(PerfEvent::INSTRUCTIONS));
+		stream << setw(STYLES::PADDING_MD);
+		if (available[cycles] and available[instructions] and hardware[cycles] > 0) {
+			stream << double(hardware[instructions]) / hardware[cycles];
+		} else {
+			stream << "n/a";
+		}
+		stream << endl;
+	}
+
+	// Returns the value of `"key": value` in `text` (without the quotes for a string)
+	string field(string const& text, string const& key) {
+		size_t pos(text.find('"' + key + '"'));
+		if (pos == string::npos) { ERROR(EXCEPTIONS::BAD_BASELINE); }
+		pos = text.find(':', pos);
+		if (pos == string::npos) { ERROR(EXCEPTIONS::BAD_BASELINE); }
+		pos = text.find_first_not_of(" \t\r\n", pos + 1);
+		if (pos == string::npos) { ERROR(EXCEPTIONS::BAD_BASELINE); }
+
+		if (text[pos] == '"') {
+			size_t end(text.find('"', pos + 1));
+			if (end == string::npos) { ERROR(EXCEPTIONS::BAD_BASELINE); }
+			return text.substr(pos + 1, end - pos - 1);
+		}
+
+		size_t end(text.find_first_of(",}] \t\r\n", pos));
+		return text.substr(pos, end - pos);
+	}
+
+	// Returns the number of `"key": value` in `text`
+	double numberField(string const& text, string const& key) {
+		string value(field(text, key));
+		size_t length(0);
+		double number(0);
+		try {
+			number = stod(value, &length);
+		} catch (exception const&) {
+			ERROR(EXCEPTIONS::BAD_BASELINE);
+		}
+		if (length != value.size()) { ERROR(EXCEPTIONS::BAD_BASELINE); }
+		return number;
+	}
+}
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+BenchmarkResult Benchmark::run(string const& name, Accelerator & acc, size_t steps, size_t warmupSteps, double dt) {
+	for (size_t i(0); i < warmupSteps; ++i) { acc.step(dt); }
+
+	BenchmarkResult result;
+	result.name = name;
+	result.particleSteps = 0;
+
+	// Details of the phases, when the simulation is instrumented
+	Profiler & profiler(Profiler::local());
+	profiler.reset();
+	if (Profiler::ENABLED) { profiler.enableHardwareCounters(); }
+
+	// The counters of the Profiler if it reads them, so that the kernel does not have to multiplex two groups
+	unique_ptr<PerfCounters> ownCounters;
+	if (not profiler.hasHardwareCounters()) { ownCounters.reset(new PerfCounters()); }
+	PerfCounters const& counters(ownCounters != nullptr ? *ownCounters : *profiler.getPerfCounters());
+
+	for (size_t event(0); event < result.available.size(); ++event) {
+		result.available[event] = counters.isAvailable(PerfEvent(event));
+	}
+
+	PerfSample start(counters.read());
+	int64_t startTime(Profiler::now());
+
+	for (size_t i(0); i < steps; ++i) {
+		result.particleSteps += acc.getParticleCount();
+		acc.step(dt);
+	}
+
+	result.seconds = (Profiler::now() - startTime) * 1e-9;
+	result.hardware = PerfCounters::difference(start, counters.read());
+
+	return result;
+}
+
+void Benchmark::reportHeader(ostream & stream) {
+	stream << left << setprecision(4);
+	stream << setw(STYLES::PADDING_LG) << "Per particle-step" << setw(STYLES::PADDING_MD) << "ns";
+	for (size_t event(0); event < size_t(PerfEvent::COUNT); ++event) {
+		stream << setw(STYLES::PADDING_MD) << PerfCounters::getName(PerfEvent(event));
+	}
+	stream << setw(STYLES::PADDING_MD) << "IPC" << endl;
+}
+
+void Benchmark::report(ostream & stream, BenchmarkResult const& result) {
+	stream << left << setprecision(4);
+	writeRow(stream, result.name, result.seconds, result.hardware, result.available, result.particleSteps);
+
+	if (not Profiler::ENABLED) { return; }
+
+	// Phases of the last Benchmark::run() of the thread
+	Profiler const& profiler(Profiler::local());
+	array<bool, size_t(PerfEvent::COUNT)> available;
+	for (size_t event(0); event < available.size(); ++event) {
+		available[event] = profiler.hasHardwareCounters() and profiler.getPerfCounters()->isAvailable(PerfEvent(event));
+	}
+
+	for (size_t phase(0); phase < size_t(ProfilerPhase::COUNT); ++phase) {
+		PerfSample hardware;
+		for (size_t event(0); event < hardware.size(); ++event) {
+			hardware[event] = profiler.getHardwareCount(ProfilerPhase(phase), PerfEvent(event));
+		}
+		writeRow(stream, string("  ") + Profiler::getName(ProfilerPhase(phase)), profiler.getTotalTime(ProfilerPhase(phase)), hardware, available, result.particleSteps);
+	}
+}
+
+vector<BenchmarkBaseline> Benchmark::readBaseline(istream & stream, double & tolerance) {
+	stringstream buffer;
+	buffer << stream.rdbuf();
+	string text(buffer.str());
+
+	// The scenarios are the objects of the array, the tolerance is before them
+	size_t scenarios(text.find("\"scenarios\""));
+	if (scenarios == string::npos) { ERROR(EXCEPTIONS::BAD_BASELINE); }
+	tolerance = numberField(text.substr(0, scenarios), "tolerance");
+
+	vector<BenchmarkBaseline> baselines;
+	for (size_t begin(text.find('{', scenarios)); begin != string::npos; begin = text.find('{', begin + 1)) {
+		size_t end(text.find('}', begin));
+		if (end == string::npos) { ERROR(EXCEPTIONS::BAD_BASELINE); }
+		string object(text.substr(begin, end - begin + 1));
+
+		baselines.push_back(BenchmarkBaseline({
+			field(object, "name"),
+			numberField(object, "particleStepsPerSecond"),
+			numberField(object, "allocationsPerStep")
+		}));
+	}
+
+	return baselines;
+}
+
+void Benchmark::writeBaseline(ostream & stream, vector<BenchmarkBaseline> const& baselines, double tolerance) {
+	stream << setprecision(6);
+	stream << "{" << endl;
+	stream << "\t\"tolerance\": " << tolerance << "," << endl;
+	stream << "\t\"scenarios\": [" << endl;
+	for (size_t i(0); i < baselines.size(); ++i) {
+		stream
+			<< "\t\t{ \"name\": \"" << baselines[i].name << "\""
+			<< ", \"particleStepsPerSecond\": " << baselines[i].particleStepsPerSecond
+			<< ", \"allocationsPerStep\": " << baselines[i].allocationsPerStep << " }"
+			<< (i + 1 < baselines.size() ? "," : "") << endl;
+	}
+	stream << "\t]" << endl;
+	stream << "}" << endl;
+}
@@ -21,6 +21,8 @@ Dipole::Dipole(Vector3D const& posIn, Vector3D const& posOut, double radius, dou
 
 shared_ptr<Element> Dipole::copy() const { return cloneThis(); }
 
+Element * Dipole::copy(Arena & arena) const { return arena.create<Dipole>(*this); }
+
 shared_ptr<Dipole> Dipole::cloneThis() const {
 	return shared_ptr<Dipole>(new Dipole(*this));
 }
@@ -36,6 +38,11 @@ Vector3D Dipole::getField(Vector3D const& pos, bool methodChapi) const {
 	return Vector3D(0, 0, B);
 }
 
+void Dipole::getFields(vector<Vector3D> const& positions, vector<Vector3D> & fields, bool methodChapi) const {
+	(void) methodChapi;
+	fields.assign(positions.size(), Vector3D(0, 0, B));
+}
+
 Vector3D const Dipole::getNormalDirection(Vector3D const& pos) const {
 	Vector3D X(pos - posCenter);
 	Vector3D u(X - pos.getZ() * Vector3D(0, 0, 1));
@@ -106,6 +113,8 @@ double Dipole::getInAngle() const { return inAngle; }
 
 double Dipole::getOutAngle() const { return outAngle; }
 
+double Dipole::getB() const { return B; }
+
 /****************************************************************
  * Setters
  ****************************************************************/
@@ -116,9 +125,9 @@ void Dipole::setB(double _B) { B = _B; }
  * Virtual methods
  ****************************************************************/
 
-bool Dipole::isInWall(Particle const& p) const {
-	Vector3D X(p.getPos() - posCenter);
-	Vector3D u(X - p.getPos().getZ() * Vector3D(0, 0, 1));
+bool Dipole::isInWall(Vector3D const& pos) const {
+	Vector3D X(pos - posCenter);
+	Vector3D u(X - pos.getZ() * Vector3D(0, 0, 1));
 	~u;
 	return ((X - 1 / abs(curvature) * u).norm() > getRadius());
 }
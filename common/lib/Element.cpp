@@ -7,7 +7,7 @@ using namespace std;
  ****************************************************************/
 
 Element::Element(Vector3D const& posIn, Vector3D const& posOut, double radius, Renderer * engine_ptr)
-: Drawable(engine_ptr), posIn(posIn), posOut(posOut), radius(radius), next_ptr(nullptr), prev_ptr(nullptr)
+: Drawable(engine_ptr), posIn(posIn), posOut(posOut), radius(radius), linked(false), next(NO_LINK), prev(NO_LINK), index(0), startLength(0)
 {
 	double orientation(Vector3D::tripleProduct(Vector3D(0, 0, 1), posIn, posOut));
 	if (abs(orientation) < GLOBALS::DELTA_DIV0) {
@@ -20,22 +20,6 @@ Element::Element(Vector3D const& posIn, Vector3D const& posOut, double radius, R
 	}
 }
 
-/****************************************************************
- * Destructor
- ****************************************************************/
-
-Element::~Element() {
-	if (next_ptr != nullptr) {
-		next_ptr->prev_ptr = nullptr;
-		next_ptr = nullptr;
-	}
-
-	if (prev_ptr != nullptr) {
-		prev_ptr->next_ptr = nullptr;
-		prev_ptr = nullptr;
-	}
-}
-
 /****************************************************************
  * Getters
  ****************************************************************/
@@ -43,33 +27,70 @@ Element::~Element() {
 Vector3D Element::getPosIn() const { return posIn; }
 Vector3D Element::getPosOut() const { return posOut; }
 double Element::getRadius() const { return radius; }
+size_t Element::getIndex() const { return index; }
+double Element::getStartLength() const { return startLength; }
+uint32_t Element::getNext() const { return next; }
+uint32_t Element::getPrev() const { return prev; }
+bool Element::isLinked() const { return linked; }
+
+/****************************************************************
+ * Getters (virtual)
+ ****************************************************************/
+
+void Element::getFields(vector<Vector3D> const& positions, vector<Vector3D> & fields, bool methodChapi) const {
+	fields.resize(positions.size());
+	for (size_t i(0); i < positions.size(); ++i) { fields[i] = getField(positions[i], methodChapi); }
+}
 
 /****************************************************************
  * Methods
  ****************************************************************/
 
 void Element::linkNext(Element & _next) {
-	next_ptr = &_next;
-	_next.prev_ptr = this;
+	if (not linked or not _next.linked) { ERROR(EXCEPTIONS::NOT_SAME_LATTICE); }
+	next = uint32_t(_next.index);
+	_next.prev = uint32_t(index);
 }
 
-void Element::updatePointedElement(Particle & p, bool methodChapi) const {
+void Element::linkAccelerator(size_t index, double startLength) {
+	linked = true;
+	this->index = index;
+	this->startLength = startLength;
+	next = NO_LINK;
+	prev = NO_LINK;
+}
+
+void Element::appendPrimitives(vector<Element *> & primitives) { primitives.push_back(this); }
+
+void Element::updatePointedElement(Particle & p, vector<Element *> const& lattice, bool methodChapi) const {
 	double dist(getParticleProgress(p.getPos(), methodChapi));
+	Element const* element_ptr(this);
 	if (dist < 0) {
-		if (prev_ptr != nullptr) {
-			p.setElement(prev_ptr);
+		if (prev != NO_LINK) {
+			element_ptr = lattice[prev];
+			p.setElementIndex(prev);
+			PROFILE_COUNT(ProfilerCounter::ELEMENT_TRANSITIONS, 1);
 		} else {
 			ERROR(EXCEPTIONS::OUTSIDE_ACCELERATOR);
 		}
 	} else if (dist > 1) {
-		if (next_ptr != nullptr) {
-			p.setElement(next_ptr);
+		if (next != NO_LINK) {
+			element_ptr = lattice[next];
+			p.setElementIndex(next);
+			PROFILE_COUNT(ProfilerCounter::ELEMENT_TRANSITIONS, 1);
 		} else {
 			ERROR(EXCEPTIONS::OUTSIDE_ACCELERATOR);
 		}
 	}
+
+	// The progress is reused by Accelerator::updateProgresses(). It is only computed again when the Particle changes Element,
+	// or with the method of Chap, which only tells on which side of the Element the Particle is
+	if (methodChapi or element_ptr != this) { dist = element_ptr->getParticleProgress(p.getPos()); }
+	p.setElementProgress(min(max(dist, 0.0), 1.0));
 }
 
+bool Element::isInWall(Particle const& p) const { return isInWall(p.getPos()); }
+
 string const Element::to_string() const {
 	stringstream stream;
 	stream << setprecision(STYLES::PRECISION);
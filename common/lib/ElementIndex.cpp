@@ -0,0 +1,143 @@
+#include "include/bundle/ElementIndex.bundle.h"
+
+using namespace std;
+
+namespace {
+	// Bins per Element: a bin rarely holds more than one or two Elements
+	size_t const BINS_PER_ELEMENT(4);
+
+	// Points sampled along each Element to find the angles it spans
+	size_t const SAMPLES_PER_ELEMENT(16);
+
+	// Angle of a position around the origin, in [0, 2 pi)
+	double angleOf(Vector3D const& pos) {
+		double angle(atan2(pos.getY(), pos.getX()));
+		if (angle < 0) { angle += 2 * M_PI; }
+		return angle;
+	}
+}
+
+constexpr size_t ElementIndex::NOT_FOUND;
+
+/****************************************************************
+ * Constructors
+ ****************************************************************/
+
+ElementIndex::ElementIndex()
+: methodChapi(true)
+{}
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+void ElementIndex::build(vector<shared_ptr<Element>> const& elements, bool methodChapi) {
+	vector<Element *> pointers;
+	for (shared_ptr<Element> const& element_ptr : elements) { pointers.push_back(element_ptr.get()); }
+	build(pointers, methodChapi);
+}
+
+void ElementIndex::build(vector<Element *> const& elements, bool methodChapi) {
+	clear();
+	this->methodChapi = methodChapi;
+	if (elements.empty()) { return; }
+
+	this->elements.assign(elements.begin(), elements.end());
+
+	size_t binCount(BINS_PER_ELEMENT * elements.size());
+	double binWidth(2 * M_PI / binCount);
+	vector<vector<size_t>> bins(binCount);
+
+	for (size_t i(0); i < elements.size(); ++i) {
+		Element const& element(*elements[i]);
+
+		// Unwrapped angles spanned by the Element
+		double previous(angleOf(element.getPosAtProgress(0)));
+		double low(previous);
+		double high(previous);
+		double unwrapped(previous);
+		bool aroundOrigin(false);
+
+		for (size_t sample(0); sample <= SAMPLES_PER_ELEMENT; ++sample) {
+			Vector3D pos(element.getPosAtProgress(sample / double(SAMPLES_PER_ELEMENT)));
+			// So close to the origin that the angle is meaningless
+			if (pos.norm() <= element.getRadius()) { aroundOrigin = true; }
+
+			double angle(angleOf(pos));
+			double step(angle - previous);
+			if (step > M_PI) { step -= 2 * M_PI; }
+			if (step < - M_PI) { step += 2 * M_PI; }
+			unwrapped += step;
+			previous = angle;
+
+			low = min(low, unwrapped);
+			high = max(high, unwrapped);
+		}
+
+		// One more bin on each side for the width of the Element
+		long first(long(floor(low / binWidth)) - 1);
+		long last(long(floor(high / binWidth)) + 1);
+		if (aroundOrigin or last - first + 1 >= long(binCount)) {
+			first = 0;
+			last = binCount - 1;
+		}
+
+		for (long bin(first); bin <= last; ++bin) {
+			bins[((bin % long(binCount)) + binCount) % binCount].push_back(i);
+		}
+	}
+
+	// Flattened, so that a query reads a single contiguous range
+	binStarts.push_back(0);
+	for (vector<size_t> const& bin : bins) {
+		binElements.insert(binElements.end(), bin.begin(), bin.end());
+		binStarts.push_back(binElements.size());
+	}
+}
+
+void ElementIndex::clear() {
+	elements.clear();
+	binStarts.clear();
+	binElements.clear();
+}
+
+size_t ElementIndex::getBinCount() const {
+	return binStarts.empty() ? 0 : binStarts.size() - 1;
+}
+
+size_t ElementIndex::getBin(Vector3D const& pos) const {
+	size_t binCount(getBinCount());
+	return min(size_t(angleOf(pos) / (2 * M_PI) * binCount), binCount - 1);
+}
+
+bool ElementIndex::contains(size_t index, Vector3D const& pos) const {
+	double const progress(elements[index]->getParticleProgress(pos, methodChapi));
+	return (progress >= 0 and progress <= 1) and (not elements[index]->isInWall(pos));
+}
+
+size_t ElementIndex::find(Vector3D const& pos) const {
+	if (elements.empty()) { return NOT_FOUND; }
+
+	size_t bin(getBin(pos));
+	for (size_t i(binStarts[bin]); i < binStarts[bin + 1]; ++i) {
+		if (contains(binElements[i], pos)) { return binElements[i]; }
+	}
+
+	// Not around the origin: same search as without the index
+	for (size_t i(0); i < elements.size(); ++i) {
+		if (contains(i, pos)) { return i; }
+	}
+
+	return NOT_FOUND;
+}
+
+void ElementIndex::find(vector<Vector3D> const& points, vector<size_t> & indexes, ThreadPool * threadPool_ptr) const {
+	indexes.resize(points.size());
+
+	auto body([this, &points, &indexes](size_t begin, size_t end) {
+		for (size_t i(begin); i < end; ++i) { indexes[i] = find(points[i]); }
+	});
+
+	if (threadPool_ptr != nullptr) { threadPool_ptr->parallelFor(0, points.size(), body); }
+	else { body(0, points.size()); }
+}
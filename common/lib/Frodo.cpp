@@ -38,6 +38,8 @@ Frodo::Frodo(Vector3D const& posIn, double totalLength, Vector3D direction, doub
 
 shared_ptr<Element> Frodo::copy() const { return cloneThis(); }
 
+Element * Frodo::copy(Arena & arena) const { return arena.create<Frodo>(*this); }
+
 shared_ptr<Frodo> Frodo::cloneThis() const {
 	return shared_ptr<Frodo>(new Frodo(*this));
 }
@@ -72,6 +74,14 @@ Vector3D Frodo::getField(Vector3D const& pos, bool methodChapi) const {
 	return Vector3D();
 }
 
+/****************************************************************
+ * Getters
+ ****************************************************************/
+
+double Frodo::getB() const { return b; }
+
+double Frodo::getStraightLength() const { return straightLength; }
+
 /****************************************************************
  * Virtual methods
  ****************************************************************/
@@ -134,6 +144,13 @@ string const Frodo::to_string() const {
 	return stream.str();
 }
 
+void Frodo::appendPrimitives(vector<Element *> & primitives) {
+	primitives.push_back(&focalizer);
+	primitives.push_back(&firstStraight);
+	primitives.push_back(&defocalizer);
+	primitives.push_back(&lastStraight);
+}
+
 /****************************************************************
  * Drawing
  ****************************************************************/
@@ -151,7 +168,8 @@ void Frodo::draw(Renderer * engine_ptr) const {
 	engine_ptr->draw(*this);
 }
 
-void Frodo::drawElements() const {
+void Frodo::drawElements(Renderer * engine_ptr) const {
+	if (engine_ptr == nullptr) engine_ptr = this->engine_ptr;
 	if (engine_ptr == nullptr) ERROR(EXCEPTIONS::NULLPTR);
 	focalizer.draw(engine_ptr);
 	defocalizer.draw(engine_ptr);
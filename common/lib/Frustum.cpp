@@ -0,0 +1,40 @@
+#include "include/bundle/Frustum.bundle.h"
+
+using namespace std;
+
+/****************************************************************
+ * Constructors
+ ****************************************************************/
+
+Frustum::Frustum() {
+	for (array<double, 4> & plane : planes) { plane = { 0, 0, 0, 1 }; }
+}
+
+Frustum::Frustum(QMatrix4x4 const& worldToClip) {
+	// Gribb & Hartmann: each plane is the last row of the matrix plus or minus one of the others
+	for (size_t i(0); i < planes.size(); ++i) {
+		int row(int(i / 2));
+		double sign(i % 2 == 0 ? 1 : -1);
+
+		for (int column(0); column < 4; ++column) {
+			planes[i][column] = worldToClip(3, column) + sign * worldToClip(row, column);
+		}
+
+		double norm(sqrt(planes[i][0] * planes[i][0] + planes[i][1] * planes[i][1] + planes[i][2] * planes[i][2]));
+		if (norm > 0) {
+			for (double & coefficient : planes[i]) { coefficient /= norm; }
+		}
+	}
+}
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+bool Frustum::containsSphere(QVector3D const& center, double radius) const {
+	for (array<double, 4> const& plane : planes) {
+		double distance(plane[0] * center.x() + plane[1] * center.y() + plane[2] * center.z() + plane[3]);
+		if (distance < - radius) { return false; }
+	}
+	return true;
+}
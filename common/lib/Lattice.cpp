@@ -0,0 +1,244 @@
+#include "include/bundle/Lattice.bundle.h"
+
+using namespace std;
+
+namespace {
+	// Header of the binary cache, the version changing with the layout of the slots
+	uint64_t const CACHE_MAGIC(0x45484341434c4150); // "PALCACHE"
+	uint32_t const CACHE_VERSION(1);
+
+	// Reads `count` coordinates, returns false if they are not all numbers
+	bool readNumbers(istream & stream, double * values, size_t count) {
+		for (size_t i(0); i < count; ++i) {
+			if (not (stream >> values[i])) { return false; }
+		}
+		return true;
+	}
+
+	template <typename T>
+	void writeRaw(ostream & stream, T const& value) {
+		stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	bool readRaw(istream & stream, T & value) {
+		return bool(stream.read(reinterpret_cast<char *>(&value), sizeof(T)));
+	}
+
+	// Reads `count` slots, without trusting `count` more than the bytes left in the stream
+	template <typename T>
+	bool readSlots(istream & stream, vector<T> & slots) {
+		uint64_t count(0);
+		if (not readRaw(stream, count)) { return false; }
+
+		streampos position(stream.tellg());
+		stream.seekg(0, ios::end);
+		streampos end(stream.tellg());
+		stream.seekg(position);
+		if (position < 0 or end < position or count > uint64_t(end - position) / sizeof(T)) { return false; }
+
+		slots.resize(count);
+		return count == 0 or bool(stream.read(reinterpret_cast<char *>(slots.data()), count * sizeof(T)));
+	}
+}
+
+/****************************************************************
+ * Constructors
+ ****************************************************************/
+
+Lattice::Lattice()
+: closed(false), fromCache(false)
+{}
+
+Lattice Lattice::parse(istream & stream) {
+	Lattice lattice;
+
+	for (string line; getline(stream, line);) {
+		// Comments
+		line = line.substr(0, line.find('#'));
+
+		istringstream entry(line);
+		string keyword;
+		if (not (entry >> keyword)) { continue; }
+
+		if (keyword == "close") {
+			lattice.closed = true;
+		} else if (keyword == "beam") {
+			BeamSlot slot = {};
+			string kind;
+			entry >> kind;
+			if (kind == "proton") { slot.kind = ParticleKind::PROTON; }
+			else if (kind == "antiproton") { slot.kind = ParticleKind::ANTIPROTON; }
+			else if (kind == "electron") { slot.kind = ParticleKind::ELECTRON; }
+			else { ERROR(EXCEPTIONS::BAD_LATTICE); }
+
+			if (not readNumbers(entry, slot.pos, 3) or not (entry >> slot.energy) or not readNumbers(entry, slot.speed, 3)
+			    or not (entry >> slot.particleCount) or not (entry >> slot.lambda)) {
+				ERROR(EXCEPTIONS::BAD_LATTICE);
+			}
+			lattice.beams.push_back(slot);
+		} else {
+			ElementSlot slot = {};
+			if (keyword == "straight") { slot.kind = ElementKind::STRAIGHT; }
+			else if (keyword == "quadrupole") { slot.kind = ElementKind::QUADRUPOLE; }
+			else if (keyword == "frodo") { slot.kind = ElementKind::FRODO; }
+			else if (keyword == "dipole") { slot.kind = ElementKind::DIPOLE; }
+			else { ERROR(EXCEPTIONS::BAD_LATTICE); }
+
+			// No element after the end of the loop
+			if (lattice.closed) { ERROR(EXCEPTIONS::BAD_LATTICE); }
+
+			bool valid(readNumbers(entry, slot.posIn, 3) and readNumbers(entry, slot.posOut, 3) and (entry >> slot.radius));
+			switch (slot.kind) {
+				case ElementKind::STRAIGHT: break;
+				case ElementKind::QUADRUPOLE: valid = valid and (entry >> slot.b); break;
+				case ElementKind::FRODO: valid = valid and (entry >> slot.b) and (entry >> slot.straightLength); break;
+				case ElementKind::DIPOLE: valid = valid and (entry >> slot.curvature) and (entry >> slot.B); break;
+			}
+			if (not valid) { ERROR(EXCEPTIONS::BAD_LATTICE); }
+			lattice.elements.push_back(slot);
+		}
+
+		// Nothing may follow the parameters
+		string rest;
+		if (entry >> rest) { ERROR(EXCEPTIONS::BAD_LATTICE); }
+	}
+
+	// The geometry is checked once here, the cache then only holds valid lattices
+	Accelerator acc;
+	vector<unique_ptr<Element>> elements;
+	for (ElementSlot const& slot : lattice.elements) { elements.push_back(makeElement(slot, nullptr)); }
+	acc.addElements(elements);
+	if (lattice.closed) { acc.closeElementLoop(); }
+
+	return lattice;
+}
+
+Lattice Lattice::load(string const& fileName) {
+	ifstream file(fileName, ios::binary);
+	if (file.fail()) { ERROR(EXCEPTIONS::FILE_EXCEPTION); }
+	stringstream buffer;
+	buffer << file.rdbuf();
+	string text(buffer.str());
+	uint64_t textHash(hash(text));
+
+	Lattice lattice;
+	ifstream cache(getCacheName(fileName), ios::binary);
+	if (cache.good() and readCache(cache, textHash, lattice)) {
+		lattice.fromCache = true;
+		return lattice;
+	}
+
+	stringstream textStream(text);
+	lattice = parse(textStream);
+
+	// Written aside then renamed, so that a reader never sees half a cache.
+	// If the directory is read-only, the text is simply parsed again at the next load
+	string cacheName(getCacheName(fileName));
+	string temporaryName(cacheName + ".tmp");
+	{
+		ofstream output(temporaryName, ios::binary | ios::trunc);
+		if (output.good()) { lattice.writeCache(output, textHash); }
+		if (output.fail()) { remove(temporaryName.c_str()); return lattice; }
+	}
+	if (rename(temporaryName.c_str(), cacheName.c_str()) != 0) { remove(temporaryName.c_str()); }
+
+	return lattice;
+}
+
+/****************************************************************
+ * Getters
+ ****************************************************************/
+
+size_t Lattice::getElementCount() const { return elements.size(); }
+
+size_t Lattice::getBeamCount() const { return beams.size(); }
+
+bool Lattice::isClosed() const { return closed; }
+
+bool Lattice::isFromCache() const { return fromCache; }
+
+string Lattice::getCacheName(string const& fileName) { return fileName + ".cache"; }
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+void Lattice::build(Accelerator & acc, Renderer * engine_ptr) const {
+	vector<unique_ptr<Element>> built;
+	built.reserve(elements.size());
+	for (ElementSlot const& slot : elements) { built.push_back(makeElement(slot, engine_ptr)); }
+	acc.addElements(built);
+	if (closed) { acc.closeElementLoop(); }
+
+	for (BeamSlot const& slot : beams) {
+		acc.addBeam(*makeParticle(slot), slot.particleCount, slot.lambda);
+	}
+}
+
+void Lattice::writeCache(ostream & stream, uint64_t hash) const {
+	writeRaw(stream, CACHE_MAGIC);
+	writeRaw(stream, CACHE_VERSION);
+	writeRaw(stream, hash);
+	writeRaw(stream, uint8_t(closed));
+
+	writeRaw(stream, uint64_t(elements.size()));
+	stream.write(reinterpret_cast<char const*>(elements.data()), elements.size() * sizeof(ElementSlot));
+	writeRaw(stream, uint64_t(beams.size()));
+	stream.write(reinterpret_cast<char const*>(beams.data()), beams.size() * sizeof(BeamSlot));
+}
+
+bool Lattice::readCache(istream & stream, uint64_t hash, Lattice & lattice) {
+	uint64_t magic(0), cachedHash(0);
+	uint32_t version(0);
+	uint8_t closed(0);
+	if (not readRaw(stream, magic) or magic != CACHE_MAGIC) { return false; }
+	if (not readRaw(stream, version) or version != CACHE_VERSION) { return false; }
+	if (not readRaw(stream, cachedHash) or cachedHash != hash) { return false; }
+	if (not readRaw(stream, closed)) { return false; }
+
+	Lattice cached;
+	cached.closed = (closed != 0);
+	if (not readSlots(stream, cached.elements) or not readSlots(stream, cached.beams)) { return false; }
+
+	lattice = cached;
+	return true;
+}
+
+uint64_t Lattice::hash(string const& text) {
+	uint64_t value(14695981039346656037ULL);
+	for (unsigned char c : text) {
+		value ^= c;
+		value *= 1099511628211ULL;
+	}
+	return value;
+}
+
+/****************************************************************
+ * Private methods
+ ****************************************************************/
+
+unique_ptr<Element> Lattice::makeElement(ElementSlot const& slot, Renderer * engine_ptr) {
+	Vector3D posIn(slot.posIn[0], slot.posIn[1], slot.posIn[2]);
+	Vector3D posOut(slot.posOut[0], slot.posOut[1], slot.posOut[2]);
+
+	switch (slot.kind) {
+		case ElementKind::STRAIGHT: return unique_ptr<Element>(new Straight(posIn, posOut, slot.radius, engine_ptr));
+		case ElementKind::QUADRUPOLE: return unique_ptr<Element>(new Quadrupole(posIn, posOut, slot.radius, slot.b, engine_ptr));
+		case ElementKind::FRODO: return unique_ptr<Element>(new Frodo(posIn, posOut, slot.radius, slot.b, slot.straightLength, engine_ptr));
+		case ElementKind::DIPOLE: return unique_ptr<Element>(new Dipole(posIn, posOut, slot.radius, slot.curvature, slot.B, engine_ptr));
+	}
+	ERROR(EXCEPTIONS::BAD_LATTICE);
+}
+
+unique_ptr<Particle> Lattice::makeParticle(BeamSlot const& slot) {
+	Vector3D pos(slot.pos[0], slot.pos[1], slot.pos[2]);
+	Vector3D speed(slot.speed[0], slot.speed[1], slot.speed[2]);
+
+	switch (slot.kind) {
+		case ParticleKind::PROTON: return unique_ptr<Particle>(new Proton(pos, slot.energy, speed));
+		case ParticleKind::ANTIPROTON: return unique_ptr<Particle>(new AntiProton(pos, slot.energy, speed));
+		case ParticleKind::ELECTRON: return unique_ptr<Particle>(new Electron(pos, slot.energy, speed));
+		default: ERROR(EXCEPTIONS::BAD_LATTICE);
+	}
+}
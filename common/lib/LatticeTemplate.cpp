@@ -0,0 +1,94 @@
+#include "include/bundle/LatticeTemplate.bundle.h"
+
+using namespace std;
+
+/****************************************************************
+ * Constructors
+ ****************************************************************/
+
+LatticeTemplate::LatticeTemplate(bool methodChapi, bool beamFromParticle)
+: methodChapi(methodChapi), beamFromParticle(beamFromParticle), compiled(false)
+{}
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+void LatticeTemplate::addStraight(Vector3D const& posIn, Vector3D const& posOut, double radius) {
+	elements.push_back(ElementSlot{ ElementKind::STRAIGHT, posIn, posOut, radius, 0 });
+	compiled = false;
+}
+
+void LatticeTemplate::addFrodo(Vector3D const& posIn, Vector3D const& posOut, double radius) {
+	elements.push_back(ElementSlot{ ElementKind::FRODO, posIn, posOut, radius, 0 });
+	compiled = false;
+}
+
+void LatticeTemplate::addDipole(Vector3D const& posIn, Vector3D const& posOut, double radius, double curvature) {
+	elements.push_back(ElementSlot{ ElementKind::DIPOLE, posIn, posOut, radius, curvature });
+	compiled = false;
+}
+
+void LatticeTemplate::addBeam(Particle const& defaultParticle, size_t particleCount, double lambda) {
+	beams.push_back(BeamSlot{ shared_ptr<Particle>(defaultParticle.copy()), particleCount, lambda });
+	compiled = false;
+}
+
+void LatticeTemplate::compile() {
+	if (elements.empty() or beams.empty()) { ERROR(EXCEPTIONS::EMPTY_TEMPLATE); }
+
+	// The tuning parameters do not change the geometry, so we only check it once
+	// with field-free elements (Frodo sections are validated when instantiated)
+	Accelerator acc(nullptr, methodChapi, beamFromParticle);
+	for (ElementSlot const& slot : elements) {
+		if (slot.kind == ElementKind::DIPOLE) {
+			acc.addElement(Dipole(slot.posIn, slot.posOut, slot.radius, slot.curvature, 0));
+		} else {
+			acc.addElement(Straight(slot.posIn, slot.posOut, slot.radius));
+		}
+	}
+	acc.closeElementLoop();
+
+	compiled = true;
+}
+
+bool LatticeTemplate::isCompiled() const { return compiled; }
+
+void LatticeTemplate::instantiate(Accelerator & acc, SweepPoint const& point) const {
+	if (not compiled) { ERROR(EXCEPTIONS::TEMPLATE_NOT_COMPILED); }
+
+	for (ElementSlot const& slot : elements) {
+		switch (slot.kind) {
+			case ElementKind::STRAIGHT:
+				acc.addElement(Straight(slot.posIn, slot.posOut, slot.radius));
+				break;
+			case ElementKind::FRODO:
+				acc.addElement(Frodo(slot.posIn, slot.posOut, slot.radius, point.b, point.straightLength));
+				break;
+			case ElementKind::DIPOLE:
+				acc.addElement(Dipole(slot.posIn, slot.posOut, slot.radius, slot.curvature, point.B));
+				break;
+		}
+	}
+	acc.closeElementLoop();
+
+	for (BeamSlot const& slot : beams) {
+		Particle const& particle(*slot.defaultParticle_ptr);
+		// Same particle with the energy of the point
+		unique_ptr<Particle> tuned(particle.scaledCopy(
+			particle.getPos(),
+			point.energy,
+			particle.getSpeed(),
+			CONVERT::MassSItoGeV(particle.getMass()),
+			particle.getChargeNumber(),
+			1
+		));
+		acc.addBeam(*tuned, slot.particleCount, slot.lambda);
+	}
+}
+
+unique_ptr<Accelerator> LatticeTemplate::instantiate(SweepPoint const& point) const {
+	unique_ptr<Accelerator> acc(new Accelerator(nullptr, methodChapi, beamFromParticle));
+	instantiate(*acc, point);
+	return acc;
+}
@@ -0,0 +1,109 @@
+#include "include/bundle/LossMap.bundle.h"
+
+using namespace std;
+
+/****************************************************************
+ * Constructors
+ ****************************************************************/
+
+LossMap::LossMap(size_t radialBins, size_t azimuthalBins)
+: radialBins(radialBins), azimuthalBins(azimuthalBins), time(0)
+{
+	if (radialBins == 0 or azimuthalBins == 0) { ERROR(EXCEPTIONS::BAD_LOSS_MAP); }
+}
+
+/****************************************************************
+ * Getters
+ ****************************************************************/
+
+size_t LossMap::getElementCount() const { return losses.size(); }
+
+size_t LossMap::getRadialBinCount() const { return radialBins; }
+
+size_t LossMap::getAzimuthalBinCount() const { return azimuthalBins; }
+
+double LossMap::getTime() const { return time; }
+
+uint64_t LossMap::getLosses(size_t element) const {
+	if (element >= losses.size()) { ERROR(EXCEPTIONS::NO_ELEMENT); }
+	return losses[element];
+}
+
+uint64_t LossMap::getTotalLosses() const {
+	uint64_t total(0);
+	for (uint64_t count : losses) { total += count; }
+	return total;
+}
+
+uint64_t LossMap::getMaxLosses() const {
+	if (losses.empty()) { return 0; }
+	return *max_element(losses.begin(), losses.end());
+}
+
+double LossMap::getLossRate(size_t element) const {
+	uint64_t count(getLosses(element));
+	if (time < GLOBALS::DELTA_DIV0) { return 0; }
+	return count / time;
+}
+
+vector<uint64_t> LossMap::getRadialHistogram(size_t element) const {
+	if (element >= losses.size()) { ERROR(EXCEPTIONS::NO_ELEMENT); }
+	return vector<uint64_t>(radial.begin() + element * radialBins, radial.begin() + (element + 1) * radialBins);
+}
+
+vector<uint64_t> LossMap::getAzimuthalHistogram(size_t element) const {
+	if (element >= losses.size()) { ERROR(EXCEPTIONS::NO_ELEMENT); }
+	return vector<uint64_t>(azimuthal.begin() + element * azimuthalBins, azimuthal.begin() + (element + 1) * azimuthalBins);
+}
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+void LossMap::resize(size_t elementCount) {
+	losses.resize(elementCount);
+	radial.resize(elementCount * radialBins);
+	azimuthal.resize(elementCount * azimuthalBins);
+}
+
+void LossMap::record(Particle const& particle, Element const& element) {
+	size_t index(element.getIndex());
+	if (index >= losses.size()) { ERROR(EXCEPTIONS::NO_ELEMENT); }
+
+	// Transverse offset from the ideal trajectory, at the progress of the last Element::updatePointedElement()
+	Vector3D offset(particle.getPos() - element.getPosAtProgress(particle.getElementProgress()));
+	double r(offset * element.getNormalDirection(particle.getPos()));
+	double z(offset.getZ());
+
+	// The Particles just out of the aperture go in the outermost bins
+	double radius(element.getRadius());
+	double rFraction(min(max((r + radius) / (2 * radius), 0.0), 1.0));
+	size_t rBin(min(size_t(rFraction * radialBins), radialBins - 1));
+
+	double angleFraction((atan2(z, r) + M_PI) / (2 * M_PI));
+	size_t angleBin(min(size_t(angleFraction * azimuthalBins), azimuthalBins - 1));
+
+	++losses[index];
+	++radial[index * radialBins + rBin];
+	++azimuthal[index * azimuthalBins + angleBin];
+}
+
+void LossMap::advance(double dt) { time += dt; }
+
+void LossMap::reset() {
+	fill(losses.begin(), losses.end(), 0);
+	fill(radial.begin(), radial.end(), 0);
+	fill(azimuthal.begin(), azimuthal.end(), 0);
+	time = 0;
+}
+
+void LossMap::write(ostream & stream, uint64_t step) const {
+	for (size_t element(0); element < losses.size(); ++element) {
+		if (losses[element] == 0) { continue; }
+
+		stream << "losses," << step << ',' << time << ',' << element << ',' << losses[element] << ',' << getLossRate(element);
+		for (size_t bin(0); bin < radialBins; ++bin) { stream << ',' << radial[element * radialBins + bin]; }
+		for (size_t bin(0); bin < azimuthalBins; ++bin) { stream << ',' << azimuthal[element * azimuthalBins + bin]; }
+		stream << '\n';
+	}
+}
@@ -4,13 +4,22 @@
  * Constructor
  ****************************************************************/
 
-OpenGLRenderer::OpenGLRenderer() { time.start(); }
+OpenGLRenderer::OpenGLRenderer()
+: trailIndices(QOpenGLBuffer::IndexBuffer), aspectRatio(1), lossMap_ptr(nullptr), frodo_ptr(nullptr)
+{ time.start(); }
 
 OpenGLRenderer::~OpenGLRenderer() {
 	// Actually destroy our OpenGL information
 	object.destroy();
 	buffer.destroy();
+	trailObject.destroy();
+	trailBuffer.destroy();
+	trailIndices.destroy();
+	phaseSpaceTextures.clear();
+	panelObject.destroy();
+	panelBuffer.destroy();
 	delete program;
+	delete panelProgram;
 }
 
 /****************************************************************
@@ -49,42 +58,29 @@ void OpenGLRenderer::init() {
 	buffer.bind();
 	buffer.setUsagePattern(QOpenGLBuffer::StaticDraw); // We never change the data => static
 	// Take a byte out of every dish !
-	int peaBytes(sizeof(GEOMETRY::PEA[0]) * GEOMETRY::PEA.size());
-	int spaghettiBytes(sizeof(GEOMETRY::SPAGHETTI[0]) * GEOMETRY::SPAGHETTI.size());
-	int penneBytes(sizeof(GEOMETRY::PENNE[0]) * GEOMETRY::PENNE.size());
-	int macaroniBytes(sizeof(GEOMETRY::MACARONI[0]) * GEOMETRY::MACARONI.size());
-	int pancakeBytes(sizeof(GEOMETRY::PANCAKE[0]) * GEOMETRY::PANCAKE.size());
-	int cubeBytes(sizeof(GEOMETRY::CUBE[0]) * GEOMETRY::CUBE.size());
+	std::vector<std::pair<GEOMETRY::Mesh, int *>> meshes({
+		{ GEOMETRY::getPea(), &offsetPea },
+		{ GEOMETRY::getSpaghetti(), &offsetSpaghetti },
+		{ GEOMETRY::getCube(), &offsetCube }
+	});
+	for (size_t lod(0); lod < GRAPHICS::LOD_COUNT; ++lod) {
+		meshes.push_back({ GEOMETRY::getPenne(lod), &offsetPenne[lod] });
+		meshes.push_back({ GEOMETRY::getMacaroni(lod), &offsetMacaroni[lod] });
+		meshes.push_back({ GEOMETRY::getPancake(lod), &offsetPancake[lod] });
+	}
+
+	size_t totalBytes(0);
+	for (auto const& mesh : meshes) { totalBytes += mesh.first.bytes(); }
+	buffer.allocate(int(totalBytes));
+
+	// The meshes are written straight from the shared tables, one after the other
 	int offsetBytes(0), offsetSlots(0);
-	buffer.allocate(spaghettiBytes + penneBytes + macaroniBytes + pancakeBytes + cubeBytes);
-	// Point
-	buffer.write(offsetBytes, &GEOMETRY::PEA.front(), peaBytes);
-	offsetPea = offsetSlots;
-	offsetBytes += peaBytes;
-	offsetSlots += GEOMETRY::PEA.size();
-	// Spaghetti
-	buffer.write(offsetBytes, &GEOMETRY::SPAGHETTI.front(), spaghettiBytes);
-	offsetSpaghetti = offsetSlots;
-	offsetBytes += spaghettiBytes;
-	offsetSlots += GEOMETRY::SPAGHETTI.size();
-	// Penne
-	buffer.write(offsetBytes, &GEOMETRY::PENNE.front(), penneBytes);
-	offsetPenne = offsetSlots;
-	offsetBytes += penneBytes;
-	offsetSlots += GEOMETRY::PENNE.size();
-	// Macaroni
-	buffer.write(offsetBytes, &GEOMETRY::MACARONI.front(), macaroniBytes);
-	offsetMacaroni = offsetSlots;
-	offsetBytes += macaroniBytes;
-	offsetSlots += GEOMETRY::MACARONI.size();
-	// Pancake
-	buffer.write(offsetBytes, &GEOMETRY::PANCAKE.front(), pancakeBytes);
-	offsetPancake = offsetSlots;
-	offsetBytes += pancakeBytes;
-	offsetSlots += GEOMETRY::PANCAKE.size();
-	// Cube
-	buffer.write(offsetBytes, &GEOMETRY::CUBE.front(), cubeBytes);
-	offsetCube = offsetSlots;
+	for (auto const& mesh : meshes) {
+		buffer.write(offsetBytes, mesh.first.data, int(mesh.first.bytes()));
+		*mesh.second = offsetSlots;
+		offsetBytes += int(mesh.first.bytes());
+		offsetSlots += int(mesh.first.size);
+	}
 
 	// Create Vertex Array Object (VAO)
 	object.create();
@@ -99,8 +95,46 @@ void OpenGLRenderer::init() {
 	// Release (unbind) all
 	object.release();
 	buffer.release();
+
+	// Trails: the positions are rewritten every frame => dynamic, and the index buffer is part of the VAO
+	trailObject.create();
+	trailObject.bind();
+	trailBuffer.create();
+	trailBuffer.bind();
+	trailBuffer.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+	trailIndices.create();
+	trailIndices.bind();
+	trailIndices.setUsagePattern(QOpenGLBuffer::StaticDraw);
+	program->enableAttributeArray("position");
+	program->setAttributeBuffer("position", GL_FLOAT, 0, 3, 3 * sizeof(float));
+
+	trailObject.release();
+	trailBuffer.release();
 	program->release();
 
+	// Phase space panel: textured unit squares, placed by the `rect` uniform
+	panelProgram = new QOpenGLShaderProgram();
+	panelProgram->addShaderFromSourceFile(QOpenGLShader::Vertex, ":/common/shaders/panelVertex.glsl");
+	panelProgram->addShaderFromSourceFile(QOpenGLShader::Fragment, ":/common/shaders/panelFragment.glsl");
+	panelProgram->link();
+	panelProgram->bind();
+
+	GLfloat const square[] = { 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1 };
+	panelBuffer.create();
+	panelBuffer.bind();
+	panelBuffer.setUsagePattern(QOpenGLBuffer::StaticDraw);
+	panelBuffer.allocate(square, sizeof(square));
+
+	panelObject.create();
+	panelObject.bind();
+	panelProgram->enableAttributeArray("position");
+	panelProgram->setAttributeBuffer("position", GL_FLOAT, 0, 2, 2 * sizeof(GLfloat));
+	panelProgram->setUniformValue("density", 0);
+
+	panelObject.release();
+	panelBuffer.release();
+	panelProgram->release();
+
 	reset();
 }
 
@@ -165,6 +199,8 @@ void OpenGLRenderer::begin() {
 	program->setUniformValue("cameraToView", projection);
 	program->setUniformValue("modelToWorld", transform.getMatrix());
 	program->setUniformValue("color", 0, 0, 0);
+
+	frustum = Frustum(projection * camera.getMatrix());
 }
 
 /**
@@ -191,23 +227,17 @@ void OpenGLRenderer::draw(Accelerator const& acc) {
 	// It is important for Particles to be drawn first for alpha blending to work
 	// ELSE, we are forcing drawing of particles on top
 	glEnable(GL_DEPTH_TEST);
-	acc.drawElements();
+	acc.drawElements(this);
 	glDisable(GL_DEPTH_TEST);
-	acc.drawBeams();
+	drawTrails(acc);
+	acc.drawBeams(this);
 }
 
 void OpenGLRenderer::draw(Beam const& beam) {
-	beam.drawParticles();
+	beam.drawParticles(this);
 }
 
 void OpenGLRenderer::draw(Dipole const& dipole) {
-	// #686de0
-
-	program->setUniformValue("color", 104/255.0, 108/255.0, 224/255.0);
-
-	transform.save();
-	transform.reset();
-
 	QVector3D posIn(dipole.getPosIn().toQVector3D());
 	QVector3D posOut(dipole.getPosOut().toQVector3D());
 	QVector3D center(dipole.getCenter().toQVector3D());
@@ -217,7 +247,22 @@ void OpenGLRenderer::draw(Dipole const& dipole) {
 	double innerRadius(dipole.getRadius());
 	double curvature(dipole.getCurvature());
 
-	drawTorus(center, (curvature > 0 ? outAngle : inAngle), totalAngle, curvature, innerRadius);
+	// Bounding sphere: an arc of at most half a turn stays within half its chord of the middle of the chord
+	QVector3D sphereCenter(center);
+	double sphereRadius(std::abs(1/curvature) + innerRadius);
+	if (std::abs(totalAngle) <= M_PI) {
+		sphereCenter = (posIn + posOut) / 2;
+		sphereRadius = (posOut - posIn).length() / 2 + innerRadius;
+	}
+	if (not isVisible(sphereCenter, sphereRadius)) { return; }
+
+	// #686de0
+	setElementColor(dipole, 104/255.0, 108/255.0, 224/255.0);
+
+	transform.save();
+	transform.reset();
+
+	drawTorus(center, (curvature > 0 ? outAngle : inAngle), totalAngle, curvature, innerRadius, getLevelOfDetail(sphereCenter, sphereRadius));
 }
 
 void OpenGLRenderer::draw(Quadrupole const& quadrupole) {
@@ -225,10 +270,15 @@ void OpenGLRenderer::draw(Quadrupole const& quadrupole) {
 	Vector3D posOut(quadrupole.getPosOut());
 	double radius(quadrupole.getRadius());
 
+	// Bounding sphere
+	QVector3D center(((posIn + posOut) / 2).toQVector3D());
+	double sphereRadius(std::hypot((posOut - posIn).norm() / 2, radius));
+	if (not isVisible(center, sphereRadius)) { return; }
+
 	// #ff7979
-	program->setUniformValue("color", 255/255.0, 121/255.0, 121/255.0);
+	setElementColor(quadrupole, 255/255.0, 121/255.0, 121/255.0);
 
-	drawCylinder(posIn.toQVector3D(), posOut.toQVector3D(), radius);
+	drawCylinder(posIn.toQVector3D(), posOut.toQVector3D(), radius, getLevelOfDetail(center, sphereRadius));
 }
 
 void OpenGLRenderer::draw(Straight const& straight) {
@@ -236,14 +286,21 @@ void OpenGLRenderer::draw(Straight const& straight) {
 	Vector3D posOut(straight.getPosOut());
 	double radius(straight.getRadius());
 
+	// Bounding sphere
+	QVector3D center(((posIn + posOut) / 2).toQVector3D());
+	double sphereRadius(std::hypot((posOut - posIn).norm() / 2, radius));
+	if (not isVisible(center, sphereRadius)) { return; }
+
 	// #ffbe76
-	program->setUniformValue("color", 255/255.0, 190/255.0, 118/255.0);
+	setElementColor(straight, 255/255.0, 190/255.0, 118/255.0);
 
-	drawCylinder(posIn.toQVector3D(), posOut.toQVector3D(), radius);
+	drawCylinder(posIn.toQVector3D(), posOut.toQVector3D(), radius, getLevelOfDetail(center, sphereRadius));
 }
 
 void OpenGLRenderer::draw(Frodo const& frodo) {
-	frodo.drawElements();
+	frodo_ptr = &frodo;
+	frodo.drawElements(this);
+	frodo_ptr = nullptr;
 }
 
 void OpenGLRenderer::draw(Particle const& particle) {
@@ -305,7 +362,7 @@ void OpenGLRenderer::drawPoint(QVector3D const& pos) {
 
 	program->setUniformValue("modelToWorld", transform.getMatrix());
 	object.bind();
-	glDrawArrays(GL_POINTS, offsetPea, GEOMETRY::PEA.size());
+	glDrawArrays(GL_POINTS, offsetPea, GEOMETRY::getPea().size);
 
 	transform.restore();
 }
@@ -321,23 +378,23 @@ void OpenGLRenderer::drawAxes() {
 	program->setUniformValue("color", 1.0, 0.5, 0.5, 1.0);
 	program->setUniformValue("modelToWorld", transform.getMatrix());
 	object.bind();
-	glDrawArrays(GL_LINES, offsetSpaghetti, GEOMETRY::SPAGHETTI.size());
+	glDrawArrays(GL_LINES, offsetSpaghetti, GEOMETRY::getSpaghetti().size);
 	// Y axis
 	transform.rotate(90, 0, 0, 1);
 	program->setUniformValue("color", 0.0, 0.8, 0.0, 1.0);
 	program->setUniformValue("modelToWorld", transform.getMatrix());
 	object.bind();
-	glDrawArrays(GL_LINES, offsetSpaghetti, GEOMETRY::SPAGHETTI.size());
+	glDrawArrays(GL_LINES, offsetSpaghetti, GEOMETRY::getSpaghetti().size);
 	// Z axis
 	transform.rotate(90, 1, 0, 0);
 	program->setUniformValue("color", 0.5, 0.5, 1.0, 1.0);
 	program->setUniformValue("modelToWorld", transform.getMatrix());
 	object.bind();
-	glDrawArrays(GL_LINES, offsetSpaghetti, GEOMETRY::SPAGHETTI.size());
+	glDrawArrays(GL_LINES, offsetSpaghetti, GEOMETRY::getSpaghetti().size);
 	transform.restore();
 }
 
-void OpenGLRenderer::drawCylinder(QVector3D const& posIn, QVector3D const& posOut, double radius) {
+void OpenGLRenderer::drawCylinder(QVector3D const& posIn, QVector3D const& posOut, double radius, size_t lod) {
 	transform.save();
 
 	transform.rotate(QQuaternion::rotationTo(posIn - posOut, Transform3D::LocalRight));
@@ -347,12 +404,12 @@ void OpenGLRenderer::drawCylinder(QVector3D const& posIn, QVector3D const& posOu
 
 	program->setUniformValue("modelToWorld", transform.getMatrix());
 	object.bind();
-	glDrawArrays(GL_TRIANGLES, offsetPenne, GEOMETRY::PENNE.size());
+	glDrawArrays(GL_TRIANGLES, offsetPenne[lod], GEOMETRY::getPenne(lod).size);
 
 	transform.restore();
 }
 
-void OpenGLRenderer::drawTorus(QVector3D const& center, double startAngle, double totalAngle, double curvature, double innerRadius) {
+void OpenGLRenderer::drawTorus(QVector3D const& center, double startAngle, double totalAngle, double curvature, double innerRadius, size_t lod) {
 	transform.save();
 
 	QQuaternion quat(QQuaternion::fromAxisAndAngle(Transform3D::LocalUp, startAngle * 180 / M_PI));
@@ -370,16 +427,175 @@ void OpenGLRenderer::drawTorus(QVector3D const& center, double startAngle, doubl
 
 	program->setUniformValue("modelToWorld", transform.getMatrix());
 	object.bind();
-	glDrawArrays(GL_TRIANGLES, offsetMacaroni, int(GEOMETRY::MACARONI.size() * lambda));
+	glDrawArrays(GL_TRIANGLES, offsetMacaroni[lod], int(GEOMETRY::getMacaroni(lod).size * lambda));
 
 	transform.restore();
 }
 
+void OpenGLRenderer::drawTrails(Accelerator const& acc) {
+	if (trails.getLength() == 0) { return; }
+
+	size_t head(trails.getHead());
+	int slotBytes(int(trails.getPositions().size() * sizeof(float)));
+	if (trails.record(acc)) {
+		// New history: every slot starts at the current positions, and the segments are uploaded once
+		slotBytes = int(trails.getPositions().size() * sizeof(float));
+		trailBuffer.bind();
+		trailBuffer.allocate(slotBytes * int(trails.getLength()));
+		for (size_t slot(0); slot < trails.getLength(); ++slot) {
+			trailBuffer.write(int(slot) * slotBytes, trails.getPositions().data(), slotBytes);
+		}
+		trailBuffer.release();
+		trailObject.bind();
+		trailIndices.bind();
+		trailIndices.allocate(trails.getIndices().data(), int(trails.getIndices().size() * sizeof(std::uint32_t)));
+	} else if (trails.getHead() != head) {
+		// Only the slot of the new frame is uploaded
+		trailBuffer.bind();
+		trailBuffer.write(int(trails.getHead()) * slotBytes, trails.getPositions().data(), slotBytes);
+		trailBuffer.release();
+	}
+
+	if (trails.getIndexCount() == 0) {
+		object.bind();
+		return;
+	}
+
+	// #95afc0
+	program->setUniformValue("color", 149/255.0, 175/255.0, 192/255.0);
+	program->setUniformValue("modelToWorld", QMatrix4x4());
+	// The trail VAO has no normals, the lighting gets the same one for every vertex
+	program->setAttributeValue("normal", 0.0, 1.0, 0.0);
+
+	trailObject.bind();
+	glLineWidth(1.0);
+	glDrawElements(GL_LINES, int(trails.getIndexCount()), GL_UNSIGNED_INT, reinterpret_cast<void const*>(trails.getFirstIndex() * sizeof(std::uint32_t)));
+	object.bind();
+}
+
+void OpenGLRenderer::drawPhaseSpace(std::vector<PhaseSpaceHistogram> const& histograms) {
+	// New Beams: new textures
+	if (phaseSpacePasses.size() != histograms.size()) {
+		phaseSpaceTextures.clear();
+		for (PhaseSpaceHistogram const& histogram : histograms) {
+			for (size_t plane(0); plane < 2; ++plane) {
+				std::unique_ptr<QOpenGLTexture> texture(new QOpenGLTexture(QOpenGLTexture::Target2D));
+				texture->setSize(int(histogram.getBins()), int(histogram.getBins()));
+				texture->setFormat(QOpenGLTexture::R8_UNorm);
+				texture->setMinMagFilters(QOpenGLTexture::Nearest, QOpenGLTexture::Nearest);
+				texture->setWrapMode(QOpenGLTexture::ClampToEdge);
+				texture->allocateStorage(QOpenGLTexture::Red, QOpenGLTexture::UInt8);
+				phaseSpaceTextures.push_back(std::move(texture));
+			}
+		}
+		// No pass uploaded yet
+		phaseSpacePasses.assign(histograms.size(), size_t(-1));
+	}
+
+	// The rows of the images are packed
+	QOpenGLPixelTransferOptions packed;
+	packed.setAlignment(1);
+
+	glDisable(GL_DEPTH_TEST);
+	panelProgram->bind();
+	panelObject.bind();
+
+	double height(2 * GRAPHICS::PHASE_SPACE_SIZE), width(height / aspectRatio), margin(0.02);
+	for (size_t beam(0); beam < histograms.size(); ++beam) {
+		for (PhasePlane plane : { PhasePlane::R, PhasePlane::Z }) {
+			QOpenGLTexture & texture(*phaseSpaceTextures[2 * beam + size_t(plane)]);
+			// Only the images of a new pass, never the Particles
+			if (phaseSpacePasses[beam] != histograms[beam].getPassCount()) {
+				texture.setData(QOpenGLTexture::Red, QOpenGLTexture::UInt8, histograms[beam].getImage(plane).data(), &packed);
+			}
+
+			// #dff9fb for (r, vr), #c7ecee for (z, vz)
+			if (plane == PhasePlane::R) panelProgram->setUniformValue("color", 223/255.0, 249/255.0, 251/255.0);
+			else panelProgram->setUniformValue("color", 199/255.0, 236/255.0, 238/255.0);
+			panelProgram->setUniformValue("rect", QVector4D(
+				-1 + margin + size_t(plane) * (width + margin),
+				-1 + margin + beam * (height + margin),
+				width, height
+			));
+
+			texture.bind(0);
+			glDrawArrays(GL_TRIANGLES, 0, 6);
+			texture.release(0);
+		}
+		phaseSpacePasses[beam] = histograms[beam].getPassCount();
+	}
+
+	panelObject.release();
+	panelProgram->release();
+
+	// Back to the scene
+	program->bind();
+	object.bind();
+}
+
+/****************************************************************
+ * Trails
+ ****************************************************************/
+
+size_t OpenGLRenderer::getTrailLength() const {
+	return trails.getLength();
+}
+
+void OpenGLRenderer::setTrailLength(size_t length) {
+	trails.setLength(length);
+}
+
+/****************************************************************
+ * Loss map
+ ****************************************************************/
+
+void OpenGLRenderer::setLossMap(LossMap const* lossMap_ptr) {
+	this->lossMap_ptr = lossMap_ptr;
+}
+
+void OpenGLRenderer::setElementColor(Element const& element, double red, double green, double blue) {
+	// The sections of a Frodo only have an index of their own once flattened (see Accelerator::flattenElements())
+	size_t index(frodo_ptr != nullptr and not element.isLinked() ? frodo_ptr->getIndex() : element.getIndex());
+
+	if (lossMap_ptr != nullptr and lossMap_ptr->getMaxLosses() > 0 and index < lossMap_ptr->getElementCount()) {
+		// Linear blend towards red, the Element with the most losses being fully red
+		double heat(lossMap_ptr->getLosses(index) / double(lossMap_ptr->getMaxLosses()));
+		red += (1 - red) * heat;
+		green -= green * heat;
+		blue -= blue * heat;
+	}
+
+	program->setUniformValue("color", red, green, blue);
+}
+
+/****************************************************************
+ * Culling and level of detail
+ ****************************************************************/
+
+bool OpenGLRenderer::isVisible(QVector3D const& center, double radius) const {
+	return frustum.containsSphere(center, radius);
+}
+
+size_t OpenGLRenderer::getLevelOfDetail(QVector3D const& center, double radius) const {
+	double distance((center - camera.getTranslation()).length());
+	// The camera is inside the object
+	if (distance <= radius) { return 0; }
+
+	// Fraction of the half height of the view covered by the object
+	double size(radius / (distance * std::tan(GRAPHICS::FOV * M_PI / 360)));
+
+	for (size_t lod(0); lod + 1 < GRAPHICS::LOD_COUNT; ++lod) {
+		if (size >= GRAPHICS::LOD_SIZE[lod]) { return lod; }
+	}
+	return GRAPHICS::LOD_COUNT - 1;
+}
+
 /**
  * Resize event
  */
 
 void OpenGLRenderer::resize(int width, int height) {
+	aspectRatio = width / double(height);
 	projection.setToIdentity();
 	// WARNING: camera near plane needs to be strictly bigger than 0 for the depth test to work !
 	projection.perspective(GRAPHICS::FOV, width / double(height), GRAPHICS::CLOSE_PLANE, GRAPHICS::FAR_PLANE);
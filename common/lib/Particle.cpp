@@ -18,7 +18,7 @@ using namespace std;
 // Constructor for init with velocity and energy
 
 Particle::Particle(Vector3D const& pos, double energy, Vector3D speed, double _mass, int charge, bool unitGeV, Renderer * engine_ptr)
-: Drawable(engine_ptr), mass(_mass), charge(charge), pos(pos), forces(Vector3D()), element_ptr(nullptr)
+: Drawable(engine_ptr), mass(_mass), charge(charge), pos(pos), forces(Vector3D()), element_ptr(nullptr), element(NO_ELEMENT), elementProgress(0)
 {
 	double factor(0);
 
@@ -117,6 +117,138 @@ unique_ptr<Particle> Electron::scaledCopy(Vector3D const& pos, double energy, Ve
 	return unique_ptr<Particle>(new Electron(pos, energy, speed, lambda));
 }
 
+/****************************************************************
+ * Polymorphic copy in an Arena (for Beam)
+ ****************************************************************/
+
+Particle * Particle::copy(Arena & arena) const {
+	return arena.create<Particle>(*this);
+}
+
+Particle * Proton::copy(Arena & arena) const {
+	return arena.create<Proton>(*this);
+}
+
+Particle * AntiProton::copy(Arena & arena) const {
+	return arena.create<AntiProton>(*this);
+}
+
+Particle * Electron::copy(Arena & arena) const {
+	return arena.create<Electron>(*this);
+}
+
+Particle * Particle::scaledCopy(Vector3D const& pos, double energy, Vector3D speed, double _mass, int charge, double lambda, Arena & arena) const {
+	return arena.create<Particle>(pos, energy * lambda, speed, _mass * lambda, charge * lambda);
+}
+
+Particle * Proton::scaledCopy(Vector3D const& pos, double energy, Vector3D speed, double _mass, int charge, double lambda, Arena & arena) const {
+	(void) _mass;
+	(void) charge;
+	return arena.create<Proton>(pos, energy, speed, lambda);
+}
+
+Particle * AntiProton::scaledCopy(Vector3D const& pos, double energy, Vector3D speed, double _mass, int charge, double lambda, Arena & arena) const {
+	(void) _mass;
+	(void) charge;
+	return arena.create<AntiProton>(pos, energy, speed, lambda);
+}
+
+Particle * Electron::scaledCopy(Vector3D const& pos, double energy, Vector3D speed, double _mass, int charge, double lambda, Arena & arena) const {
+	(void) _mass;
+	(void) charge;
+	return arena.create<Electron>(pos, energy, speed, lambda);
+}
+
+size_t Particle::getSize() const { return sizeof(Particle); }
+
+size_t Proton::getSize() const { return sizeof(Proton); }
+
+size_t AntiProton::getSize() const { return sizeof(AntiProton); }
+
+size_t Electron::getSize() const { return sizeof(Electron); }
+
+/****************************************************************
+ * Flat copy (ParticleRecord)
+ ****************************************************************/
+
+ParticleKind Particle::getKind() const { return ParticleKind::PARTICLE; }
+
+ParticleKind Proton::getKind() const { return ParticleKind::PROTON; }
+
+ParticleKind AntiProton::getKind() const { return ParticleKind::ANTIPROTON; }
+
+ParticleKind Electron::getKind() const { return ParticleKind::ELECTRON; }
+
+ParticleRecord Particle::toRecord() const {
+	ParticleRecord record{};
+	record.pos[0] = pos.getX();
+	record.pos[1] = pos.getY();
+	record.pos[2] = pos.getZ();
+	record.momentum[0] = momentum.getX();
+	record.momentum[1] = momentum.getY();
+	record.momentum[2] = momentum.getZ();
+	record.mass = mass;
+	record.charge = charge;
+	record.kind = getKind();
+	return record;
+}
+
+unique_ptr<Particle> Particle::fromRecord(ParticleRecord const& record, Renderer * engine_ptr) {
+	Vector3D position(record.pos[0], record.pos[1], record.pos[2]);
+	// Any valid energy and direction: the state is overwritten below
+	Vector3D direction(1, 0, 0);
+	unique_ptr<Particle> particle;
+
+	switch (record.kind) {
+		case ParticleKind::PROTON:
+			particle = unique_ptr<Particle>(new Proton(position, 2 * CONSTANTS::M_PROTON, direction, true, engine_ptr));
+			break;
+		case ParticleKind::ANTIPROTON:
+			particle = unique_ptr<Particle>(new AntiProton(position, 2 * CONSTANTS::M_PROTON, direction, true, engine_ptr));
+			break;
+		case ParticleKind::ELECTRON:
+			particle = unique_ptr<Particle>(new Electron(position, 2 * CONSTANTS::M_ELECTRON, direction, true, engine_ptr));
+			break;
+		default:
+			particle = unique_ptr<Particle>(new Particle(position, 2 * CONSTANTS::M_PROTON, direction, CONSTANTS::M_PROTON, 1, true, engine_ptr));
+			break;
+	}
+
+	particle->loadRecord(record);
+	return particle;
+}
+
+Particle * Particle::fromRecord(ParticleRecord const& record, Arena & arena, Renderer * engine_ptr) {
+	Vector3D position(record.pos[0], record.pos[1], record.pos[2]);
+	// Any valid energy and direction: the state is overwritten below
+	Vector3D direction(1, 0, 0);
+	Particle * particle(nullptr);
+
+	switch (record.kind) {
+		case ParticleKind::PROTON:
+			particle = arena.create<Proton>(position, 2 * CONSTANTS::M_PROTON, direction, true, engine_ptr);
+			break;
+		case ParticleKind::ANTIPROTON:
+			particle = arena.create<AntiProton>(position, 2 * CONSTANTS::M_PROTON, direction, true, engine_ptr);
+			break;
+		case ParticleKind::ELECTRON:
+			particle = arena.create<Electron>(position, 2 * CONSTANTS::M_ELECTRON, direction, true, engine_ptr);
+			break;
+		default:
+			particle = arena.create<Particle>(position, 2 * CONSTANTS::M_PROTON, direction, CONSTANTS::M_PROTON, 1, true, engine_ptr);
+			break;
+	}
+
+	particle->loadRecord(record);
+	return particle;
+}
+
+void Particle::loadRecord(ParticleRecord const& record) {
+	mass = record.mass;
+	charge = record.charge;
+	momentum = Vector3D(record.momentum[0], record.momentum[1], record.momentum[2]);
+}
+
 /****************************************************************
  * Getters
  ****************************************************************/
@@ -144,6 +276,8 @@ Vector3D Particle::getMoment() const { return momentum; }
 
 Vector3D Particle::getPos() const { return pos; }
 
+double Particle::getElementProgress() const { return elementProgress; }
+
 Element const * Particle::getElementPtr() const {
 	if (element_ptr != nullptr) {
 		return element_ptr;
@@ -152,6 +286,14 @@ Element const * Particle::getElementPtr() const {
 	}
 }
 
+uint32_t Particle::getElementIndex() const { return element; }
+
+Element const& Particle::getElement(vector<Element *> const& lattice) const {
+	if (element == NO_ELEMENT) { return *getElementPtr(); }
+	if (element >= lattice.size()) { ERROR(EXCEPTIONS::NO_ELEMENT); }
+	return *lattice[element];
+}
+
 /****************************************************************
  * Setters
  ****************************************************************/
@@ -160,11 +302,19 @@ void Particle::setElement(Element * _element_ptr) {
 	// Protection against empty pointers
 	if (_element_ptr != nullptr) {
 		element_ptr = _element_ptr;
+		element = NO_ELEMENT;
 	} else {
 		ERROR(EXCEPTIONS::NULLPTR);
 	}
 }
 
+void Particle::setElementIndex(size_t element) {
+	this->element = uint32_t(element);
+	element_ptr = nullptr;
+}
+
+void Particle::setElementProgress(double elementProgress) { this->elementProgress = elementProgress; }
+
 /****************************************************************
  * Methods
  ****************************************************************/
@@ -232,14 +382,18 @@ void Particle::step(double dt, bool methodChapi) {
 	// Do nothing if dt is null
 	if (abs(dt) < GLOBALS::DELTA_DIV0) { return; }
 
+	// A particle can live freely without an Element so no return of EXCEPTIONS::NULLPTR in the other case
+	// In that case you have to do a Particle::exertLorentzForce by yourself
+	step(dt, element_ptr != nullptr ? element_ptr->getField(pos, methodChapi) : Vector3D(0, 0, 0));
+}
+
+void Particle::step(double dt, Vector3D const& B) {
+	if (abs(dt) < GLOBALS::DELTA_DIV0) { return; }
+
 	// Integrate the movement equations
 	double const lambda(1 / (getGamma() * getMass()));
 
-	// A particle can live freely without an Element so no return of EXCEPTIONS::NULLPTR in the other case
-	// In that case you have to do a Particle::exertLorentzForce by yourself
-	if (element_ptr != nullptr) {
-		exertLorentzForce(element_ptr->getField(pos, methodChapi), dt);
-	}
+	exertLorentzForce(B, dt);
 
 	momentum += getMass() * dt * lambda * getForces();
 	pos += dt * getSpeed();
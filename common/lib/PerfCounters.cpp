@@ -0,0 +1,131 @@
+#include "include/bundle/PerfCounters.bundle.h"
+
+using namespace std;
+
+#ifdef __linux__
+namespace {
+	// Type and configuration of each PerfEvent for perf_event_attr
+	struct EventConfig {
+		uint32_t type;
+		uint64_t config;
+	};
+
+	array<EventConfig, size_t(PerfEvent::COUNT)> const CONFIGS({
+		EventConfig({ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES }),
+		EventConfig({ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS }),
+		EventConfig({ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) }),
+		EventConfig({ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES }),
+		EventConfig({ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES })
+	});
+
+	// Layout of a read() on the leader with PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING
+	struct GroupRead {
+		uint64_t count;
+		uint64_t timeEnabled;
+		uint64_t timeRunning;
+		uint64_t values[size_t(PerfEvent::COUNT)];
+	};
+}
+#endif
+
+/****************************************************************
+ * Constructors and destructors
+ ****************************************************************/
+
+PerfCounters::PerfCounters()
+: leader(-1), openCount(0)
+{
+	descriptors.fill(-1);
+	positions.fill(0);
+
+	#ifdef __linux__
+		for (size_t event(0); event < descriptors.size(); ++event) {
+			perf_event_attr attributes;
+			memset(&attributes, 0, sizeof(attributes));
+			attributes.size = sizeof(attributes);
+			attributes.type = CONFIGS[event].type;
+			attributes.config = CONFIGS[event].config;
+			attributes.disabled = (leader == -1);
+			attributes.exclude_kernel = 1;
+			attributes.exclude_hv = 1;
+			attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+			// Calling thread, any CPU
+			int descriptor(int(syscall(SYS_perf_event_open, &attributes, 0, -1, leader, 0)));
+			if (descriptor < 0) { continue; }
+
+			descriptors[event] = descriptor;
+			positions[event] = openCount++;
+			if (leader == -1) { leader = descriptor; }
+		}
+
+		if (leader != -1) {
+			ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+			ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+		}
+	#endif
+}
+
+PerfCounters::~PerfCounters() {
+	#ifdef __linux__
+		for (int descriptor : descriptors) {
+			if (descriptor != -1) { close(descriptor); }
+		}
+	#endif
+}
+
+/****************************************************************
+ * Getters
+ ****************************************************************/
+
+bool PerfCounters::isAvailable() const { return leader != -1; }
+
+bool PerfCounters::isAvailable(PerfEvent event) const { return descriptors[size_t(event)] != -1; }
+
+char const* PerfCounters::getName(PerfEvent event) {
+	switch (event) {
+		case PerfEvent::CYCLES: return "cycles";
+		case PerfEvent::INSTRUCTIONS: return "instructions";
+		case PerfEvent::L1D_MISSES: return "L1d misses";
+		case PerfEvent::LLC_MISSES: return "LLC misses";
+		case PerfEvent::BRANCH_MISSES: return "branch misses";
+		default: ERROR(EXCEPTIONS::BAD_RANGE);
+	}
+}
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+PerfSample PerfCounters::read() const {
+	PerfSample sample;
+	sample.fill(0);
+
+	#ifdef __linux__
+		GroupRead values;
+		if (leader == -1 or ::read(leader, &values, sizeof(values)) <= 0) { return sample; }
+
+		// Multiplexed: the counters only ran during a part of the time
+		double scale(1);
+		if (values.timeRunning > 0 and values.timeRunning < values.timeEnabled) {
+			scale = double(values.timeEnabled) / values.timeRunning;
+		}
+
+		for (size_t event(0); event < sample.size(); ++event) {
+			if (descriptors[event] != -1 and positions[event] < values.count) {
+				sample[event] = uint64_t(values.values[positions[event]] * scale);
+			}
+		}
+	#endif
+
+	return sample;
+}
+
+PerfSample PerfCounters::difference(PerfSample const& start, PerfSample const& end) {
+	PerfSample result;
+	for (size_t event(0); event < result.size(); ++event) {
+		// The scaling of multiplexed counters may go backwards by a few counts
+		result[event] = (end[event] > start[event]) ? end[event] - start[event] : 0;
+	}
+	return result;
+}
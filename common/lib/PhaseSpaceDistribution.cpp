@@ -0,0 +1,127 @@
+#include "include/bundle/PhaseSpaceDistribution.bundle.h"
+
+using namespace std;
+
+namespace {
+	// Number of sigmas at which the GAUSSIAN shape is cut by default
+	double const DEFAULT_TRUNCATION(3);
+
+	// Blocks drawn per attempt: 2 for the transverse planes, 1 for the energy, 1 for the radius of the WATERBAG shape
+	uint64_t const DRAWS_PER_ATTEMPT(4);
+
+	// Variance of a coordinate of a 2D standard normal law cut at the radius t
+	double planeVariance(double t) {
+		double tail(exp(- t * t / 2));
+		return (1 - (1 + t * t / 2) * tail) / (1 - tail);
+	}
+
+	// Variance of a 1D standard normal law cut at t
+	double lineVariance(double t) {
+		return 1 - 2 * t * exp(- t * t / 2) / sqrt(2 * M_PI) / erf(t / sqrt(2));
+	}
+}
+
+/****************************************************************
+ * Constructors
+ ****************************************************************/
+
+PhaseSpaceDistribution::PhaseSpaceDistribution(DistributionShape shape, uint64_t seed)
+: shape(shape), seed(seed), planeR({ 0, 0, 0 }), planeZ({ 0, 0, 0 }), energySpread(0), truncation(DEFAULT_TRUNCATION)
+{}
+
+/****************************************************************
+ * Getters
+ ****************************************************************/
+
+DistributionShape PhaseSpaceDistribution::getShape() const { return shape; }
+
+uint64_t PhaseSpaceDistribution::getSeed() const { return seed; }
+
+double PhaseSpaceDistribution::getTruncation() const { return truncation; }
+
+/****************************************************************
+ * Setters
+ ****************************************************************/
+
+void PhaseSpaceDistribution::setR(double emittance, Vector3D const& ellipseCoef) { planeR = matchedPlane(emittance, ellipseCoef); }
+
+void PhaseSpaceDistribution::setZ(double emittance, Vector3D const& ellipseCoef) { planeZ = matchedPlane(emittance, ellipseCoef); }
+
+void PhaseSpaceDistribution::setEnergySpread(double energySpread) {
+	if (energySpread < 0) { ERROR(EXCEPTIONS::BAD_EMITTANCE); }
+	this->energySpread = energySpread;
+}
+
+void PhaseSpaceDistribution::setTruncation(double truncation) {
+	if (truncation < 1) { ERROR(EXCEPTIONS::BAD_TRUNCATION); }
+	this->truncation = truncation;
+}
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+PhaseSpaceDistribution::Plane PhaseSpaceDistribution::matchedPlane(double emittance, Vector3D const& ellipseCoef) {
+	if (emittance < 0) { ERROR(EXCEPTIONS::BAD_EMITTANCE); }
+
+	double A11(ellipseCoef.getX());
+	double A22(ellipseCoef.getY());
+	double A12(ellipseCoef.getZ());
+	double determinant(A11 * A22 - A12 * A12);
+
+	if (A22 <= 0 or determinant <= 0) { ERROR(EXCEPTIONS::BAD_ELLIPSE); }
+
+	// Normalized so that A11 * A22 - A12² = 1, as returned by Beam::getEllipsePhaseCoefR()
+	double norm(sqrt(determinant));
+	A22 /= norm;
+	A12 /= norm;
+
+	// Cholesky factor of the covariance [[A22, -A12], [-A12, A11]] * emittance
+	return Plane({
+		sqrt(A22 * emittance),
+		- A12 * sqrt(emittance / A22),
+		sqrt(emittance / A22)
+	});
+}
+
+PhaseSpaceSample PhaseSpaceDistribution::sample(uint64_t index) const {
+	Philox generator(seed);
+	array<double, 4> u;
+	double energy(0);
+
+	// Rejection of the tails: each attempt uses its own counters, so the result still only depends on the index
+	for (uint64_t attempt(0); ; ++attempt) {
+		uint64_t draw(attempt * DRAWS_PER_ATTEMPT);
+		array<double, 2> n01(Philox::normals(generator(index, draw)));
+		array<double, 2> n23(Philox::normals(generator(index, draw + 1)));
+		energy = Philox::normals(generator(index, draw + 2))[0];
+		u = { n01[0], n01[1], n23[0], n23[1] };
+
+		if (abs(energy) > truncation) { continue; }
+
+		if (shape == DistributionShape::WATERBAG) {
+			// Uniform direction, radius such that the density is uniform in the 4D unit ball,
+			// scaled so that each coordinate has a unit variance (1/6 in the unit ball)
+			double norm(sqrt(u[0] * u[0] + u[1] * u[1] + u[2] * u[2] + u[3] * u[3]));
+			double radius(pow(Philox::uniforms(generator(index, draw + 3))[0], 0.25));
+			for (double & x : u) { x *= sqrt(6) * radius / norm; }
+			break;
+		}
+
+		if (u[0] * u[0] + u[1] * u[1] <= truncation * truncation and u[2] * u[2] + u[3] * u[3] <= truncation * truncation) {
+			// The cut removes some variance: it is given back so that the emittances stay matched
+			for (double & x : u) { x /= sqrt(planeVariance(truncation)); }
+			break;
+		}
+	}
+
+	energy /= sqrt(lineVariance(truncation));
+
+	return PhaseSpaceSample({
+		planeR.a * u[0],
+		planeR.b * u[0] + planeR.c * u[1],
+		planeZ.a * u[2],
+		planeZ.b * u[2] + planeZ.c * u[3],
+		1 + energySpread * energy
+	});
+}
@@ -0,0 +1,144 @@
+#include "include/bundle/PhaseSpaceHistogram.bundle.h"
+
+using namespace std;
+
+namespace {
+	// Bounds containing nothing, widened by the first point
+	PhaseRange const EMPTY_RANGE = {
+		numeric_limits<double>::infinity(), -numeric_limits<double>::infinity(),
+		numeric_limits<double>::infinity(), -numeric_limits<double>::infinity()
+	};
+
+	// Bin of `value` in [min, max], the values outside going to the edge bins
+	size_t binOf(double value, double min, double max, size_t bins) {
+		double bin(floor((value - min) / (max - min) * bins));
+		if (not (bin >= 0)) { return 0; }
+		if (bin >= bins) { return bins - 1; }
+		return size_t(bin);
+	}
+
+	// Bounds of the next pass: a margin around the measured ones, never empty
+	PhaseRange widen(PhaseRange range) {
+		double margin((range.max - range.min) * 0.05 + GLOBALS::EPSILON);
+		double speedMargin((range.speedMax - range.speedMin) * 0.05 + GLOBALS::EPSILON);
+		return { range.min - margin, range.max + margin, range.speedMin - speedMargin, range.speedMax + speedMargin };
+	}
+}
+
+/****************************************************************
+ * Constructors
+ ****************************************************************/
+
+PhaseSpaceHistogram::PhaseSpaceHistogram(size_t bins, size_t chunk)
+: bins(bins), chunk(chunk), cursor(0), passCount(0), ranged(false)
+{
+	if (bins == 0 or chunk == 0) { ERROR(EXCEPTIONS::BAD_HISTOGRAM); }
+
+	for (Plane & plane : planes) {
+		plane.counts.assign(bins * bins, 0);
+		plane.building.assign(bins * bins, 0);
+		plane.image.assign(bins * bins, 0);
+	}
+	reset();
+}
+
+/****************************************************************
+ * Getters
+ ****************************************************************/
+
+size_t PhaseSpaceHistogram::getBins() const { return bins; }
+
+size_t PhaseSpaceHistogram::getPassCount() const { return passCount; }
+
+vector<uint32_t> const& PhaseSpaceHistogram::getCounts(PhasePlane plane) const { return planes[size_t(plane)].counts; }
+
+vector<uint8_t> const& PhaseSpaceHistogram::getImage(PhasePlane plane) const { return planes[size_t(plane)].image; }
+
+PhaseRange const& PhaseSpaceHistogram::getRange(PhasePlane plane) const { return planes[size_t(plane)].range; }
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+bool PhaseSpaceHistogram::update(Beam const& beam) {
+	size_t end(cursor + chunk);
+	Plane & planeR(planes[size_t(PhasePlane::R)]);
+	Plane & planeZ(planes[size_t(PhasePlane::Z)]);
+
+	// Only the ids are read for the Particles out of the chunk
+	bool remaining(false);
+	for (size_t part(0); part < beam.getParticleCount(); ++part) {
+		size_t id(beam.getParticleId(part));
+		if (id < cursor) { continue; }
+		if (id >= end) {
+			remaining = true;
+			continue;
+		}
+
+		Vector3D phaseR(beam.getPhaseR(part));
+		Vector3D phaseZ(beam.getPhaseZ(part));
+		add(planeR, phaseR.getX(), phaseR.getY());
+		add(planeZ, phaseZ.getX(), phaseZ.getY());
+	}
+
+	if (remaining) {
+		cursor = end;
+		return false;
+	}
+
+	// End of the pass
+	cursor = 0;
+	bool published(ranged);
+	for (Plane & plane : planes) {
+		if (ranged) { publish(plane); }
+		plane.binning = widen(plane.measuring);
+		plane.measuring = EMPTY_RANGE;
+		fill(plane.building.begin(), plane.building.end(), 0);
+	}
+	// An empty Beam gives no bounds
+	ranged = (beam.getParticleCount() > 0);
+	if (published) { ++passCount; }
+
+	return published;
+}
+
+void PhaseSpaceHistogram::reset() {
+	cursor = 0;
+	ranged = false;
+	for (Plane & plane : planes) {
+		plane.range = EMPTY_RANGE;
+		plane.binning = EMPTY_RANGE;
+		plane.measuring = EMPTY_RANGE;
+		fill(plane.counts.begin(), plane.counts.end(), 0);
+		fill(plane.building.begin(), plane.building.end(), 0);
+		fill(plane.image.begin(), plane.image.end(), 0);
+	}
+}
+
+/****************************************************************
+ * Private methods
+ ****************************************************************/
+
+void PhaseSpaceHistogram::add(Plane & plane, double position, double speed) {
+	plane.measuring.min = min(plane.measuring.min, position);
+	plane.measuring.max = max(plane.measuring.max, position);
+	plane.measuring.speedMin = min(plane.measuring.speedMin, speed);
+	plane.measuring.speedMax = max(plane.measuring.speedMax, speed);
+
+	if (not ranged) { return; }
+	size_t column(binOf(position, plane.binning.min, plane.binning.max, bins));
+	size_t row(binOf(speed, plane.binning.speedMin, plane.binning.speedMax, bins));
+	++plane.building[row * bins + column];
+}
+
+void PhaseSpaceHistogram::publish(Plane & plane) {
+	plane.counts.swap(plane.building);
+	plane.range = plane.binning;
+
+	// Logarithmic scale, so that the halo stays visible beside the core
+	uint32_t fullest(*max_element(plane.counts.begin(), plane.counts.end()));
+	double scale(fullest > 0 ? 255 / log1p(double(fullest)) : 0);
+	for (size_t i(0); i < plane.counts.size(); ++i) {
+		plane.image[i] = uint8_t(lround(log1p(double(plane.counts[i])) * scale));
+	}
+}
@@ -0,0 +1,69 @@
+#include "include/bundle/Philox.bundle.h"
+
+using namespace std;
+
+namespace {
+	// Constants of the reference implementation (Random123)
+	uint32_t const MULTIPLIER_0(0xD2511F53);
+	uint32_t const MULTIPLIER_1(0xCD9E8D57);
+	uint32_t const WEYL_0(0x9E3779B9);
+	uint32_t const WEYL_1(0xBB67AE85);
+	unsigned int const ROUNDS(10);
+}
+
+/****************************************************************
+ * Constructors
+ ****************************************************************/
+
+Philox::Philox(uint64_t seed)
+: key({ uint32_t(seed), uint32_t(seed >> 32) })
+{}
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+Philox::Block Philox::operator () (Block const& counter) const {
+	Block block(counter);
+	array<uint32_t, 2> roundKey(key);
+
+	for (unsigned int round(0); round < ROUNDS; ++round) {
+		if (round > 0) {
+			roundKey[0] += WEYL_0;
+			roundKey[1] += WEYL_1;
+		}
+
+		uint64_t product0(uint64_t(MULTIPLIER_0) * block[0]);
+		uint64_t product1(uint64_t(MULTIPLIER_1) * block[2]);
+
+		block = Block({
+			uint32_t(product1 >> 32) ^ block[1] ^ roundKey[0],
+			uint32_t(product1),
+			uint32_t(product0 >> 32) ^ block[3] ^ roundKey[1],
+			uint32_t(product0)
+		});
+	}
+
+	return block;
+}
+
+Philox::Block Philox::operator () (uint64_t index, uint64_t draw) const {
+	return (*this)(Block({ uint32_t(index), uint32_t(index >> 32), uint32_t(draw), uint32_t(draw >> 32) }));
+}
+
+array<double, 2> Philox::uniforms(Block const& block) {
+	array<double, 2> u;
+	for (size_t i(0); i < 2; ++i) {
+		// 53 bits, shifted by half a step so that neither 0 nor 1 can come out
+		uint64_t bits((uint64_t(block[2 * i]) << 21) ^ (block[2 * i + 1] >> 11));
+		u[i] = (double(bits) + 0.5) / 9007199254740992.0;
+	}
+	return u;
+}
+
+array<double, 2> Philox::normals(Block const& block) {
+	array<double, 2> u(uniforms(block));
+	double radius(sqrt(-2 * log(u[0])));
+	double angle(2 * M_PI * u[1]);
+	return { radius * cos(angle), radius * sin(angle) };
+}
@@ -0,0 +1,182 @@
+#include "include/bundle/Profiler.bundle.h"
+
+using namespace std;
+
+namespace {
+	// Common origin of the times of all the threads
+	chrono::steady_clock::time_point const origin(chrono::steady_clock::now());
+
+	// Identifiers of the threads in the trace
+	atomic<unsigned int> nextThreadId(0);
+
+	// Writes a time in ns as the µs of the trace
+	void writeMicroseconds(ostream & stream, int64_t time) {
+		stream << time / 1000 << '.' << setw(3) << setfill('0') << time % 1000 << setfill(' ');
+	}
+}
+
+/****************************************************************
+ * Constructors
+ ****************************************************************/
+
+Profiler::Profiler()
+: threadId(nextThreadId++), nextEvent(0), droppedEvents(0)
+{
+	reset();
+}
+
+Profiler::~Profiler() {}
+
+Profiler & Profiler::local() {
+	thread_local Profiler profiler;
+	return profiler;
+}
+
+/****************************************************************
+ * Getters
+ ****************************************************************/
+
+double Profiler::getTotalTime(ProfilerPhase phase) const { return totalTimes[size_t(phase)] * 1e-9; }
+
+uint64_t Profiler::getCallCount(ProfilerPhase phase) const { return callCounts[size_t(phase)]; }
+
+uint64_t Profiler::getCount(ProfilerCounter counter) const { return counts[size_t(counter)]; }
+
+uint64_t Profiler::getDroppedEvents() const { return droppedEvents; }
+
+bool Profiler::hasHardwareCounters() const { return perfCounters != nullptr; }
+
+uint64_t Profiler::getHardwareCount(ProfilerPhase phase, PerfEvent event) const { return hardwareCounts[size_t(phase)][size_t(event)]; }
+
+PerfCounters const* Profiler::getPerfCounters() const { return perfCounters.get(); }
+
+char const* Profiler::getName(ProfilerPhase phase) {
+	switch (phase) {
+		case ProfilerPhase::ACCELERATOR_STEP: return "Accelerator::step";
+		case ProfilerPhase::UPDATE_POINTED_ELEMENT: return "Beam::updatePointedElement";
+		case ProfilerPhase::UPDATE_PROGRESSES: return "Beam::updateProgresses";
+		case ProfilerPhase::INTERACTIONS: return "Accelerator::interactions";
+		case ProfilerPhase::BEAM_STEP: return "Beam::step";
+		case ProfilerPhase::PARTICLE_STEP: return "Particle::step";
+		case ProfilerPhase::CLEAR_DEAD_PARTICLES: return "Beam::clearDeadParticles";
+		case ProfilerPhase::CLEAR_DEAD_BEAMS: return "Accelerator::clearDeadBeams";
+		case ProfilerPhase::REORDER_PARTICLES: return "Accelerator::reorderParticles";
+		default: ERROR(EXCEPTIONS::BAD_RANGE);
+	}
+}
+
+char const* Profiler::getName(ProfilerCounter counter) {
+	switch (counter) {
+		case ProfilerCounter::INTERACTION_PAIRS: return "interaction pairs";
+		case ProfilerCounter::ELEMENT_TRANSITIONS: return "element transitions";
+		case ProfilerCounter::PARTICLES_LOST: return "particles lost";
+		case ProfilerCounter::ARENA_ALLOCATIONS: return "arena allocations";
+		case ProfilerCounter::ARENA_BLOCKS: return "arena blocks";
+		case ProfilerCounter::REJECTED_STEPS: return "rejected steps";
+		default: ERROR(EXCEPTIONS::BAD_RANGE);
+	}
+}
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+void Profiler::record(ProfilerPhase phase, int64_t start, int64_t end) {
+	totalTimes[size_t(phase)] += end - start;
+	++callCounts[size_t(phase)];
+	push(Event({ phase, start, end, {} }));
+}
+
+void Profiler::record(ProfilerPhase phase, int64_t start, int64_t end, PerfSample const& hardware) {
+	for (size_t event(0); event < hardware.size(); ++event) { hardwareCounts[size_t(phase)][event] += hardware[event]; }
+	record(phase, start, end);
+}
+
+bool Profiler::enableHardwareCounters() {
+	if (perfCounters == nullptr) {
+		perfCounters.reset(new PerfCounters());
+		if (not perfCounters->isAvailable()) { perfCounters.reset(); }
+	}
+	return hasHardwareCounters();
+}
+
+void Profiler::disableHardwareCounters() { perfCounters.reset(); }
+
+void Profiler::count(ProfilerCounter counter, uint64_t n) { counts[size_t(counter)] += n; }
+
+void Profiler::sample() {
+	int64_t time(now());
+	push(Event({ ProfilerPhase::COUNT, time, time, counts }));
+}
+
+void Profiler::reset() {
+	totalTimes.fill(0);
+	callCounts.fill(0);
+	counts.fill(0);
+	for (PerfSample & sample : hardwareCounts) { sample.fill(0); }
+	events.clear();
+	nextEvent = 0;
+	droppedEvents = 0;
+}
+
+void Profiler::push(Event const& event) {
+	if (events.size() < GLOBALS::PROFILER_EVENTS) {
+		events.push_back(event);
+	} else {
+		events[nextEvent] = event;
+		++droppedEvents;
+	}
+	nextEvent = (nextEvent + 1) % GLOBALS::PROFILER_EVENTS;
+}
+
+void Profiler::writeTrace(ostream & stream) const {
+	stream << "{\"traceEvents\":[";
+
+	// Oldest event first
+	size_t first(events.size() < GLOBALS::PROFILER_EVENTS ? 0 : nextEvent);
+	for (size_t i(0); i < events.size(); ++i) {
+		Event const& event(events[(first + i) % events.size()]);
+		if (i > 0) { stream << ','; }
+		stream << endl;
+
+		if (event.phase == ProfilerPhase::COUNT) {
+			for (size_t counter(0); counter < event.counts.size(); ++counter) {
+				if (counter > 0) { stream << ',' << endl; }
+				stream << "{\"name\":\"" << getName(ProfilerCounter(counter)) << "\",\"ph\":\"C\",\"ts\":";
+				writeMicroseconds(stream, event.start);
+				stream << ",\"pid\":0,\"tid\":" << threadId << ",\"args\":{\"value\":" << event.counts[counter] << "}}";
+			}
+		} else {
+			stream << "{\"name\":\"" << getName(event.phase) << "\",\"ph\":\"X\",\"ts\":";
+			writeMicroseconds(stream, event.start);
+			stream << ",\"dur\":";
+			writeMicroseconds(stream, event.end - event.start);
+			stream << ",\"pid\":0,\"tid\":" << threadId << "}";
+		}
+	}
+
+	stream << endl << "],\"displayTimeUnit\":\"ns\"}" << endl;
+}
+
+int64_t Profiler::now() {
+	return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - origin).count();
+}
+
+/****************************************************************
+ * Scoped timer
+ ****************************************************************/
+
+ProfilerScope::ProfilerScope(ProfilerPhase phase)
+: profiler(Profiler::local()), phase(phase),
+  hardwareStart(profiler.hasHardwareCounters() ? profiler.getPerfCounters()->read() : PerfSample()),
+  start(Profiler::now())
+{}
+
+ProfilerScope::~ProfilerScope() {
+	int64_t end(Profiler::now());
+	if (profiler.hasHardwareCounters()) {
+		profiler.record(phase, start, end, PerfCounters::difference(hardwareStart, profiler.getPerfCounters()->read()));
+	} else {
+		profiler.record(phase, start, end);
+	}
+}
@@ -20,6 +20,8 @@ Quadrupole::Quadrupole(Vector3D const& posIn, double length, Vector3D direction,
 
 shared_ptr<Element> Quadrupole::copy() const { return cloneThis(); }
 
+Element * Quadrupole::copy(Arena & arena) const { return arena.create<Quadrupole>(*this); }
+
 shared_ptr<Quadrupole> Quadrupole::cloneThis() const {
 	return shared_ptr<Quadrupole>(new Quadrupole(*this));
 }
@@ -42,6 +44,27 @@ Vector3D Quadrupole::getField(Vector3D const& pos, bool methodChapi) const {
 	return b * ((Maurice * u) * e3 + pos.getZ() * u);
 }
 
+void Quadrupole::getFields(vector<Vector3D> const& positions, vector<Vector3D> & fields, bool methodChapi) const {
+	(void) methodChapi;
+	Vector3D d(getPosOut() - getPosIn());
+	~d;
+	Vector3D e3(0, 0, 1);
+	Vector3D u(e3 ^ d);
+
+	fields.resize(positions.size());
+	for (size_t i(0); i < positions.size(); ++i) {
+		Vector3D X(positions[i] - getPosIn());
+		Vector3D y(X - (X * d) * d);
+		fields[i] = b * ((y * u) * e3 + positions[i].getZ() * u);
+	}
+}
+
+/****************************************************************
+ * Getters
+ ****************************************************************/
+
+double Quadrupole::getB() const { return b; }
+
 /****************************************************************
  * Virtual methods
  ****************************************************************/
@@ -0,0 +1,114 @@
+#include "include/bundle/Shard.bundle.h"
+
+using namespace std;
+
+/****************************************************************
+ * Constructors
+ ****************************************************************/
+
+Shard::Shard(Accelerator & acc, Communicator & comm)
+: acc(acc), comm(comm), outgoing(comm.getSize()), ghostCount(0), migrantCount(0)
+{}
+
+/****************************************************************
+ * Getters
+ ****************************************************************/
+
+size_t Shard::getOwner(double progress) const {
+	if (progress <= 0) { return 0; }
+	return min(size_t(progress * comm.getSize()), comm.getSize() - 1);
+}
+
+double Shard::getProgressMin() const { return comm.getRank() / double(comm.getSize()); }
+
+double Shard::getProgressMax() const { return (comm.getRank() + 1) / double(comm.getSize()); }
+
+size_t Shard::getGhostCount() const { return ghostCount; }
+
+size_t Shard::getMigrantCount() const { return migrantCount; }
+
+/****************************************************************
+ * Collective methods
+ ****************************************************************/
+
+void Shard::partition() {
+	size_t rank(comm.getRank());
+
+	acc.updateProgresses();
+	incoming.clear();
+	acc.extractParticles(incoming, [this, rank](ParticleRecord const& record) {
+		return getOwner(record.progress) != rank;
+	});
+	incoming.clear();
+
+	// Nobody starts stepping before every slice is ready
+	comm.barrier();
+}
+
+void Shard::step(double dt) {
+	size_t rank(comm.getRank());
+
+	/* Ghosts */
+
+	for (vector<ParticleRecord> & records : outgoing) { records.clear(); }
+	incoming.clear();
+
+	// The progresses are those of the end of the previous step (or of Shard::partition()),
+	// so the ghosts are in sync with the local Particles
+	acc.exportParticles(incoming, [this, rank](ParticleRecord const& record) {
+		// Interaction range on both sides (the interactions do not wrap around the progress 0)
+		size_t first(getOwner(record.progress - GLOBALS::DELTA_INTERACTION));
+		size_t last(getOwner(record.progress + GLOBALS::DELTA_INTERACTION));
+		return first != rank or last != rank;
+	});
+
+	for (ParticleRecord const& record : incoming) {
+		size_t first(getOwner(record.progress - GLOBALS::DELTA_INTERACTION));
+		size_t last(getOwner(record.progress + GLOBALS::DELTA_INTERACTION));
+		for (size_t worker(first); worker <= last; ++worker) {
+			if (worker != rank) { outgoing[worker].push_back(record); }
+		}
+	}
+
+	incoming.clear();
+	comm.exchange(outgoing, incoming);
+	ghostCount = incoming.size();
+
+	/* Local step */
+
+	acc.exertInteractions(incoming);
+	acc.step(dt);
+
+	/* Migrants */
+
+	for (vector<ParticleRecord> & records : outgoing) { records.clear(); }
+	incoming.clear();
+
+	acc.updateProgresses();
+	acc.extractParticles(incoming, [this, rank](ParticleRecord const& record) {
+		return getOwner(record.progress) != rank;
+	});
+
+	for (ParticleRecord const& record : incoming) {
+		outgoing[getOwner(record.progress)].push_back(record);
+	}
+
+	incoming.clear();
+	comm.exchange(outgoing, incoming);
+	migrantCount = incoming.size();
+	acc.insertParticles(incoming);
+}
+
+size_t Shard::getGlobalParticleCount() {
+	return size_t(llround(comm.sum(acc.getParticleCount())));
+}
+
+vector<ParticleRecord> Shard::gather() {
+	for (vector<ParticleRecord> & records : outgoing) { records.clear(); }
+	acc.updateProgresses();
+	acc.exportParticles(outgoing[0]);
+
+	vector<ParticleRecord> records;
+	comm.exchange(outgoing, records);
+	return records;
+}
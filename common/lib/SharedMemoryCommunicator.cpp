@@ -0,0 +1,173 @@
+#include "include/bundle/SharedMemoryCommunicator.bundle.h"
+
+using namespace std;
+
+namespace {
+	// Keeps the values and the mailboxes on their own cache lines
+	size_t const HEADER_SIZE(64);
+
+	size_t alignedSize(size_t bytes) { return (bytes + HEADER_SIZE - 1) / HEADER_SIZE * HEADER_SIZE; }
+}
+
+/****************************************************************
+ * Constructors and destructors
+ ****************************************************************/
+
+SharedMemoryCommunicator::SharedMemoryCommunicator(size_t workerCount, size_t capacity)
+: size(workerCount > 0 ? workerCount : 1), capacity(capacity), rank(0), localSense(0), mappingSize(0), mapping(nullptr), header(nullptr)
+{
+	mappingSize = HEADER_SIZE
+		+ alignedSize(size * sizeof(double))
+		+ size * size * alignedSize(sizeof(uint64_t) + capacity * sizeof(ParticleRecord));
+
+	void * address(mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+	if (address == MAP_FAILED) { ERROR(EXCEPTIONS::SHARED_MEMORY_FAILED); }
+
+	// Anonymous mappings are zero-filled: the counts are already 0
+	mapping = static_cast<char *>(address);
+	header = new (mapping) Header();
+	header->arrived.store(0);
+	header->sense.store(0);
+	header->failed.store(0);
+}
+
+SharedMemoryCommunicator::~SharedMemoryCommunicator() {
+	header->~Header();
+	munmap(mapping, mappingSize);
+}
+
+/****************************************************************
+ * Getters
+ ****************************************************************/
+
+size_t SharedMemoryCommunicator::getRank() const { return rank; }
+
+size_t SharedMemoryCommunicator::getSize() const { return size; }
+
+double * SharedMemoryCommunicator::getValues() const {
+	return reinterpret_cast<double *>(mapping + HEADER_SIZE);
+}
+
+uint64_t & SharedMemoryCommunicator::getCount(size_t sender, size_t receiver) const {
+	size_t mailboxSize(alignedSize(sizeof(uint64_t) + capacity * sizeof(ParticleRecord)));
+	char * mailbox(mapping + HEADER_SIZE + alignedSize(size * sizeof(double)) + (sender * size + receiver) * mailboxSize);
+	return *reinterpret_cast<uint64_t *>(mailbox);
+}
+
+ParticleRecord * SharedMemoryCommunicator::getRecords(size_t sender, size_t receiver) const {
+	return reinterpret_cast<ParticleRecord *>(&getCount(sender, receiver) + 1);
+}
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+bool SharedMemoryCommunicator::run(function<void(Communicator &)> const& worker) {
+	vector<pid_t> children;
+
+	for (size_t i(1); i < size; ++i) {
+		pid_t pid(fork());
+
+		if (pid < 0) {
+			// The workers already started would wait for this one forever
+			header->failed.store(1);
+			for (pid_t child : children) { waitpid(child, nullptr, 0); }
+			ERROR(EXCEPTIONS::FORK_FAILED);
+		}
+
+		if (pid == 0) {
+			rank = i;
+			int status(0);
+			try {
+				worker(*this);
+			} catch (exception const& e) {
+				header->failed.store(1);
+				cerr << "Worker " << rank << ": " << e.what() << endl;
+				status = 1;
+			}
+			// Leave without running the destructors of the copy of the parent
+			cout.flush();
+			cerr.flush();
+			_exit(status);
+		}
+
+		children.push_back(pid);
+	}
+
+	rank = 0;
+	exception_ptr error;
+	try {
+		worker(*this);
+	} catch (...) {
+		header->failed.store(1);
+		error = current_exception();
+	}
+
+	bool success(true);
+	for (pid_t child : children) {
+		int status(0);
+		waitpid(child, &status, 0);
+		if (not WIFEXITED(status) or WEXITSTATUS(status) != 0) { success = false; }
+	}
+
+	if (error) { rethrow_exception(error); }
+	return success;
+}
+
+void SharedMemoryCommunicator::fail(char const* message) {
+	header->failed.store(1);
+	ERROR(message);
+}
+
+/****************************************************************
+ * Collective operations
+ ****************************************************************/
+
+void SharedMemoryCommunicator::barrier() {
+	localSense = 1 - localSense;
+
+	if (header->arrived.fetch_add(1) + 1 == int(size)) {
+		// Last one: release the others
+		header->arrived.store(0);
+		header->sense.store(localSense);
+	} else {
+		while (header->sense.load() != localSense) {
+			if (header->failed.load() != 0) { ERROR(EXCEPTIONS::WORKER_FAILED); }
+			this_thread::yield();
+		}
+	}
+}
+
+void SharedMemoryCommunicator::exchange(vector<vector<ParticleRecord>> const& outgoing, vector<ParticleRecord> & incoming) {
+	if (outgoing.size() != size) { fail(EXCEPTIONS::BAD_EXCHANGE); }
+
+	for (size_t receiver(0); receiver < size; ++receiver) {
+		vector<ParticleRecord> const& records(outgoing[receiver]);
+		if (records.size() > capacity) { fail(EXCEPTIONS::MAILBOX_OVERFLOW); }
+
+		if (not records.empty()) { memcpy(getRecords(rank, receiver), records.data(), records.size() * sizeof(ParticleRecord)); }
+		getCount(rank, receiver) = records.size();
+	}
+
+	// Every mailbox of this worker is filled
+	barrier();
+
+	for (size_t sender(0); sender < size; ++sender) {
+		ParticleRecord const* records(getRecords(sender, rank));
+		incoming.insert(incoming.end(), records, records + getCount(sender, rank));
+	}
+
+	// Every mailbox is read, they can be filled again
+	barrier();
+}
+
+double SharedMemoryCommunicator::sum(double value) {
+	getValues()[rank] = value;
+	barrier();
+
+	double total(0);
+	for (size_t i(0); i < size; ++i) { total += getValues()[i]; }
+
+	barrier();
+	return total;
+}
@@ -0,0 +1,132 @@
+#include "include/bundle/StepScheduler.bundle.h"
+
+using namespace std;
+
+/****************************************************************
+ * Constructors
+ ****************************************************************/
+
+StepScheduler::StepScheduler(SteppingMode mode, double stepsPerFrame, double budget, double targetRate)
+: mode(mode), stepsPerFrame(0), budget(0), targetRate(0), owedSteps(0), started(false), simulatedTime(0), stepCount(0)
+{
+	setStepsPerFrame(stepsPerFrame);
+	setBudget(budget);
+	setTargetRate(targetRate);
+}
+
+/****************************************************************
+ * Getters
+ ****************************************************************/
+
+SteppingMode StepScheduler::getMode() const { return mode; }
+
+double StepScheduler::getStepsPerFrame() const { return stepsPerFrame; }
+
+double StepScheduler::getBudget() const { return budget; }
+
+double StepScheduler::getTargetRate() const { return targetRate; }
+
+double StepScheduler::getSimulatedTime() const { return simulatedTime; }
+
+uint64_t StepScheduler::getStepCount() const { return stepCount; }
+
+char const* StepScheduler::getName(SteppingMode mode) {
+	switch (mode) {
+		case SteppingMode::FIXED: return "fixed";
+		case SteppingMode::BUDGET: return "budget";
+		case SteppingMode::RATE: return "rate";
+	}
+	return "";
+}
+
+/****************************************************************
+ * Setters
+ ****************************************************************/
+
+void StepScheduler::setMode(SteppingMode mode) {
+	this->mode = mode;
+	owedSteps = 0;
+	started = false;
+}
+
+void StepScheduler::nextMode() {
+	switch (mode) {
+		case SteppingMode::FIXED: setMode(SteppingMode::BUDGET); break;
+		case SteppingMode::BUDGET: setMode(SteppingMode::RATE); break;
+		case SteppingMode::RATE: setMode(SteppingMode::FIXED); break;
+	}
+}
+
+void StepScheduler::setStepsPerFrame(double stepsPerFrame) {
+	if (stepsPerFrame < 0) { ERROR(EXCEPTIONS::BAD_SCHEDULE); }
+	this->stepsPerFrame = stepsPerFrame;
+}
+
+void StepScheduler::setBudget(double budget) {
+	if (budget < 0) { ERROR(EXCEPTIONS::BAD_SCHEDULE); }
+	this->budget = budget;
+}
+
+void StepScheduler::setTargetRate(double targetRate) {
+	if (targetRate < 0) { ERROR(EXCEPTIONS::BAD_SCHEDULE); }
+	this->targetRate = targetRate;
+}
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+size_t StepScheduler::advance(Accelerator & acc, double dt) {
+	chrono::steady_clock::time_point now(chrono::steady_clock::now());
+	double elapsed(started ? chrono::duration<double>(now - previousFrame).count() : 0);
+	previousFrame = now;
+	started = true;
+
+	return advance(acc, dt, elapsed);
+}
+
+size_t StepScheduler::advance(Accelerator & acc, double dt, double elapsed) {
+	size_t steps(0);
+
+	switch (mode) {
+		case SteppingMode::FIXED:
+			owedSteps += stepsPerFrame;
+			steps = size_t(owedSteps);
+			owedSteps -= steps;
+			for (size_t i(0); i < steps; ++i) { acc.step(dt); }
+			break;
+
+		case SteppingMode::BUDGET:
+			steps = stepWithinBudget(acc, dt, numeric_limits<double>::infinity());
+			break;
+
+		case SteppingMode::RATE:
+			owedSteps += targetRate * elapsed;
+			steps = stepWithinBudget(acc, dt, floor(owedSteps));
+			owedSteps -= steps;
+			// The steps which did not fit in the budget are dropped, otherwise a slow frame would make the next ones slower
+			if (owedSteps >= 1) { owedSteps -= floor(owedSteps); }
+			break;
+	}
+
+	simulatedTime += steps * dt;
+	stepCount += steps;
+
+	return steps;
+}
+
+/****************************************************************
+ * Private methods
+ ****************************************************************/
+
+size_t StepScheduler::stepWithinBudget(Accelerator & acc, double dt, double maxSteps) {
+	chrono::steady_clock::time_point deadline(chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(budget)));
+
+	size_t steps(0);
+	while (steps < maxSteps and chrono::steady_clock::now() < deadline) {
+		acc.step(dt);
+		++steps;
+	}
+
+	return steps;
+}
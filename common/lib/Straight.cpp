@@ -20,6 +20,8 @@ Straight::Straight(Vector3D const& posIn, double length, Vector3D direction, dou
 
 shared_ptr<Element> Straight::copy() const { return cloneThis(); }
 
+Element * Straight::copy(Arena & arena) const { return arena.create<Straight>(*this); }
+
 shared_ptr<Straight> Straight::cloneThis() const {
 	return shared_ptr<Straight>(new Straight(*this));
 }
@@ -35,6 +37,11 @@ Vector3D Straight::getField(Vector3D const& pos, bool methodChapi) const {
 	return Vector3D(0, 0, 0);
 }
 
+void Straight::getFields(vector<Vector3D> const& positions, vector<Vector3D> & fields, bool methodChapi) const {
+	(void) methodChapi;
+	fields.assign(positions.size(), Vector3D(0, 0, 0));
+}
+
 Vector3D const Straight::getNormalDirection(Vector3D const& pos) const {
 	// We don't use pos in this overidden function
 	(void) pos;
@@ -88,8 +95,8 @@ Vector3D Straight::getVelAtProgress(double progress, bool clockwise) const {
  * Virtual methods
  ****************************************************************/
 
-bool Straight::isInWall(Particle const& p) const {
-	Vector3D X(p.getPos() - getPosIn());
+bool Straight::isInWall(Vector3D const& pos) const {
+	Vector3D X(pos - getPosIn());
 	Vector3D d(getPosOut() - getPosIn());
 	~d;
 	return ((X - (X * d) * d).norm() > getRadius());
@@ -0,0 +1,190 @@
+#include "include/bundle/Sweep.bundle.h"
+
+using namespace std;
+
+/****************************************************************
+ * SweepResult
+ ****************************************************************/
+
+string const SweepResult::header() {
+	return "index,b,straightLength,B,energy,initialParticles,finalParticles,survival,emittanceGrowthR,emittanceGrowthZ,steps,terminatedEarly,wallTime,error";
+}
+
+string const SweepResult::to_string() const {
+	stringstream stream;
+	stream << setprecision(STYLES::PRECISION);
+	stream
+		<< index << ','
+		<< point.b << ','
+		<< point.straightLength << ','
+		<< point.B << ','
+		<< point.energy << ','
+		<< initialParticles << ','
+		<< finalParticles << ','
+		<< survival << ','
+		<< emittanceGrowthR << ','
+		<< emittanceGrowthZ << ','
+		<< steps << ','
+		<< terminatedEarly << ','
+		<< wallTime << ','
+		<< '"' << error << '"';
+	return stream.str();
+}
+
+ostream& operator << (ostream& stream, SweepResult const& result) {
+	return stream << result.to_string();
+}
+
+/****************************************************************
+ * Constructors
+ ****************************************************************/
+
+Sweep::Sweep(LatticeTemplate & lattice, size_t steps, ThreadPool & pool, double dt)
+: lattice(lattice), steps(steps), pool(pool), dt(dt)
+{
+	// Compile once here, so that the runs only read the template
+	if (not lattice.isCompiled()) { lattice.compile(); }
+}
+
+/****************************************************************
+ * Sampling
+ ****************************************************************/
+
+namespace {
+	// Values of a range, evenly spaced
+	vector<double> rangeValues(SweepRange const& range) {
+		if (range.count == 0 or range.min > range.max) { ERROR(EXCEPTIONS::BAD_RANGE); }
+
+		vector<double> values;
+		for (size_t i(0); i < range.count; ++i) {
+			if (range.count == 1) { values.push_back(range.min); }
+			else { values.push_back(range.min + (range.max - range.min) * i / double(range.count - 1)); }
+		}
+		return values;
+	}
+
+	// Parameters of a point seen as an array, to loop over them
+	double& parameter(SweepPoint & point, size_t i) {
+		switch (i) {
+			case 0: return point.b;
+			case 1: return point.straightLength;
+			case 2: return point.B;
+			default: return point.energy;
+		}
+	}
+
+	double parameter(SweepPoint const& point, size_t i) {
+		return parameter(const_cast<SweepPoint &>(point), i);
+	}
+
+	size_t const PARAMETER_COUNT(4);
+}
+
+vector<SweepPoint> Sweep::grid(SweepRange const& b, SweepRange const& straightLength, SweepRange const& B, SweepRange const& energy) {
+	vector<SweepPoint> points;
+	for (double vb : rangeValues(b)) {
+		for (double vStraightLength : rangeValues(straightLength)) {
+			for (double vB : rangeValues(B)) {
+				for (double vEnergy : rangeValues(energy)) {
+					points.push_back(SweepPoint{ vb, vStraightLength, vB, vEnergy });
+				}
+			}
+		}
+	}
+	return points;
+}
+
+vector<SweepPoint> Sweep::random(SweepPoint const& min, SweepPoint const& max, size_t count, unsigned int seed) {
+	mt19937_64 generator(seed);
+	uniform_real_distribution<double> uniform(0, 1);
+
+	vector<SweepPoint> points(count, min);
+	for (SweepPoint & point : points) {
+		for (size_t i(0); i < PARAMETER_COUNT; ++i) {
+			parameter(point, i) += uniform(generator) * (parameter(max, i) - parameter(min, i));
+		}
+	}
+	return points;
+}
+
+vector<SweepPoint> Sweep::latinHypercube(SweepPoint const& min, SweepPoint const& max, size_t count, unsigned int seed) {
+	mt19937_64 generator(seed);
+	uniform_real_distribution<double> uniform(0, 1);
+
+	vector<SweepPoint> points(count, min);
+	vector<size_t> strata(count);
+	for (size_t i(0); i < PARAMETER_COUNT; ++i) {
+		// Each parameter visits its strata in its own random order
+		iota(strata.begin(), strata.end(), 0);
+		shuffle(strata.begin(), strata.end(), generator);
+
+		for (size_t j(0); j < count; ++j) {
+			double u((strata[j] + uniform(generator)) / count);
+			parameter(points[j], i) += u * (parameter(max, i) - parameter(min, i));
+		}
+	}
+	return points;
+}
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+vector<SweepResult> Sweep::run(vector<SweepPoint> const& points, ostream * summary) const {
+	vector<SweepResult> results(points.size());
+	mutex summaryMutex;
+
+	if (summary != nullptr) { *summary << SweepResult::header() << '\n'; }
+
+	// Only the points of this run are waited for, the pool may be running other work
+	ThreadPool::Batch batch;
+	for (size_t i(0); i < points.size(); ++i) {
+		pool.submit(batch, [this, &points, &results, &summaryMutex, summary, i] {
+			// Each task only writes its own slot
+			results[i] = runPoint(points[i], i);
+
+			if (summary != nullptr) {
+				lock_guard<mutex> lock(summaryMutex);
+				*summary << results[i] << '\n';
+			}
+		});
+	}
+	pool.wait(batch);
+
+	if (summary != nullptr) { summary->flush(); }
+	return results;
+}
+
+SweepResult Sweep::runPoint(SweepPoint const& point, size_t index) const {
+	SweepResult result{ index, point, 0, 0, 0, 0, 0, 0, false, 0, "" };
+	chrono::steady_clock::time_point start(chrono::steady_clock::now());
+
+	try {
+		unique_ptr<Accelerator> acc(lattice.instantiate(point));
+
+		result.initialParticles = acc->getParticleCount();
+		double emittanceR(acc->getMeanEmittanceR());
+		double emittanceZ(acc->getMeanEmittanceZ());
+
+		while (result.steps < steps) {
+			// Early termination: nothing left to simulate
+			if (acc->getParticleCount() == 0) {
+				result.terminatedEarly = true;
+				break;
+			}
+			acc->step(dt);
+			++result.steps;
+		}
+
+		result.finalParticles = acc->getParticleCount();
+		if (result.initialParticles > 0) { result.survival = result.finalParticles / double(result.initialParticles); }
+		if (emittanceR > GLOBALS::DELTA_DIV0) { result.emittanceGrowthR = acc->getMeanEmittanceR() / emittanceR; }
+		if (emittanceZ > GLOBALS::DELTA_DIV0) { result.emittanceGrowthZ = acc->getMeanEmittanceZ() / emittanceZ; }
+	} catch (OurException & e) {
+		// An invalid point must not stop the other runs
+		result.error = e.error();
+	}
+
+	result.wallTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	return result;
+}
@@ -3,3 +3,23 @@
 bool Test::eq(double x, double y, double epsilon) {
 	return (abs(x - y) <= epsilon);
 }
+
+void Test::makeRing(Accelerator & acc, bool frodos) {
+	Vector3D pos_dep(3, 2, 0);
+	Vector3D dir_straight(0, -1, 0);
+	Vector3D pos_fin;
+	Vector3D dir_dipole(-1, -1, 0);
+
+	for (int i = 0; i < 4; ++i) {
+		pos_fin = pos_dep + 4 * dir_straight;
+		if (frodos) { acc.addElement(Frodo(pos_dep, pos_fin, 0.1, 1.2, 1)); }
+		else { acc.addElement(Straight(pos_dep, pos_fin, 0.1)); }
+		pos_dep = pos_fin;
+		pos_fin += dir_dipole;
+		acc.addElement(Dipole(pos_dep, pos_fin, 0.1, 1, 5.89158));
+		pos_dep = pos_fin;
+		dir_straight ^= Vector3D(0, 0, 1);
+		dir_dipole ^= Vector3D(0, 0, 1);
+	}
+	acc.closeElementLoop();
+}
@@ -2,27 +2,62 @@
 
 using namespace std;
 
+namespace {
+	// Longest number written by std::to_chars for a double, with room to spare
+	size_t const NUMBER_SIZE(32);
+
+	char const* kindName(ParticleKind kind) {
+		switch (kind) {
+			case ParticleKind::PROTON: return "proton";
+			case ParticleKind::ANTIPROTON: return "antiproton";
+			case ParticleKind::ELECTRON: return "electron";
+			default: return "particle";
+		}
+	}
+}
+
 /****************************************************************
  * Constructors and destructors
  ****************************************************************/
 
-TextRenderer::TextRenderer(ostream * stream_ptr)
-: stream_ptr(stream_ptr)
-{}
+TextRenderer::TextRenderer(ostream * stream_ptr, TextFormat format)
+: stream_ptr(stream_ptr), format(format), used(0)
+{
+	if (format != TextFormat::HUMAN) { buffer.resize(GLOBALS::TEXT_BUFFER); }
+}
 
-TextRenderer::TextRenderer(string const& fileName) {
+TextRenderer::TextRenderer(string const& fileName, TextFormat format)
+: format(format), used(0)
+{
 	fileStream = ofstream(fileName);
 	if (fileStream.fail()) ERROR(EXCEPTIONS::FILE_EXCEPTION);
 	stream_ptr = &fileStream;
+	if (format != TextFormat::HUMAN) { buffer.resize(GLOBALS::TEXT_BUFFER); }
 }
 
 TextRenderer::~TextRenderer() {
+	writeBuffer();
 	fileStream.close();
 	// we do not delete stream_ptr because it does not belong to us
 	// and in the case where we initialized it, fileStream is a normal attribute,
 	// so the destructor is called automatically
 }
 
+/****************************************************************
+ * Getters
+ ****************************************************************/
+
+TextFormat TextRenderer::getFormat() const { return format; }
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+void TextRenderer::flush() {
+	writeBuffer();
+	stream_ptr->flush();
+}
+
 /****************************************************************
  * Drawing
  ****************************************************************/
@@ -32,7 +67,22 @@ TextRenderer::~TextRenderer() {
  */
 
 void TextRenderer::draw(Beam const& beam) {
-	*stream_ptr << beam;
+	if (format == TextFormat::HUMAN) {
+		*stream_ptr << beam;
+		return;
+	}
+
+	beginRecord("beam");
+	field("particles", beam.getParticleCount());
+	field("meanEnergy", beam.getMeanEnergy());
+	field("emittanceR", beam.getEmittanceR());
+	field("emittanceZ", beam.getEmittanceZ());
+	field("charge", beam.getCharge());
+	endRecord();
+
+	for (size_t part(0); part < beam.getParticleCount(); ++part) {
+		writeParticle(beam.getRecord(part));
+	}
 }
 
 /**
@@ -40,7 +90,19 @@ void TextRenderer::draw(Beam const& beam) {
  */
 
 void TextRenderer::draw(Accelerator const& acc) {
-	*stream_ptr << acc;
+	if (format == TextFormat::HUMAN) {
+		*stream_ptr << acc;
+		return;
+	}
+
+	beginRecord("accelerator");
+	field("beams", acc.getBeamCount());
+	field("particles", acc.getParticleCount());
+	endRecord();
+
+	// Through this renderer, whatever the renderer of the Accelerator
+	acc.drawElements(this);
+	acc.drawBeams(this);
 }
 
 /**
@@ -48,7 +110,16 @@ void TextRenderer::draw(Accelerator const& acc) {
  */
 
 void TextRenderer::draw(Dipole const& dipole) {
-	*stream_ptr << dipole;
+	if (format == TextFormat::HUMAN) {
+		*stream_ptr << dipole;
+		return;
+	}
+
+	beginRecord("dipole");
+	elementFields(dipole);
+	field("curvature", dipole.getCurvature());
+	field("B", dipole.getB());
+	endRecord();
 }
 
 /**
@@ -56,7 +127,15 @@ void TextRenderer::draw(Dipole const& dipole) {
  */
 
 void TextRenderer::draw(Quadrupole const& quadrupole) {
-	*stream_ptr << quadrupole;
+	if (format == TextFormat::HUMAN) {
+		*stream_ptr << quadrupole;
+		return;
+	}
+
+	beginRecord("quadrupole");
+	elementFields(quadrupole);
+	field("b", quadrupole.getB());
+	endRecord();
 }
 
 /**
@@ -64,7 +143,14 @@ void TextRenderer::draw(Quadrupole const& quadrupole) {
  */
 
 void TextRenderer::draw(Straight const& straight) {
-	*stream_ptr << straight;
+	if (format == TextFormat::HUMAN) {
+		*stream_ptr << straight;
+		return;
+	}
+
+	beginRecord("straight");
+	elementFields(straight);
+	endRecord();
 }
 
 /**
@@ -72,7 +158,16 @@ void TextRenderer::draw(Straight const& straight) {
  */
 
 void TextRenderer::draw(Frodo const& frodo) {
-	*stream_ptr << frodo;
+	if (format == TextFormat::HUMAN) {
+		*stream_ptr << frodo;
+		return;
+	}
+
+	beginRecord("frodo");
+	elementFields(frodo);
+	field("b", frodo.getB());
+	field("straightLength", frodo.getStraightLength());
+	endRecord();
 }
 
 /**
@@ -80,7 +175,12 @@ void TextRenderer::draw(Frodo const& frodo) {
  */
 
 void TextRenderer::draw(Particle const& particle) {
-	*stream_ptr << particle;
+	if (format == TextFormat::HUMAN) {
+		*stream_ptr << particle;
+		return;
+	}
+
+	writeParticle(particle.toRecord());
 }
 
 /**
@@ -88,7 +188,7 @@ void TextRenderer::draw(Particle const& particle) {
  */
 
 void TextRenderer::draw(Proton const& proton) {
-	draw(proton);
+	draw(static_cast<Particle const&>(proton));
 }
 
 /**
@@ -96,7 +196,7 @@ void TextRenderer::draw(Proton const& proton) {
  */
 
 void TextRenderer::draw(AntiProton const& antiproton) {
-	draw(antiproton);
+	draw(static_cast<Particle const&>(antiproton));
 }
 
 /**
@@ -104,7 +204,7 @@ void TextRenderer::draw(AntiProton const& antiproton) {
  */
 
 void TextRenderer::draw(Electron const& electron) {
-	draw(electron);
+	draw(static_cast<Particle const&>(electron));
 }
 
 /**
@@ -112,7 +212,123 @@ void TextRenderer::draw(Electron const& electron) {
  */
 
 void TextRenderer::draw(Vector3D const& vec) {
-	*stream_ptr << vec;
+	if (format == TextFormat::HUMAN) {
+		*stream_ptr << vec;
+		return;
+	}
+
+	beginRecord("vector");
+	field("x", vec.getX());
+	field("y", vec.getY());
+	field("z", vec.getZ());
+	endRecord();
+}
+
+/****************************************************************
+ * Private methods (machine-oriented formats)
+ ****************************************************************/
+
+void TextRenderer::beginRecord(char const* type) {
+	if (format == TextFormat::CSV) {
+		write(type);
+	} else {
+		write("{\"type\":\"");
+		write(type);
+		write("\"");
+	}
+}
+
+void TextRenderer::field(char const* name, double value) {
+	if (format == TextFormat::JSONL) {
+		write(",\"");
+		write(name);
+		write("\":");
+		// JSON has no infinities
+		if (not isfinite(value)) {
+			write("null");
+			return;
+		}
+	} else {
+		write(",");
+	}
+
+	reserve(NUMBER_SIZE);
+	to_chars_result result(to_chars(buffer.data() + used, buffer.data() + buffer.size(), value));
+	used = size_t(result.ptr - buffer.data());
+}
+
+void TextRenderer::field(char const* name, char const* value) {
+	if (format == TextFormat::JSONL) {
+		write(",\"");
+		write(name);
+		write("\":\"");
+		write(value);
+		write("\"");
+	} else {
+		write(",");
+		write(value);
+	}
+}
+
+void TextRenderer::field(char const* name) {
+	if (format == TextFormat::JSONL) {
+		write(",\"");
+		write(name);
+		write("\":null");
+	} else {
+		write(",");
+	}
+}
+
+void TextRenderer::elementFields(Element const& element) {
+	Vector3D posIn(element.getPosIn()), posOut(element.getPosOut());
+	if (element.isLinked()) { field("index", element.getIndex()); }
+	else { field("index"); }
+	field("xIn", posIn.getX());
+	field("yIn", posIn.getY());
+	field("zIn", posIn.getZ());
+	field("xOut", posOut.getX());
+	field("yOut", posOut.getY());
+	field("zOut", posOut.getZ());
+	field("radius", element.getRadius());
+}
+
+void TextRenderer::endRecord() {
+	write(format == TextFormat::JSONL ? "}\n" : "\n");
+}
+
+void TextRenderer::writeParticle(ParticleRecord const& record) {
+	beginRecord("particle");
+	field("kind", kindName(record.kind));
+	field("x", record.pos[0]);
+	field("y", record.pos[1]);
+	field("z", record.pos[2]);
+	field("px", record.momentum[0]);
+	field("py", record.momentum[1]);
+	field("pz", record.momentum[2]);
+	field("mass", record.mass);
+	field("charge", record.charge);
+	endRecord();
+}
+
+void TextRenderer::write(char const* text) {
+	size_t size(strlen(text));
+	reserve(size);
+	memcpy(buffer.data() + used, text, size);
+	used += size;
+}
+
+void TextRenderer::reserve(size_t size) {
+	if (used + size <= buffer.size()) { return; }
+	writeBuffer();
+	// Only the names are written with TextRenderer::write(), they are much shorter than the buffer
+	if (size > buffer.size()) { buffer.resize(size); }
+}
+
+void TextRenderer::writeBuffer() {
+	if (used == 0) { return; }
+	stream_ptr->write(buffer.data(), streamsize(used));
+	used = 0;
 }
 
 // that's all folks !
@@ -0,0 +1,119 @@
+#include "include/bundle/ThreadPool.bundle.h"
+
+using namespace std;
+
+/****************************************************************
+ * Constructors and destructors
+ ****************************************************************/
+
+ThreadPool::Batch::Batch() : pending(0) {}
+
+ThreadPool::ThreadPool(size_t threadCount)
+: stopping(false)
+{
+	if (threadCount == 0) { threadCount = thread::hardware_concurrency(); }
+	// hardware_concurrency() may not be computable
+	if (threadCount == 0) { threadCount = 1; }
+
+	for (size_t i(0); i < threadCount; ++i) {
+		workers.push_back(thread(&ThreadPool::work, this));
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	taskAvailable.notify_all();
+	for (thread & worker : workers) { worker.join(); }
+}
+
+/****************************************************************
+ * Getters
+ ****************************************************************/
+
+size_t ThreadPool::getThreadCount() const { return workers.size(); }
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+void ThreadPool::submit(Batch & batch, function<void()> task) {
+	{
+		lock_guard<std::mutex> lock(mutex);
+		tasks.push_back(Task{ move(task), &batch });
+		++batch.pending;
+	}
+	taskAvailable.notify_one();
+}
+
+void ThreadPool::wait(Batch & batch) {
+	unique_lock<std::mutex> lock(mutex);
+
+	while (batch.pending > 0) {
+		// The queued tasks of the Batch are run here rather than waiting for a worker, which may all be busy waiting too
+		deque<Task>::iterator next(find_if(tasks.begin(), tasks.end(), [&batch](Task const& task) { return task.batch_ptr == &batch; }));
+		if (next != tasks.end()) {
+			Task task(move(*next));
+			tasks.erase(next);
+			run(task, lock);
+		} else {
+			batchDone.wait(lock);
+		}
+	}
+
+	if (batch.error) {
+		exception_ptr first(batch.error);
+		batch.error = nullptr;
+		rethrow_exception(first);
+	}
+}
+
+void ThreadPool::parallelFor(size_t begin, size_t end, function<void(size_t, size_t)> const& body) {
+	if (end <= begin) { return; }
+
+	// Small ranges are not worth the synchronization
+	if (end - begin <= GLOBALS::PARALLEL_GRAIN) {
+		body(begin, end);
+		return;
+	}
+
+	Batch batch;
+	for (size_t chunk(begin); chunk < end; chunk += GLOBALS::PARALLEL_GRAIN) {
+		size_t chunkEnd(min(end, chunk + GLOBALS::PARALLEL_GRAIN));
+		submit(batch, [&body, chunk, chunkEnd] { body(chunk, chunkEnd); });
+	}
+	wait(batch);
+}
+
+/****************************************************************
+ * Private methods
+ ****************************************************************/
+
+void ThreadPool::work() {
+	unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		taskAvailable.wait(lock, [this] { return stopping or not tasks.empty(); });
+		if (tasks.empty()) { return; }	// stopping and nothing left to do
+
+		Task task(move(tasks.front()));
+		tasks.pop_front();
+		run(task, lock);
+	}
+}
+
+void ThreadPool::run(Task & task, unique_lock<std::mutex> & lock) {
+	lock.unlock();
+	exception_ptr error;
+	try {
+		task.run();
+	} catch (...) {
+		error = current_exception();
+	}
+	lock.lock();
+
+	Batch & batch(*task.batch_ptr);
+	if (error and not batch.error) { batch.error = error; }
+	if (--batch.pending == 0) { batchDone.notify_all(); }
+}
@@ -0,0 +1,121 @@
+#include "include/bundle/TrailHistory.bundle.h"
+
+using namespace std;
+
+/****************************************************************
+ * Constructors
+ ****************************************************************/
+
+TrailHistory::TrailHistory(size_t length)
+: length(0), particleCount(0), head(0), recorded(false)
+{
+	setLength(length);
+}
+
+/****************************************************************
+ * Getters
+ ****************************************************************/
+
+size_t TrailHistory::getLength() const { return length; }
+
+size_t TrailHistory::getParticleCount() const { return particleCount; }
+
+size_t TrailHistory::getHead() const { return head; }
+
+vector<float> const& TrailHistory::getPositions() const { return positions; }
+
+vector<uint32_t> const& TrailHistory::getIndices() const { return indices; }
+
+size_t TrailHistory::getFirstIndex() const {
+	// The segment from the newest slot to the oldest one is skipped
+	return (head + 1) * 2 * particleCount;
+}
+
+size_t TrailHistory::getIndexCount() const {
+	if (length < 2) { return 0; }
+	return (length - 1) * 2 * particleCount;
+}
+
+/****************************************************************
+ * Setters
+ ****************************************************************/
+
+void TrailHistory::setLength(size_t length) {
+	if (length > GRAPHICS::TRAIL_MAX_LENGTH) { ERROR(EXCEPTIONS::BAD_TRAIL_LENGTH); }
+	this->length = length;
+	recorded = false;
+}
+
+/****************************************************************
+ * Methods
+ ****************************************************************/
+
+bool TrailHistory::record(Accelerator const& acc) {
+	if (length == 0) { return false; }
+
+	next.clear();
+	nextIds.clear();
+	for (size_t beam(0); beam < acc.getBeamCount(); ++beam) {
+		Beam const& current(acc.getBeam(beam));
+		uint64_t beamId(acc.getBeamId(beam));
+		for (size_t part(0); part < current.getParticleCount(); ++part) {
+			Vector3D pos(current.getPos(part));
+			next.push_back(float(pos.getX()));
+			next.push_back(float(pos.getY()));
+			next.push_back(float(pos.getZ()));
+			nextIds.push_back(beamId << 32 | current.getParticleId(part));
+		}
+	}
+
+	// The same particles in another order
+	if (recorded and nextIds != ids and nextIds.size() == ids.size() and matchSlots()) { nextIds = ids; }
+
+	if (recorded and next == positions) { return false; }
+	positions.swap(next);
+
+	// The particles cannot be matched with the previous slots anymore
+	if (not recorded or nextIds != ids) {
+		ids = nextIds;
+		particleCount = positions.size() / 3;
+		head = 0;
+		recorded = true;
+		buildIndices();
+		return true;
+	}
+
+	head = (head + 1) % length;
+	return false;
+}
+
+/****************************************************************
+ * Private methods
+ ****************************************************************/
+
+bool TrailHistory::matchSlots() {
+	slots.clear();
+	for (size_t slot(0); slot < ids.size(); ++slot) { slots[ids[slot]] = slot; }
+
+	matched.resize(next.size());
+	for (size_t part(0); part < nextIds.size(); ++part) {
+		unordered_map<uint64_t, size_t>::const_iterator found(slots.find(nextIds[part]));
+		if (found == slots.end()) { return false; }
+		copy(next.begin() + 3 * part, next.begin() + 3 * part + 3, matched.begin() + 3 * found->second);
+	}
+
+	next.swap(matched);
+	return true;
+}
+
+void TrailHistory::buildIndices() {
+	indices.clear();
+	indices.reserve(2 * length * 2 * particleCount);
+
+	// Segment s joins the slots s and s + 1 (modulo the length), the ring being written twice
+	for (size_t segment(0); segment < 2 * length; ++segment) {
+		size_t from(segment % length), to((segment + 1) % length);
+		for (size_t part(0); part < particleCount; ++part) {
+			indices.push_back(uint32_t(from * particleCount + part));
+			indices.push_back(uint32_t(to * particleCount + part));
+		}
+	}
+}
@@ -4,7 +4,7 @@
  * General stuffs
  ****************************************************************/
 
-Window::Window() : focus(true), pause(false), acc(&engine, true, false), frames(0), engineSpeed(1) {
+Window::Window(std::string const& latticeFile) : focus(true), pause(false), acc(&engine, true, false), frames(0), simulatedTime(0), showPhaseSpace(false), showLossMap(false) {
 	// Cursor
 	QCursor c;
 	c.setPos(mapToGlobal(QPoint(width() / 2, height() / 2)));
@@ -12,6 +12,19 @@ Window::Window() : focus(true), pause(false), acc(&engine, true, false), frames(
 	Input::resetMouseDelta();
 
 	// Accelerator initialization
+	if (latticeFile.empty()) {
+		buildDefaultLattice();
+	} else {
+		// The Frodos are expanded into their sections as they are added
+		acc.flattenElements();
+		Lattice::load(latticeFile).build(acc, &engine);
+	}
+
+	// Timer
+	timer.start();
+}
+
+void Window::buildDefaultLattice() {
 	Vector3D pos_dep(3, 2, 0);
 	Vector3D dir_frodo(0, -1, 0);
 	Vector3D pos_fin;
@@ -45,6 +58,13 @@ Window::Window() : focus(true), pause(false), acc(&engine, true, false), frames(
 
 	acc.closeElementLoop();
 
+	// The counter-rotating Beams only interact in two opposite Frodo elements
+	acc.addInteractionRegion(0);
+	acc.addInteractionRegion(4);
+
+	// The Particles are integrated in the sections of the Frodos (after the regions, which are given by the indices of the Frodos)
+	acc.flattenElements();
+
 	// acc.addParticle(
 	// 	Proton(
 	// 		Vector3D(2.99, 1.1, 0),
@@ -70,9 +90,6 @@ Window::Window() : focus(true), pause(false), acc(&engine, true, false), frames(
 		),
 		50, 1
 	);
-
-	// Timer
-	timer.start();
 }
 
 void Window::update() {
@@ -82,13 +99,11 @@ void Window::update() {
 		engine.update();
 
 		// Physics engine
-		if (Input::isKeyPressed(Qt::Key_Up)) engineSpeed += APP::KEY_SPEED;
-		if (Input::isKeyPressed(Qt::Key_Down)) engineSpeed -= APP::KEY_SPEED;
+		if (Input::isKeyPressed(Qt::Key_Up)) changeEngineSpeed(1);
+		if (Input::isKeyPressed(Qt::Key_Down)) changeEngineSpeed(-1);
 
-		if (not pause) {
-			if (engineSpeed < 0) engineSpeed = 0;
-			else for (size_t i(0); i < engineSpeed; ++i) acc.step();
-		}
+		if (not pause) scheduler.advance(acc);
+		if (showPhaseSpace) updatePhaseSpace();
 
 		// Cursor position
 		QCursor c = cursor();
@@ -101,7 +116,14 @@ void Window::update() {
 		unsigned int timeDelta(timer.elapsed());
 		if (timeDelta > GRAPHICS::FRAMEDELTA_UPDATE) {
 			double frameDelta(double(timeDelta) / frames);
-			std::string title(std::string(APP::NAME) + " | " + std::to_string(frameDelta).substr(0, 5) + " ms/frame");
+			// Simulated time per wall second
+			double simulatedRate((scheduler.getSimulatedTime() - simulatedTime) * 1000 / timeDelta);
+			simulatedTime = scheduler.getSimulatedTime();
+			std::ostringstream rate;
+			rate << std::setprecision(3) << simulatedRate;
+			std::string title(std::string(APP::NAME) + " | " + std::to_string(frameDelta).substr(0, 5) + " ms/frame | "
+			                  + rate.str() + " s/s simulated | " + StepScheduler::getName(scheduler.getMode()) + " | "
+			                  + (acc.getTolerance() > 0 ? "adaptive" : (acc.getBucketed() ? "bucketed" : "fixed timestep")));
 			setTitle(reinterpret_cast<const char*>(title.c_str()));
 			frames = 0;
 			timer.start();
@@ -113,6 +135,33 @@ void Window::update() {
 	}
 }
 
+void Window::changeEngineSpeed(int direction) {
+	switch (scheduler.getMode()) {
+		case SteppingMode::FIXED:
+			scheduler.setStepsPerFrame(std::max(0.0, scheduler.getStepsPerFrame() + direction * APP::KEY_SPEED));
+			break;
+		case SteppingMode::BUDGET:
+			scheduler.setBudget(scheduler.getBudget() * (1 + direction * APP::KEY_SPEED));
+			break;
+		case SteppingMode::RATE:
+			scheduler.setTargetRate(scheduler.getTargetRate() * (1 + direction * APP::KEY_SPEED));
+			break;
+	}
+}
+
+void Window::updatePhaseSpace() {
+	phaseSpace.resize(acc.getBeamCount());
+	phaseSpaceBeams.resize(acc.getBeamCount(), 0);
+
+	for (size_t beam(0); beam < acc.getBeamCount(); ++beam) {
+		if (phaseSpaceBeams[beam] != acc.getBeamId(beam)) {
+			phaseSpace[beam].reset();
+			phaseSpaceBeams[beam] = acc.getBeamId(beam);
+		}
+		phaseSpace[beam].update(acc.getBeam(beam));
+	}
+}
+
 void Window::teardownGL() {
 	// engine destructor is invoked automatically
 	// content destructor is invoked automatically
@@ -140,6 +189,7 @@ void Window::paintGL() {
 	engine.begin();
 	engine.clear();
 	acc.draw();
+	if (showPhaseSpace) engine.drawPhaseSpace(phaseSpace);
 	engine.end();
 }
 
@@ -169,6 +219,32 @@ void Window::focusOutEvent(QFocusEvent * ev) {
 void Window::keyPressEvent(QKeyEvent * event) {
 	if (event->isAutoRepeat()) event->ignore();
 	else if (event->key() == Qt::Key_Space) pause = !pause;
+	else if (event->key() == Qt::Key_M) scheduler.nextMode();
+	else if (event->key() == Qt::Key_P) showPhaseSpace = !showPhaseSpace;
+	else if (event->key() == Qt::Key_L) {
+		showLossMap = !showLossMap;
+		engine.setLossMap(showLossMap ? &acc.getLossMap() : nullptr);
+	}
+	else if (event->key() == Qt::Key_C) acc.setSpaceCharge(not acc.getSpaceCharge());
+	// The adaptive timestep and the integration by element exclude each other (see Accelerator::setBucketed())
+	else if (event->key() == Qt::Key_I) {
+		if (acc.getTolerance() > 0) acc.setTolerance(0);
+		else {
+			acc.setBucketed(false);
+			acc.setTolerance(APP::TOLERANCE);
+		}
+	}
+	else if (event->key() == Qt::Key_B) {
+		if (acc.getBucketed()) acc.setBucketed(false);
+		else {
+			acc.setTolerance(0);
+			acc.setBucketed(true);
+		}
+	}
+	// Trails
+	else if (event->key() == Qt::Key_T) engine.setTrailLength(engine.getTrailLength() == 0 ? GRAPHICS::TRAIL_LENGTH : 0);
+	else if (event->key() == Qt::Key_BracketRight) engine.setTrailLength(std::min<size_t>(std::max<size_t>(2 * engine.getTrailLength(), 2), GRAPHICS::TRAIL_MAX_LENGTH));
+	else if (event->key() == Qt::Key_BracketLeft) engine.setTrailLength(engine.getTrailLength() / 2);
 	else Input::registerKeyPress(event->key());
 }
 
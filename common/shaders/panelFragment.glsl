@@ -0,0 +1,11 @@
+#version 330
+in highp vec2 vTexCoord;
+out highp vec4 fColor;
+
+uniform sampler2D density;
+uniform vec3 color;
+
+void main() {
+	float d = texture(density, vTexCoord).r;
+	fColor = vec4(mix(vec3(0.1, 0.1, 0.1), color, d), 1.0);
+}
@@ -0,0 +1,11 @@
+#version 330
+in vec2 position;
+out vec2 vTexCoord;
+
+// x, y, width, height of the panel in normalized device coordinates
+uniform vec4 rect;
+
+void main() {
+	gl_Position = vec4(rect.xy + position * rect.zw, 0.0, 1.0);
+	vTexCoord = position;
+}